@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class BlendMethod
+{
+	nlerp,
+	markley
+};
+
+inline constexpr int blendMethodCount = 2;
+
+inline const std::array<std::string, blendMethodCount> blendMethodLabels
+{
+	"Weighted nlerp",
+	"Markley average"
+};
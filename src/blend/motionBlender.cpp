@@ -0,0 +1,190 @@
+#include "blend/motionBlender.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr float minWeightSum = 1e-12f;
+static constexpr float minNorm = 1e-12f;
+
+void MotionBlender::blend(BlendMethod method, std::size_t inputCount, std::size_t elementCount,
+	const glm::vec3* positions, const glm::vec4* quats, const float* weights,
+	glm::vec3* resultPositions, glm::vec4* resultQuats)
+{
+	if (inputCount == 0)
+	{
+		return;
+	}
+
+	resize(elementCount);
+	blendPositions(inputCount, elementCount, positions, weights, resultPositions);
+	accumulateNlerp(inputCount, elementCount, quats, weights);
+	if (method == BlendMethod::markley)
+	{
+		accumulateMoments(inputCount, elementCount, quats, weights);
+		solveMarkley(elementCount);
+	}
+
+	for (std::size_t i = 0; i < elementCount; ++i)
+	{
+		glm::vec4 quat{m_sums[0][i], m_sums[1][i], m_sums[2][i], m_sums[3][i]};
+		float norm = glm::length(quat);
+		resultQuats[i] = m_weightSums[i] > minWeightSum && norm > minNorm ? quat / norm :
+			glm::normalize(quats[i]);
+	}
+}
+
+void MotionBlender::resize(std::size_t elementCount)
+{
+	m_weightSums.resize(elementCount);
+	for (std::vector<float>& sum : m_sums)
+	{
+		sum.resize(elementCount);
+	}
+	for (std::vector<float>& moment : m_moments)
+	{
+		moment.resize(elementCount);
+	}
+}
+
+void MotionBlender::blendPositions(std::size_t inputCount, std::size_t elementCount,
+	const glm::vec3* positions, const float* weights, glm::vec3* resultPositions)
+{
+	std::fill(m_weightSums.begin(), m_weightSums.end(), 0.0f);
+	std::fill(resultPositions, resultPositions + elementCount, glm::vec3{});
+	for (std::size_t input = 0; input < inputCount; ++input)
+	{
+		const glm::vec3* inputPositions = positions + input * elementCount;
+		const float* inputWeights = weights + input * elementCount;
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			m_weightSums[i] += inputWeights[i];
+			resultPositions[i] += inputWeights[i] * inputPositions[i];
+		}
+	}
+
+	for (std::size_t i = 0; i < elementCount; ++i)
+	{
+		resultPositions[i] = m_weightSums[i] > minWeightSum ?
+			resultPositions[i] / m_weightSums[i] : positions[i];
+	}
+}
+
+void MotionBlender::accumulateNlerp(std::size_t inputCount, std::size_t elementCount,
+	const glm::vec4* quats, const float* weights)
+{
+	for (std::vector<float>& sum : m_sums)
+	{
+		std::fill(sum.begin(), sum.end(), 0.0f);
+	}
+
+	float* x = m_sums[0].data();
+	float* y = m_sums[1].data();
+	float* z = m_sums[2].data();
+	float* w = m_sums[3].data();
+	for (std::size_t input = 0; input < inputCount; ++input)
+	{
+		const glm::vec4* inputQuats = quats + input * elementCount;
+		const float* inputWeights = weights + input * elementCount;
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			const glm::vec4& quat = inputQuats[i];
+			float signedWeight = std::copysign(inputWeights[i], glm::dot(quat, quats[i]));
+			x[i] += signedWeight * quat.x;
+			y[i] += signedWeight * quat.y;
+			z[i] += signedWeight * quat.z;
+			w[i] += signedWeight * quat.w;
+		}
+	}
+}
+
+void MotionBlender::accumulateMoments(std::size_t inputCount, std::size_t elementCount,
+	const glm::vec4* quats, const float* weights)
+{
+	for (std::vector<float>& moment : m_moments)
+	{
+		std::fill(moment.begin(), moment.end(), 0.0f);
+	}
+
+	std::array<float*, 10> m{};
+	for (std::size_t i = 0; i < m.size(); ++i)
+	{
+		m[i] = m_moments[i].data();
+	}
+	for (std::size_t input = 0; input < inputCount; ++input)
+	{
+		const glm::vec4* inputQuats = quats + input * elementCount;
+		const float* inputWeights = weights + input * elementCount;
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			glm::vec4 quat = inputWeights[i] * inputQuats[i];
+			const glm::vec4& unweighted = inputQuats[i];
+			m[0][i] += quat.x * unweighted.x;
+			m[1][i] += quat.x * unweighted.y;
+			m[2][i] += quat.x * unweighted.z;
+			m[3][i] += quat.x * unweighted.w;
+			m[4][i] += quat.y * unweighted.y;
+			m[5][i] += quat.y * unweighted.z;
+			m[6][i] += quat.y * unweighted.w;
+			m[7][i] += quat.z * unweighted.z;
+			m[8][i] += quat.z * unweighted.w;
+			m[9][i] += quat.w * unweighted.w;
+		}
+	}
+}
+
+void MotionBlender::solveMarkley(std::size_t elementCount)
+{
+	for (std::size_t i = 0; i < elementCount; ++i)
+	{
+		glm::mat4 moment
+		{
+			m_moments[0][i], m_moments[1][i], m_moments[2][i], m_moments[3][i],
+			m_moments[1][i], m_moments[4][i], m_moments[5][i], m_moments[6][i],
+			m_moments[2][i], m_moments[5][i], m_moments[7][i], m_moments[8][i],
+			m_moments[3][i], m_moments[6][i], m_moments[8][i], m_moments[9][i]
+		};
+		float trace = moment[0][0] + moment[1][1] + moment[2][2] + moment[3][3];
+		if (trace <= minWeightSum)
+		{
+			continue;
+		}
+
+		moment = moment * (1 / trace);
+		for (int squaring = 0; squaring < markleySquarings; ++squaring)
+		{
+			moment = moment * moment;
+			trace = moment[0][0] + moment[1][1] + moment[2][2] + moment[3][3];
+			moment = moment * (1 / std::max(trace, minNorm));
+		}
+
+		trace = moment[0][0] + moment[1][1] + moment[2][2] + moment[3][3];
+
+		int largest = 0;
+		for (int j = 1; j < 4; ++j)
+		{
+			largest = moment[j][j] > moment[largest][largest] ? j : largest;
+		}
+		glm::vec4 quat = moment[largest] / std::max(glm::length(moment[largest]), minNorm);
+		for (int iteration = 0; iteration < markleyMaxIterations; ++iteration)
+		{
+			glm::vec4 next = moment * quat;
+			float rayleigh = glm::dot(quat, next);
+			next /= std::max(glm::length(next), minNorm);
+			float step = glm::length(next - quat);
+			quat = next;
+			if (iteration + 1 >= markleyIterations && 4 * rayleigh >= trace &&
+				step < markleyTolerance)
+			{
+				break;
+			}
+		}
+
+		glm::vec4 nlerp{m_sums[0][i], m_sums[1][i], m_sums[2][i], m_sums[3][i]};
+		quat = glm::dot(quat, nlerp) < 0 ? -quat : quat;
+
+		m_sums[0][i] = quat.x;
+		m_sums[1][i] = quat.y;
+		m_sums[2][i] = quat.z;
+		m_sums[3][i] = quat.w;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "blend/blendMethod.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+struct BlendLayer
+{
+	float startWeight = 1;
+	float endWeight = 1;
+};
+
+class MotionBlender
+{
+public:
+	static constexpr int markleySquarings = 6;
+	static constexpr int markleyIterations = 2;
+	static constexpr int markleyMaxIterations = 16;
+	static constexpr float markleyTolerance = 1e-5f;
+
+	void blend(BlendMethod method, std::size_t inputCount, std::size_t elementCount,
+		const glm::vec3* positions, const glm::vec4* quats, const float* weights,
+		glm::vec3* resultPositions, glm::vec4* resultQuats);
+
+private:
+	std::vector<float> m_weightSums{};
+	std::array<std::vector<float>, 4> m_sums{};
+	std::array<std::vector<float>, 10> m_moments{};
+
+	void resize(std::size_t elementCount);
+	void blendPositions(std::size_t inputCount, std::size_t elementCount,
+		const glm::vec3* positions, const float* weights, glm::vec3* resultPositions);
+	void accumulateNlerp(std::size_t inputCount, std::size_t elementCount,
+		const glm::vec4* quats, const float* weights);
+	void accumulateMoments(std::size_t inputCount, std::size_t elementCount,
+		const glm::vec4* quats, const float* weights);
+	void solveMarkley(std::size_t elementCount);
+};
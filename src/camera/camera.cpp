@@ -1,7 +1,5 @@
 #include "camera/camera.hpp"
 
-#include "shaderPrograms.hpp"
-
 #include <glm/gtc/constants.hpp>
 
 #include <cmath>
@@ -14,9 +12,9 @@ Camera::Camera(const glm::ivec2& viewportSize, float nearPlane, float farPlane)
 	updateViewMatrix();
 }
 
-void Camera::use() const
+void Camera::use(Renderer& renderer) const
 {
-	updateShaders();
+	updateShaders(renderer);
 }
 
 void Camera::setViewportSize(const glm::ivec2& viewportSize)
@@ -106,15 +104,8 @@ glm::vec3 Camera::getPos() const
 		};
 }
 
-void Camera::updateShaders() const
+void Camera::updateShaders(Renderer& renderer) const
 {
 	glm::mat4 projectionViewMatrix = m_projectionMatrix * glm::inverse(m_viewMatrixInverse);
-	glm::mat4 projectionViewMatrixInverse = glm::inverse(projectionViewMatrix);
-
-	ShaderPrograms::frame->use();
-	ShaderPrograms::frame->setUniform("projectionViewMatrix", projectionViewMatrix);
-
-	ShaderPrograms::plane->use();
-	ShaderPrograms::plane->setUniform("projectionViewMatrix", projectionViewMatrix);
-	ShaderPrograms::plane->setUniform("projectionViewMatrixInverse", projectionViewMatrixInverse);
+	renderer.setCamera(projectionViewMatrix, glm::inverse(projectionViewMatrix));
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "render/renderer.hpp"
+
 #include <glm/glm.hpp>
 
 class Camera
@@ -8,7 +10,7 @@ public:
 	Camera(const glm::ivec2& viewportSize, float nearPlane, float farPlane);
 	virtual ~Camera() = default;
 
-	void use() const;
+	void use(Renderer& renderer) const;
 	virtual void updateGUI() = 0;
 	void setViewportSize(const glm::ivec2& viewportSize);
 
@@ -38,5 +40,5 @@ private:
 	float m_yawRad = 0;
 
 	glm::vec3 getPos() const;
-	void updateShaders() const;
+	void updateShaders(Renderer& renderer) const;
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class ClipPlayback
+{
+	mapped,
+	compressed,
+	reducedKeys
+};
+
+inline constexpr int clipPlaybackCount = 3;
+
+inline const std::array<std::string, clipPlaybackCount> clipPlaybackLabels
+{
+	"Mapped",
+	"Compressed",
+	"Reduced keys"
+};
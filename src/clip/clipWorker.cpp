@@ -0,0 +1,100 @@
+#include "clip/clipWorker.hpp"
+
+#include "memory/allocationTracker.hpp"
+
+#include <utility>
+
+ClipWorker::ClipWorker() :
+	m_thread{&ClipWorker::run, this}
+{ }
+
+ClipWorker::~ClipWorker()
+{
+	m_stopRequested.store(true, std::memory_order_release);
+	m_submittedVersion.fetch_add(1, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	m_thread.join();
+}
+
+std::uint64_t ClipWorker::submitCompression(std::shared_ptr<const MotionClip> clip,
+	const CompressionSettings& settings)
+{
+	CompressionJob& job = m_compressionJobs.back();
+	job.version = ++m_lastVersion;
+	job.clip = std::move(clip);
+	job.settings = settings;
+	m_compressionJobs.publish();
+
+	m_submittedVersion.store(m_lastVersion, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	return m_lastVersion;
+}
+
+CompressionResult* ClipWorker::pollCompression()
+{
+	return m_compressionResults.update() ? &m_compressionResults.front() : nullptr;
+}
+
+std::uint64_t ClipWorker::submitReduction(std::shared_ptr<const MotionClip> clip,
+	InterpolationType type, const ReductionTolerances& tolerances)
+{
+	ReductionJob& job = m_reductionJobs.back();
+	job.version = ++m_lastVersion;
+	job.clip = std::move(clip);
+	job.type = type;
+	job.tolerances = tolerances;
+	m_reductionJobs.publish();
+
+	m_submittedVersion.store(m_lastVersion, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	return m_lastVersion;
+}
+
+ReductionResult* ClipWorker::pollReduction()
+{
+	return m_reductionResults.update() ? &m_reductionResults.front() : nullptr;
+}
+
+void ClipWorker::run()
+{
+	AllocationTracker::setZone(AllocationZone::clips);
+	std::uint64_t seenVersion = 0;
+	while (true)
+	{
+		m_submittedVersion.wait(seenVersion, std::memory_order_acquire);
+		seenVersion = m_submittedVersion.load(std::memory_order_acquire);
+		if (m_stopRequested.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if (m_compressionJobs.update())
+		{
+			compress(m_compressionJobs.front(), m_compressionResults.back());
+			m_compressionResults.publish();
+		}
+		if (m_reductionJobs.update())
+		{
+			reduce(m_reductionJobs.front(), m_reductionResults.back());
+			m_reductionResults.publish();
+		}
+	}
+}
+
+void ClipWorker::compress(CompressionJob& job, CompressionResult& result)
+{
+	result.version = job.version;
+	result.track = std::make_shared<const CompressedTrack>(
+		CompressedTrack::encode(*job.clip, job.settings));
+	job.clip.reset();
+}
+
+void ClipWorker::reduce(ReductionJob& job, ReductionResult& result)
+{
+	result.version = job.version;
+	result.type = job.type;
+	result.stats = {};
+	result.track = std::make_shared<const KeyframeTrack>(KeyframeReduction::reduce(
+		KeyframeReduction::view(*job.clip), job.type, job.tolerances, &result.stats));
+	job.clip.reset();
+}
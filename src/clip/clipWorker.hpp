@@ -0,0 +1,74 @@
+#pragma once
+
+#include "clip/compressedTrack.hpp"
+#include "clip/keyframeReduction.hpp"
+#include "clip/motionClip.hpp"
+#include "concurrency/tripleBuffer.hpp"
+#include "interpolationType.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+struct CompressionResult
+{
+	std::uint64_t version{};
+	std::shared_ptr<const CompressedTrack> track{};
+};
+
+struct ReductionResult
+{
+	std::uint64_t version{};
+	std::shared_ptr<const KeyframeTrack> track{};
+	InterpolationType type{};
+	ReductionStats stats{};
+};
+
+class ClipWorker
+{
+public:
+	ClipWorker();
+	ClipWorker(const ClipWorker&) = delete;
+	ClipWorker(ClipWorker&&) = delete;
+	~ClipWorker();
+
+	ClipWorker& operator=(const ClipWorker&) = delete;
+	ClipWorker& operator=(ClipWorker&&) = delete;
+
+	std::uint64_t submitCompression(std::shared_ptr<const MotionClip> clip,
+		const CompressionSettings& settings);
+	CompressionResult* pollCompression();
+	std::uint64_t submitReduction(std::shared_ptr<const MotionClip> clip,
+		InterpolationType type, const ReductionTolerances& tolerances);
+	ReductionResult* pollReduction();
+
+private:
+	struct CompressionJob
+	{
+		std::uint64_t version{};
+		std::shared_ptr<const MotionClip> clip{};
+		CompressionSettings settings{};
+	};
+
+	struct ReductionJob
+	{
+		std::uint64_t version{};
+		std::shared_ptr<const MotionClip> clip{};
+		InterpolationType type{};
+		ReductionTolerances tolerances{};
+	};
+
+	TripleBuffer<CompressionJob> m_compressionJobs{};
+	TripleBuffer<CompressionResult> m_compressionResults{};
+	TripleBuffer<ReductionJob> m_reductionJobs{};
+	TripleBuffer<ReductionResult> m_reductionResults{};
+	std::uint64_t m_lastVersion = 0;
+	std::atomic<std::uint64_t> m_submittedVersion = 0;
+	std::atomic<bool> m_stopRequested = false;
+	std::thread m_thread;
+
+	void run();
+	void compress(CompressionJob& job, CompressionResult& result);
+	void reduce(ReductionJob& job, ReductionResult& result);
+};
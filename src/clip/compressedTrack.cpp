@@ -0,0 +1,580 @@
+#include "clip/compressedTrack.hpp"
+
+#include "concurrency/parallelFor.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <span>
+
+static constexpr std::size_t blockGrainSize = 64;
+static constexpr std::size_t rangeGrainSize = 1 << 14;
+static constexpr std::size_t decodeMeasureBlockCount = 1 << 14;
+static constexpr std::size_t readSlack = sizeof(std::uint64_t);
+static constexpr float halfSqrt2 = 0.70710678f;
+
+static std::uint32_t maxValue(int bits)
+{
+	return (std::uint32_t{1} << bits) - 1;
+}
+
+static std::uint32_t quantizeUnit(float value, int bits)
+{
+	return static_cast<std::uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) *
+		static_cast<float>(maxValue(bits))));
+}
+
+static float angularError(const glm::vec4& reference, const glm::vec4& quat)
+{
+	float dot = glm::dot(reference, quat);
+	return 2 * std::atan2(glm::length(quat - dot * reference), std::abs(dot));
+}
+
+static ClipSample interpolateDecoded(const glm::vec4* quats, const glm::vec3* positions,
+	std::size_t count, float position)
+{
+	position = std::clamp(position, 0.0f, static_cast<float>(count - 1));
+	std::size_t local = std::min(static_cast<std::size_t>(position), count - 1);
+	if (local + 1 >= count)
+	{
+		return {positions[local], quats[local]};
+	}
+
+	float fraction = position - static_cast<float>(local);
+	glm::vec4 nextQuat = quats[local + 1];
+	if (glm::dot(quats[local], nextQuat) < 0)
+	{
+		nextQuat = -nextQuat;
+	}
+	return
+	{
+		glm::mix(positions[local], positions[local + 1], fraction),
+		glm::normalize(glm::mix(quats[local], nextQuat, fraction))
+	};
+}
+
+class ClipCursor
+{
+public:
+	ClipCursor(const MotionClip& clip, float time) :
+		m_times{clip.getTimes()},
+		m_positions{clip.getPositions()},
+		m_quats{clip.getQuats()}
+	{
+		const float* next = std::upper_bound(m_times.data(), m_times.data() + m_times.size(),
+			m_times[0] + time);
+		m_index = next == m_times.data() ? 0 :
+			static_cast<std::size_t>(next - m_times.data()) - 1;
+	}
+
+	ClipSample sample(float time)
+	{
+		float absoluteTime = m_times[0] + time;
+		while (m_index + 1 < m_times.size() && m_times[m_index + 1] <= absoluteTime)
+		{
+			++m_index;
+		}
+		if (m_index + 1 >= m_times.size())
+		{
+			return {m_positions[m_index], m_quats[m_index]};
+		}
+
+		float segmentDuration = m_times[m_index + 1] - m_times[m_index];
+		float fraction = segmentDuration > 0 ?
+			std::clamp((absoluteTime - m_times[m_index]) / segmentDuration, 0.0f, 1.0f) : 0;
+		glm::vec4 nextQuat = m_quats[m_index + 1];
+		if (glm::dot(m_quats[m_index], nextQuat) < 0)
+		{
+			nextQuat = -nextQuat;
+		}
+		return
+		{
+			glm::mix(m_positions[m_index], m_positions[m_index + 1], fraction),
+			glm::normalize(glm::mix(m_quats[m_index], nextQuat, fraction))
+		};
+	}
+
+private:
+	std::span<const float> m_times{};
+	std::span<const glm::vec3> m_positions{};
+	std::span<const glm::vec4> m_quats{};
+	std::size_t m_index = 0;
+};
+
+class BitWriter
+{
+public:
+	BitWriter(std::vector<std::uint8_t>& bytes) :
+		m_bytes{bytes}
+	{ }
+
+	void write(std::uint64_t value, int bits)
+	{
+		m_buffer |= value << m_bufferBits;
+		m_bufferBits += bits;
+		while (m_bufferBits >= 8)
+		{
+			m_bytes.push_back(static_cast<std::uint8_t>(m_buffer));
+			m_buffer >>= 8;
+			m_bufferBits -= 8;
+		}
+	}
+
+	void flush()
+	{
+		if (m_bufferBits > 0)
+		{
+			m_bytes.push_back(static_cast<std::uint8_t>(m_buffer));
+		}
+		m_buffer = 0;
+		m_bufferBits = 0;
+	}
+
+private:
+	std::vector<std::uint8_t>& m_bytes;
+	std::uint64_t m_buffer = 0;
+	int m_bufferBits = 0;
+};
+
+float CompressedTrack::getSampleRate(const MotionClip& clip)
+{
+	float duration = clip.getDuration();
+	return duration > 0 ? static_cast<float>(clip.getSampleCount() - 1) / duration : 1;
+}
+
+CompressedTrack CompressedTrack::encode(const MotionClip& clip,
+	const CompressionSettings& settings)
+{
+	return encode(clip, 0, clip.getSampleCount(), settings);
+}
+
+CompressedTrack CompressedTrack::encode(const MotionClip& clip, std::size_t first,
+	std::size_t count, const CompressionSettings& settings)
+{
+	std::size_t sampleCount = std::min(count, clip.getSampleCount() - std::min(first,
+		clip.getSampleCount()));
+	CompressedTrack track{};
+	track.m_sampleCount = sampleCount;
+	track.m_sampleRate = getSampleRate(clip);
+	track.m_settings.rotationBits = std::clamp(settings.rotationBits, 4, maxBits);
+	track.m_settings.positionBits = std::clamp(settings.positionBits, 4, maxBits);
+	if (sampleCount == 0)
+	{
+		return track;
+	}
+
+	std::span<const float> times = clip.getTimes();
+	std::span<const glm::vec3> sourcePositions = clip.getPositions();
+	std::span<const glm::vec4> sourceQuats = clip.getQuats();
+	float sampleRate = track.m_sampleRate;
+	auto sampleTime = [sampleRate] (std::size_t index)
+	{
+		return static_cast<float>(index) / sampleRate;
+	};
+	auto sourceIndex = [&times] (float time, bool inclusive)
+	{
+		float absoluteTime = times[0] + time;
+		return static_cast<std::size_t>((inclusive ?
+			std::lower_bound(times.begin(), times.end(), absoluteTime) :
+			std::upper_bound(times.begin(), times.end(), absoluteTime)) - times.begin());
+	};
+
+	std::size_t last = first + sampleCount - 1;
+	bool endsClip = last + 1 == clip.getSampleCount();
+	std::size_t sourceBegin = sourceIndex(sampleTime(first), true);
+	std::size_t sourceEnd = endsClip ? times.size() : sourceIndex(sampleTime(last), false);
+	std::size_t boundsBegin = sourceBegin > 0 ? sourceBegin - 1 : 0;
+	std::size_t boundsEnd = std::min(sourceEnd + 1, times.size());
+
+	std::mutex mutex{};
+	glm::vec3 positionMin{std::numeric_limits<float>::max()};
+	glm::vec3 positionMax{std::numeric_limits<float>::lowest()};
+	parallelFor(boundsEnd - boundsBegin, rangeGrainSize,
+		[&] (std::size_t begin, std::size_t end)
+		{
+			glm::vec3 localMin{std::numeric_limits<float>::max()};
+			glm::vec3 localMax{std::numeric_limits<float>::lowest()};
+			for (std::size_t i = boundsBegin + begin; i < boundsBegin + end; ++i)
+			{
+				localMin = glm::min(localMin, sourcePositions[i]);
+				localMax = glm::max(localMax, sourcePositions[i]);
+			}
+			std::lock_guard<std::mutex> lock{mutex};
+			positionMin = glm::min(positionMin, localMin);
+			positionMax = glm::max(positionMax, localMax);
+		});
+	track.m_positionMin = positionMin;
+	track.m_positionStep = (positionMax - positionMin) /
+		static_cast<float>(maxValue(track.m_settings.positionBits));
+
+	struct EncodedRange
+	{
+		std::size_t begin{};
+		std::vector<std::uint8_t> bytes{};
+		std::vector<std::uint64_t> offsets{};
+		float maxAngularError{};
+		float maxPositionError{};
+	};
+
+	std::size_t blockCount = sampleCount == 1 ? 1 : (sampleCount - 2) / blockSize + 1;
+	std::vector<EncodedRange> ranges{};
+	parallelFor(blockCount, blockGrainSize,
+		[&] (std::size_t begin, std::size_t end)
+		{
+			EncodedRange range{begin};
+			Channels channels{};
+			Channels decodedChannels{};
+			std::array<glm::vec4, blockSampleCount> quats{};
+			std::array<glm::vec3, blockSampleCount> positions{};
+
+			ClipCursor cursor{clip, sampleTime(first + begin * blockSize)};
+			std::size_t source = begin == 0 ? sourceBegin :
+				sourceIndex(sampleTime(first + begin * blockSize), true);
+			std::size_t rangeSourceEnd = end == blockCount ? sourceEnd :
+				sourceIndex(sampleTime(first + end * blockSize), true);
+			for (std::size_t block = begin; block < end; ++block)
+			{
+				std::size_t blockFirst = block * blockSize;
+				std::size_t count = std::min(blockSampleCount, sampleCount - blockFirst);
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					track.quantize(cursor.sample(sampleTime(first + blockFirst + i)), channels,
+						i);
+				}
+
+				std::size_t offset = range.bytes.size();
+				range.offsets.push_back(offset);
+				track.encodeBlock(channels, count, range.bytes);
+
+				std::size_t encodedSize = range.bytes.size();
+				range.bytes.resize(encodedSize + readSlack);
+				unpack(range.bytes.data() + offset, decodedChannels);
+				range.bytes.resize(encodedSize);
+				track.dequantize(decodedChannels, count, quats.data(), positions.data());
+
+				float blockStart = static_cast<float>(first + blockFirst);
+				float blockLast = blockStart + static_cast<float>(count - 1);
+				bool lastBlock = block + 1 == end;
+				for (; source < rangeSourceEnd; ++source)
+				{
+					float position = (times[source] - times[0]) * sampleRate;
+					if (!lastBlock && position > blockLast)
+					{
+						break;
+					}
+
+					ClipSample decoded = interpolateDecoded(quats.data(), positions.data(),
+						count, position - blockStart);
+					range.maxAngularError = std::max(range.maxAngularError,
+						angularError(glm::normalize(sourceQuats[source]), decoded.quat));
+					range.maxPositionError = std::max(range.maxPositionError,
+						glm::length(sourcePositions[source] - decoded.pos));
+				}
+			}
+
+			std::lock_guard<std::mutex> lock{mutex};
+			ranges.push_back(std::move(range));
+		});
+
+	std::sort(ranges.begin(), ranges.end(),
+		[] (const EncodedRange& left, const EncodedRange& right)
+		{
+			return left.begin < right.begin;
+		});
+
+	track.m_blockOffsets.reserve(blockCount);
+	for (const EncodedRange& range : ranges)
+	{
+		std::uint64_t base = track.m_data.size();
+		for (std::uint64_t offset : range.offsets)
+		{
+			track.m_blockOffsets.push_back(base + offset);
+		}
+		track.m_data.insert(track.m_data.end(), range.bytes.begin(), range.bytes.end());
+		track.m_stats.maxAngularError =
+			std::max(track.m_stats.maxAngularError, range.maxAngularError);
+		track.m_stats.maxPositionError =
+			std::max(track.m_stats.maxPositionError, range.maxPositionError);
+	}
+	track.m_data.resize(track.m_data.size() + readSlack);
+	track.m_data.shrink_to_fit();
+
+	track.m_stats.sampleCount = sampleCount;
+	track.m_stats.rawByteSize = sampleCount * (sizeof(float) + sizeof(glm::vec3) +
+		sizeof(glm::vec4));
+	track.m_stats.compressedByteSize = track.getByteSize();
+	track.m_stats.ratio = static_cast<float>(track.m_stats.rawByteSize) /
+		static_cast<float>(track.m_stats.compressedByteSize);
+	track.measureDecode();
+	return track;
+}
+
+std::size_t CompressedTrack::getSampleCount() const
+{
+	return m_sampleCount;
+}
+
+std::size_t CompressedTrack::getBlockCount() const
+{
+	return m_blockOffsets.size();
+}
+
+float CompressedTrack::getSampleRate() const
+{
+	return m_sampleRate;
+}
+
+float CompressedTrack::getDuration() const
+{
+	return m_sampleCount > 1 ? static_cast<float>(m_sampleCount - 1) / m_sampleRate : 0;
+}
+
+std::size_t CompressedTrack::getByteSize() const
+{
+	return m_data.size() + m_blockOffsets.size() * sizeof(std::uint64_t);
+}
+
+const CompressionStats& CompressedTrack::getStats() const
+{
+	return m_stats;
+}
+
+std::size_t CompressedTrack::decodeBlock(std::size_t block, glm::vec4* quats,
+	glm::vec3* positions) const
+{
+	Channels channels{};
+	std::size_t count = unpack(m_data.data() + m_blockOffsets[block], channels);
+	dequantize(channels, count, quats, positions);
+	return count;
+}
+
+void CompressedTrack::quantize(const ClipSample& sample, Channels& channels,
+	std::size_t index) const
+{
+	glm::vec4 quat = glm::normalize(sample.quat);
+	int largest = 0;
+	for (int component = 1; component < 4; ++component)
+	{
+		if (std::abs(quat[component]) > std::abs(quat[largest]))
+		{
+			largest = component;
+		}
+	}
+	if (quat[largest] < 0)
+	{
+		quat = -quat;
+	}
+
+	channels[indexChannel][index] = static_cast<std::uint32_t>(largest);
+	int channel = rotationChannel;
+	for (int component = 0; component < 4; ++component)
+	{
+		if (component != largest)
+		{
+			channels[channel++][index] = quantizeUnit(
+				quat[component] / halfSqrt2 * 0.5f + 0.5f, m_settings.rotationBits);
+		}
+	}
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float step = m_positionStep[axis];
+		channels[positionChannel + axis][index] = step > 0 ?
+			static_cast<std::uint32_t>(std::lround((sample.pos[axis] - m_positionMin[axis]) /
+				step)) : 0;
+	}
+}
+
+void CompressedTrack::encodeBlock(const Channels& channels, std::size_t count,
+	std::vector<std::uint8_t>& bytes) const
+{
+	std::array<std::array<std::uint64_t, blockSampleCount>, channelCount> deltas{};
+	std::array<int, channelCount> widths{};
+	for (int channel = 0; channel < channelCount; ++channel)
+	{
+		std::uint64_t maxDelta = 0;
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			std::int64_t delta = static_cast<std::int64_t>(channels[channel][i]) -
+				static_cast<std::int64_t>(channels[channel][i - 1]);
+			deltas[channel][i] = (static_cast<std::uint64_t>(delta) << 1) ^
+				static_cast<std::uint64_t>(delta >> 63);
+			maxDelta = std::max(maxDelta, deltas[channel][i]);
+		}
+		widths[channel] = std::bit_width(maxDelta);
+	}
+
+	bytes.push_back(static_cast<std::uint8_t>(count));
+	bytes.push_back(static_cast<std::uint8_t>(count >> 8));
+	for (int channel = 0; channel < channelCount; ++channel)
+	{
+		std::uint32_t first = channels[channel][0];
+		for (int byte = 0; byte < 4; ++byte)
+		{
+			bytes.push_back(static_cast<std::uint8_t>(first >> (8 * byte)));
+		}
+		bytes.push_back(static_cast<std::uint8_t>(widths[channel]));
+	}
+
+	BitWriter writer{bytes};
+	for (int channel = 0; channel < channelCount; ++channel)
+	{
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			writer.write(deltas[channel][i], widths[channel]);
+		}
+	}
+	writer.flush();
+}
+
+std::size_t CompressedTrack::unpack(const std::uint8_t* data, Channels& channels)
+{
+	std::size_t count = data[0] | static_cast<std::size_t>(data[1]) << 8;
+	std::array<int, channelCount> widths{};
+	for (int channel = 0; channel < channelCount; ++channel)
+	{
+		const std::uint8_t* header = data + 2 + channel * channelHeaderSize;
+		channels[channel][0] = header[0] | static_cast<std::uint32_t>(header[1]) << 8 |
+			static_cast<std::uint32_t>(header[2]) << 16 |
+			static_cast<std::uint32_t>(header[3]) << 24;
+		widths[channel] = header[4];
+	}
+
+	const std::uint8_t* bits = data + blockHeaderSize;
+	std::size_t bitPosition = 0;
+	for (int channel = 0; channel < channelCount; ++channel)
+	{
+		int width = widths[channel];
+		std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+		std::array<std::uint32_t, blockSampleCount>& values = channels[channel];
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			std::uint64_t word{};
+			std::memcpy(&word, bits + (bitPosition >> 3), sizeof(word));
+			std::uint64_t zigzag = (word >> (bitPosition & 7)) & mask;
+			bitPosition += static_cast<std::size_t>(width);
+
+			std::int64_t delta = static_cast<std::int64_t>(zigzag >> 1) ^
+				-static_cast<std::int64_t>(zigzag & 1);
+			values[i] = static_cast<std::uint32_t>(static_cast<std::int64_t>(values[i - 1]) +
+				delta);
+		}
+	}
+	return count;
+}
+
+void CompressedTrack::dequantize(const Channels& channels, std::size_t count,
+	glm::vec4* quats, glm::vec3* positions) const
+{
+	std::array<std::array<float, blockSampleCount>, 3> components{};
+	float rotationScale = 2 * halfSqrt2 / static_cast<float>(maxValue(m_settings.rotationBits));
+	for (int component = 0; component < 3; ++component)
+	{
+		const std::array<std::uint32_t, blockSampleCount>& values =
+			channels[rotationChannel + component];
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			components[component][i] = static_cast<float>(values[i]) * rotationScale -
+				halfSqrt2;
+		}
+	}
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		float a = components[0][i];
+		float b = components[1][i];
+		float c = components[2][i];
+		float largest = std::sqrt(std::max(1 - a * a - b * b - c * c, 0.0f));
+		switch (channels[indexChannel][i])
+		{
+			case 0:
+				quats[i] = {largest, a, b, c};
+				break;
+			case 1:
+				quats[i] = {a, largest, b, c};
+				break;
+			case 2:
+				quats[i] = {a, b, largest, c};
+				break;
+			default:
+				quats[i] = {a, b, c, largest};
+				break;
+		}
+	}
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		const std::array<std::uint32_t, blockSampleCount>& values =
+			channels[positionChannel + axis];
+		float min = m_positionMin[axis];
+		float step = m_positionStep[axis];
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			positions[i][axis] = min + static_cast<float>(values[i]) * step;
+		}
+	}
+}
+
+void CompressedTrack::measureDecode()
+{
+	std::size_t blockCount = std::min(getBlockCount(), decodeMeasureBlockCount);
+	std::array<glm::vec4, blockSampleCount> quats{};
+	std::array<glm::vec3, blockSampleCount> positions{};
+	std::size_t decodedCount = 0;
+	float checksum = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (std::size_t block = 0; block < blockCount; ++block)
+	{
+		decodedCount += decodeBlock(block, quats.data(), positions.data()) - 1;
+		checksum += quats[0].w + positions[0].x;
+	}
+	double seconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+
+	volatile float sink = checksum;
+	static_cast<void>(sink);
+	m_stats.decodeSamplesPerSecond = seconds > 0 ?
+		static_cast<double>(std::max<std::size_t>(decodedCount, 1)) / seconds : 0;
+}
+
+void CompressedTrackDecoder::setTrack(const CompressedTrack* track)
+{
+	m_track = track;
+	m_block = noBlock;
+	m_blockCount = 0;
+}
+
+ClipSample CompressedTrackDecoder::sample(float time)
+{
+	if (m_track == nullptr || m_track->getSampleCount() == 0)
+	{
+		return {};
+	}
+
+	float position = std::max(time, 0.0f) * m_track->getSampleRate();
+	std::size_t lastIndex = m_track->getSampleCount() - 1;
+	std::size_t index = std::min(static_cast<std::size_t>(position), lastIndex);
+	std::size_t block = std::min(index / CompressedTrack::blockSize,
+		m_track->getBlockCount() - 1);
+	if (block != m_block)
+	{
+		m_blockCount = m_track->decodeBlock(block, m_quats.data(), m_positions.data());
+		m_block = block;
+	}
+
+	return interpolateDecoded(m_quats.data(), m_positions.data(), m_blockCount,
+		position - static_cast<float>(block * CompressedTrack::blockSize));
+}
+
+void CompressedTrackDecoder::sample(const float* times, ClipSample* samples, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		samples[i] = sample(times[i]);
+	}
+}
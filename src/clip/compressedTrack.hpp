@@ -0,0 +1,96 @@
+#pragma once
+
+#include "clip/motionClip.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct CompressionSettings
+{
+	int rotationBits = 16;
+	int positionBits = 16;
+};
+
+struct CompressionStats
+{
+	std::size_t sampleCount{};
+	std::size_t rawByteSize{};
+	std::size_t compressedByteSize{};
+	float ratio{};
+	float maxAngularError{};
+	float maxPositionError{};
+	double decodeSamplesPerSecond{};
+};
+
+class CompressedTrack
+{
+public:
+	static constexpr std::size_t blockSize = 64;
+	static constexpr std::size_t blockSampleCount = blockSize + 1;
+	static constexpr int maxBits = 24;
+
+	static float getSampleRate(const MotionClip& clip);
+	static CompressedTrack encode(const MotionClip& clip,
+		const CompressionSettings& settings = {});
+	static CompressedTrack encode(const MotionClip& clip, std::size_t first, std::size_t count,
+		const CompressionSettings& settings = {});
+
+	std::size_t getSampleCount() const;
+	std::size_t getBlockCount() const;
+	float getSampleRate() const;
+	float getDuration() const;
+	std::size_t getByteSize() const;
+	const CompressionStats& getStats() const;
+
+	std::size_t decodeBlock(std::size_t block, glm::vec4* quats, glm::vec3* positions) const;
+
+private:
+	static constexpr int channelCount = 7;
+	static constexpr int indexChannel = 0;
+	static constexpr int rotationChannel = 1;
+	static constexpr int positionChannel = 4;
+	static constexpr std::size_t channelHeaderSize = 5;
+	static constexpr std::size_t blockHeaderSize = 2 + channelCount * channelHeaderSize;
+
+	using Channels = std::array<std::array<std::uint32_t, blockSampleCount>, channelCount>;
+
+	std::size_t m_sampleCount = 0;
+	float m_sampleRate = 1;
+	CompressionSettings m_settings{};
+	glm::vec3 m_positionMin{};
+	glm::vec3 m_positionStep{};
+	std::vector<std::uint8_t> m_data{};
+	std::vector<std::uint64_t> m_blockOffsets{};
+	CompressionStats m_stats{};
+
+	void quantize(const ClipSample& sample, Channels& channels, std::size_t index) const;
+	void encodeBlock(const Channels& channels, std::size_t count,
+		std::vector<std::uint8_t>& bytes) const;
+	void dequantize(const Channels& channels, std::size_t count, glm::vec4* quats,
+		glm::vec3* positions) const;
+	void measureDecode();
+
+	static std::size_t unpack(const std::uint8_t* data, Channels& channels);
+};
+
+class CompressedTrackDecoder
+{
+public:
+	void setTrack(const CompressedTrack* track);
+
+	ClipSample sample(float time);
+	void sample(const float* times, ClipSample* samples, std::size_t count);
+
+private:
+	static constexpr std::size_t noBlock = static_cast<std::size_t>(-1);
+
+	const CompressedTrack* m_track = nullptr;
+	std::size_t m_block = noBlock;
+	std::size_t m_blockCount = 0;
+	std::array<glm::vec4, CompressedTrack::blockSampleCount> m_quats{};
+	std::array<glm::vec3, CompressedTrack::blockSampleCount> m_positions{};
+};
@@ -0,0 +1,335 @@
+#include "clip/keyframeReduction.hpp"
+
+#include "concurrency/parallelFor.hpp"
+#include "interpolator.hpp"
+#include "math/dualQuat.hpp"
+#include "math/dualQuatScLerp.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+static constexpr std::size_t batchSize = 64;
+static constexpr float minTolerance = 1e-6f;
+static constexpr float minSegmentDuration = 1e-6f;
+
+static float angularDistance(const glm::vec4& first, const glm::vec4& second)
+{
+	float dot = glm::dot(first, second);
+	return 2 * std::atan2(glm::length(second - dot * first), std::abs(dot));
+}
+
+static void setUpSegment(Interpolator& interpolator, const KeyframeTrack& track,
+	std::size_t first, std::size_t last)
+{
+	interpolator.setStartPos(track.positions[first]);
+	interpolator.setEndPos(track.positions[last]);
+	interpolator.setStartQuat(track.quats[first]);
+	interpolator.setEndQuat(track.quats[last]);
+	interpolator.setEndTime(std::max(track.times[last] - track.times[first],
+		minSegmentDuration));
+}
+
+static void interpolateSegment(const Interpolator& interpolator, InterpolationType type,
+	const float* times, glm::vec4* quats, glm::vec3* positions, std::size_t count)
+{
+	if (type == InterpolationType::dualQuatScLerp)
+	{
+		DualQuatScLerp scLerp = interpolator.getDualQuatScLerp();
+		std::array<float, batchSize> ts{};
+		std::array<DualQuat, batchSize> dualQuats{};
+		for (std::size_t begin = 0; begin < count; begin += batchSize)
+		{
+			std::size_t size = std::min(batchSize, count - begin);
+			interpolator.warpTimes(times + begin, ts.data(), size);
+			scLerp.interpolate(ts.data(), dualQuats.data(), size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				quats[begin + i] = dualQuats[i].real;
+				positions[begin + i] = dualQuats[i].translation();
+			}
+		}
+		return;
+	}
+
+	interpolator.interpolateQuats(type, times, quats, count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		positions[i] = interpolator.interpolatePos(PositionCurveType::linear, times[i]);
+	}
+}
+
+struct WindowScratch
+{
+	KeyframeTrack window{};
+	std::vector<std::uint8_t> kept{};
+	std::vector<std::pair<std::size_t, std::size_t>> segments{};
+};
+
+struct WindowKeys
+{
+	KeyframeTrack keys{};
+	bool lastFlipped{};
+};
+
+static void loadWindow(const KeyframeTrackView& track, std::size_t first, std::size_t last,
+	KeyframeTrack& window)
+{
+	window.times.assign(track.times.begin() + first, track.times.begin() + last + 1);
+	window.positions.assign(track.positions.begin() + first,
+		track.positions.begin() + last + 1);
+	window.quats.assign(track.quats.begin() + first, track.quats.begin() + last + 1);
+	for (std::size_t i = 0; i < window.quats.size(); ++i)
+	{
+		window.quats[i] = glm::normalize(window.quats[i]);
+		if (i > 0 && glm::dot(window.quats[i - 1], window.quats[i]) < 0)
+		{
+			window.quats[i] = -window.quats[i];
+		}
+	}
+}
+
+static void reduceWindow(InterpolationType type, const ReductionTolerances& tolerances,
+	WindowScratch& scratch, ReductionStats& stats)
+{
+	const KeyframeTrack& track = scratch.window;
+	std::vector<std::uint8_t>& kept = scratch.kept;
+	std::vector<std::pair<std::size_t, std::size_t>>& segments = scratch.segments;
+	kept.assign(track.times.size(), 0);
+	kept.front() = 1;
+	kept.back() = 1;
+	segments.assign(1, {0, track.times.size() - 1});
+
+	float angularTolerance = std::max(tolerances.angular, minTolerance);
+	float positionalTolerance = std::max(tolerances.positional, minTolerance);
+
+	Interpolator interpolator{};
+	std::array<float, batchSize> times{};
+	std::array<glm::vec4, batchSize> quats{};
+	std::array<glm::vec3, batchSize> positions{};
+
+	while (!segments.empty())
+	{
+		auto [segmentFirst, segmentLast] = segments.back();
+		segments.pop_back();
+		if (segmentLast - segmentFirst < 2)
+		{
+			continue;
+		}
+
+		setUpSegment(interpolator, track, segmentFirst, segmentLast);
+		float worstError = 0;
+		std::size_t worstIndex = segmentFirst;
+		float maxAngularError = 0;
+		float maxPositionalError = 0;
+		for (std::size_t begin = segmentFirst + 1; begin < segmentLast; begin += batchSize)
+		{
+			std::size_t size = std::min(batchSize, segmentLast - begin);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				times[i] = track.times[begin + i] - track.times[segmentFirst];
+			}
+			interpolateSegment(interpolator, type, times.data(), quats.data(), positions.data(),
+				size);
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				float angularError = angularDistance(track.quats[begin + i], quats[i]);
+				float positionalError = glm::length(track.positions[begin + i] - positions[i]);
+				float error = std::max(angularError / angularTolerance,
+					positionalError / positionalTolerance);
+				if (error > worstError)
+				{
+					worstError = error;
+					worstIndex = begin + i;
+				}
+				maxAngularError = std::max(maxAngularError, angularError);
+				maxPositionalError = std::max(maxPositionalError, positionalError);
+			}
+		}
+
+		if (worstError > 1)
+		{
+			kept[worstIndex] = 1;
+			segments.push_back({segmentFirst, worstIndex});
+			segments.push_back({worstIndex, segmentLast});
+		}
+		else
+		{
+			stats.maxAngularError = std::max(stats.maxAngularError, maxAngularError);
+			stats.maxPositionalError = std::max(stats.maxPositionalError, maxPositionalError);
+		}
+	}
+}
+
+static KeyframeTrack reduceTrack(const KeyframeTrackView& track, InterpolationType type,
+	const ReductionTolerances& tolerances, bool parallel, ReductionStats& stats)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	std::size_t keyCount = track.times.size();
+	stats = {keyCount, keyCount};
+	if (keyCount <= 2)
+	{
+		KeyframeTrack reduced{};
+		if (keyCount > 0)
+		{
+			loadWindow(track, 0, keyCount - 1, reduced);
+		}
+		return reduced;
+	}
+
+	std::size_t windowCount = (keyCount - 2) / KeyframeReduction::windowSize + 1;
+	std::vector<WindowKeys> windowKeys(windowCount);
+	std::mutex statsMutex{};
+	auto reduceWindows = [&] (std::size_t begin, std::size_t end)
+	{
+		WindowScratch scratch{};
+		ReductionStats windowStats{};
+		for (std::size_t window = begin; window < end; ++window)
+		{
+			std::size_t first = window * KeyframeReduction::windowSize;
+			std::size_t last = std::min(first + KeyframeReduction::windowSize, keyCount - 1);
+			loadWindow(track, first, last, scratch.window);
+			reduceWindow(type, tolerances, scratch, windowStats);
+
+			WindowKeys& keys = windowKeys[window];
+			for (std::size_t i = 0; i + 1 < scratch.kept.size(); ++i)
+			{
+				if (scratch.kept[i] != 0)
+				{
+					keys.keys.times.push_back(scratch.window.times[i]);
+					keys.keys.positions.push_back(scratch.window.positions[i]);
+					keys.keys.quats.push_back(scratch.window.quats[i]);
+				}
+			}
+			keys.lastFlipped = glm::dot(scratch.window.quats.back(), track.quats[last]) < 0;
+		}
+		std::lock_guard<std::mutex> lock{statsMutex};
+		stats.maxAngularError = std::max(stats.maxAngularError, windowStats.maxAngularError);
+		stats.maxPositionalError =
+			std::max(stats.maxPositionalError, windowStats.maxPositionalError);
+	};
+	if (parallel)
+	{
+		parallelFor(windowCount, 1, reduceWindows);
+	}
+	else
+	{
+		reduceWindows(0, windowCount);
+	}
+
+	KeyframeTrack reduced{};
+	float sign = 1;
+	for (const WindowKeys& keys : windowKeys)
+	{
+		reduced.times.insert(reduced.times.end(), keys.keys.times.begin(),
+			keys.keys.times.end());
+		reduced.positions.insert(reduced.positions.end(), keys.keys.positions.begin(),
+			keys.keys.positions.end());
+		for (const glm::vec4& quat : keys.keys.quats)
+		{
+			reduced.quats.push_back(sign * quat);
+		}
+		if (keys.lastFlipped)
+		{
+			sign = -sign;
+		}
+	}
+	reduced.times.push_back(track.times[keyCount - 1]);
+	reduced.positions.push_back(track.positions[keyCount - 1]);
+	reduced.quats.push_back(sign * glm::normalize(track.quats[keyCount - 1]));
+
+	stats.keyCount = reduced.times.size();
+	stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return reduced;
+}
+
+namespace KeyframeReduction
+{
+	KeyframeTrackView view(const KeyframeTrack& track)
+	{
+		return {track.times, track.positions, track.quats};
+	}
+
+	KeyframeTrackView view(const MotionClip& clip)
+	{
+		return {clip.getTimes(), clip.getPositions(), clip.getQuats()};
+	}
+
+	KeyframeTrack reduce(const KeyframeTrackView& track, InterpolationType type,
+		const ReductionTolerances& tolerances, ReductionStats* stats)
+	{
+		ReductionStats trackStats{};
+		KeyframeTrack reduced = reduceTrack(track, type, tolerances, true, trackStats);
+		if (stats != nullptr)
+		{
+			*stats = trackStats;
+		}
+		return reduced;
+	}
+
+	std::vector<KeyframeTrack> reduce(const std::vector<KeyframeTrack>& tracks,
+		InterpolationType type, const ReductionTolerances& tolerances,
+		std::vector<ReductionStats>* stats)
+	{
+		std::vector<KeyframeTrack> reduced(tracks.size());
+		std::vector<ReductionStats> trackStats(tracks.size());
+		parallelFor(tracks.size(), 1,
+			[&] (std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					reduced[i] =
+						reduceTrack(view(tracks[i]), type, tolerances, false, trackStats[i]);
+				}
+			});
+		if (stats != nullptr)
+		{
+			*stats = std::move(trackStats);
+		}
+		return reduced;
+	}
+}
+
+void KeyframeTrackSampler::setTrack(const KeyframeTrack* track, InterpolationType type)
+{
+	m_track = track;
+	m_type = type;
+	m_segment = noSegment;
+}
+
+ClipSample KeyframeTrackSampler::sample(float time)
+{
+	if (m_track == nullptr || m_track->times.empty())
+	{
+		return {};
+	}
+
+	const std::vector<float>& times = m_track->times;
+	float absoluteTime = times.front() + time;
+	bool inSegment = m_segment != noSegment && times[m_segment] <= absoluteTime &&
+		absoluteTime < times[m_segment + 1];
+	if (!inSegment)
+	{
+		std::size_t last = static_cast<std::size_t>(
+			std::upper_bound(times.begin(), times.end(), absoluteTime) - times.begin());
+		if (last == 0 || last == times.size())
+		{
+			std::size_t index = last == 0 ? 0 : last - 1;
+			return {m_track->positions[index], glm::normalize(m_track->quats[index])};
+		}
+
+		m_segment = last - 1;
+		setUpSegment(m_interpolator, *m_track, m_segment, last);
+	}
+
+	float localTime = absoluteTime - times[m_segment];
+	ClipSample result{};
+	interpolateSegment(m_interpolator, m_type, &localTime, &result.quat, &result.pos, 1);
+	return result;
+}
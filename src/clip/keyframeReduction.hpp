@@ -0,0 +1,70 @@
+#pragma once
+
+#include "clip/motionClip.hpp"
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+struct KeyframeTrack
+{
+	std::vector<float> times{};
+	std::vector<glm::vec3> positions{};
+	std::vector<glm::vec4> quats{};
+};
+
+struct KeyframeTrackView
+{
+	std::span<const float> times{};
+	std::span<const glm::vec3> positions{};
+	std::span<const glm::vec4> quats{};
+};
+
+struct ReductionTolerances
+{
+	float angular = 0.01f;
+	float positional = 0.005f;
+};
+
+struct ReductionStats
+{
+	std::size_t sourceKeyCount{};
+	std::size_t keyCount{};
+	float maxAngularError{};
+	float maxPositionalError{};
+	double seconds{};
+};
+
+namespace KeyframeReduction
+{
+	inline constexpr std::size_t windowSize = 4096;
+
+	KeyframeTrackView view(const KeyframeTrack& track);
+	KeyframeTrackView view(const MotionClip& clip);
+
+	KeyframeTrack reduce(const KeyframeTrackView& track, InterpolationType type,
+		const ReductionTolerances& tolerances, ReductionStats* stats = nullptr);
+	std::vector<KeyframeTrack> reduce(const std::vector<KeyframeTrack>& tracks,
+		InterpolationType type, const ReductionTolerances& tolerances,
+		std::vector<ReductionStats>* stats = nullptr);
+}
+
+class KeyframeTrackSampler
+{
+public:
+	void setTrack(const KeyframeTrack* track, InterpolationType type);
+
+	ClipSample sample(float time);
+
+private:
+	static constexpr std::size_t noSegment = static_cast<std::size_t>(-1);
+
+	const KeyframeTrack* m_track = nullptr;
+	InterpolationType m_type = InterpolationType::quatSlerp;
+	std::size_t m_segment = noSegment;
+	Interpolator m_interpolator{};
+};
@@ -0,0 +1,167 @@
+#include "clip/mappedFile.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::filesystem::path& path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	m_file = file;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		close();
+		return false;
+	}
+	m_size = static_cast<std::size_t>(size.QuadPart);
+
+	m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr)
+	{
+		close();
+		return false;
+	}
+#else
+	m_file = ::open(path.c_str(), O_RDONLY);
+	if (m_file < 0)
+	{
+		return false;
+	}
+
+	struct stat status{};
+	if (fstat(m_file, &status) != 0 || status.st_size == 0)
+	{
+		close();
+		return false;
+	}
+	m_size = static_cast<std::size_t>(status.st_size);
+
+	void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_file, 0);
+	if (data == MAP_FAILED)
+	{
+		close();
+		return false;
+	}
+	m_data = static_cast<std::byte*>(data);
+#endif
+
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != nullptr)
+	{
+		CloseHandle(m_mapping);
+	}
+	if (m_file != nullptr)
+	{
+		CloseHandle(m_file);
+	}
+	m_mapping = nullptr;
+	m_file = nullptr;
+#else
+	if (m_data != nullptr)
+	{
+		munmap(m_data, m_size);
+	}
+	if (m_file >= 0)
+	{
+		::close(m_file);
+	}
+	m_file = -1;
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+	return m_data != nullptr;
+}
+
+const std::byte* MappedFile::getData() const
+{
+	return m_data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+	return m_size;
+}
+
+void MappedFile::adviseSequential() const
+{
+#ifndef _WIN32
+	if (m_data != nullptr)
+	{
+		madvise(m_data, m_size, MADV_SEQUENTIAL);
+	}
+#endif
+}
+
+void MappedFile::prefetch(std::size_t offset, std::size_t size) const
+{
+	if (m_data == nullptr || offset >= m_size)
+	{
+		return;
+	}
+
+	std::size_t begin = offset / pageSize() * pageSize();
+	std::size_t end = std::min(offset + size, m_size);
+
+#ifdef _WIN32
+	WIN32_MEMORY_RANGE_ENTRY range{m_data + begin, end - begin};
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	madvise(m_data + begin, end - begin, MADV_WILLNEED);
+#endif
+}
+
+std::size_t MappedFile::pageSize()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info{};
+	GetSystemInfo(&info);
+	return info.dwPageSize;
+#else
+	return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	bool open(const std::filesystem::path& path);
+	void close();
+	bool isOpen() const;
+
+	const std::byte* getData() const;
+	std::size_t getSize() const;
+
+	void adviseSequential() const;
+	void prefetch(std::size_t offset, std::size_t size) const;
+
+private:
+	std::byte* m_data = nullptr;
+	std::size_t m_size = 0;
+#ifdef _WIN32
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#else
+	int m_file = -1;
+#endif
+
+	static std::size_t pageSize();
+};
@@ -0,0 +1,179 @@
+#include "clip/motionClip.hpp"
+
+#include "clip/motionClipFormat.hpp"
+#include "frame.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+bool MotionClip::open(const std::filesystem::path& path)
+{
+	close();
+	if (!m_file.open(path))
+	{
+		std::cerr << "Error mapping clip:\n" << path.string() << '\n';
+		return false;
+	}
+
+	MotionClipFormat::Header header{};
+	bool valid = m_file.getSize() >= sizeof(header);
+	if (valid)
+	{
+		std::memcpy(&header, m_file.getData(), sizeof(header));
+		MotionClipFormat::Header expected = MotionClipFormat::makeHeader(header.sampleCount,
+			(header.flags & MotionClipFormat::hasEulerAnglesFlag) != 0);
+		valid = header.magic == MotionClipFormat::magic &&
+			header.version == MotionClipFormat::version && header.sampleCount > 0 &&
+			std::memcmp(&header, &expected, sizeof(header)) == 0 &&
+			header.fileSize <= m_file.getSize();
+	}
+	if (!valid)
+	{
+		std::cerr << "Error reading clip header:\n" << path.string() << '\n';
+		close();
+		return false;
+	}
+
+	const std::byte* data = m_file.getData();
+	m_sampleCount = static_cast<std::size_t>(header.sampleCount);
+	m_times = reinterpret_cast<const float*>(data + header.timesOffset);
+	m_positions = reinterpret_cast<const glm::vec3*>(data + header.positionsOffset);
+	m_quats = reinterpret_cast<const glm::vec4*>(data + header.quatsOffset);
+	if ((header.flags & MotionClipFormat::hasEulerAnglesFlag) != 0)
+	{
+		m_eulerAngles = reinterpret_cast<const glm::vec3*>(data + header.eulerAnglesOffset);
+	}
+	m_file.adviseSequential();
+	return true;
+}
+
+void MotionClip::close()
+{
+	m_file.close();
+	m_sampleCount = 0;
+	m_times = nullptr;
+	m_positions = nullptr;
+	m_quats = nullptr;
+	m_eulerAngles = nullptr;
+	m_prefetchedBegin = 0;
+	m_prefetchedEnd = 0;
+}
+
+bool MotionClip::isOpen() const
+{
+	return m_sampleCount > 0;
+}
+
+std::size_t MotionClip::getSampleCount() const
+{
+	return m_sampleCount;
+}
+
+float MotionClip::getDuration() const
+{
+	return isOpen() ? m_times[m_sampleCount - 1] - m_times[0] : 0;
+}
+
+bool MotionClip::hasEulerAngles() const
+{
+	return m_eulerAngles != nullptr;
+}
+
+std::size_t MotionClip::getByteSize() const
+{
+	return m_file.getSize();
+}
+
+std::span<const float> MotionClip::getTimes() const
+{
+	return {m_times, m_sampleCount};
+}
+
+std::span<const glm::vec3> MotionClip::getPositions() const
+{
+	return {m_positions, m_sampleCount};
+}
+
+std::span<const glm::vec4> MotionClip::getQuats() const
+{
+	return {m_quats, m_sampleCount};
+}
+
+std::span<const glm::vec3> MotionClip::getEulerAngles() const
+{
+	return {m_eulerAngles, hasEulerAngles() ? m_sampleCount : 0};
+}
+
+ClipSample MotionClip::sample(float time) const
+{
+	if (!isOpen())
+	{
+		return {};
+	}
+
+	std::size_t index = findSegment(time);
+	if (index + 1 >= m_sampleCount)
+	{
+		return {m_positions[index], m_quats[index]};
+	}
+
+	float absoluteTime = m_times[0] + time;
+	float segmentDuration = m_times[index + 1] - m_times[index];
+	float fraction = segmentDuration > 0 ?
+		std::clamp((absoluteTime - m_times[index]) / segmentDuration, 0.0f, 1.0f) : 0;
+
+	glm::vec4 prevQuat = m_quats[index];
+	glm::vec4 nextQuat = m_quats[index + 1];
+	if (glm::dot(prevQuat, nextQuat) < 0)
+	{
+		nextQuat = -nextQuat;
+	}
+
+	return
+	{
+		glm::mix(m_positions[index], m_positions[index + 1], fraction),
+		glm::normalize(glm::mix(prevQuat, nextQuat, fraction))
+	};
+}
+
+glm::mat4 MotionClip::modelMatrix(float time) const
+{
+	ClipSample clipSample = sample(time);
+	return Frame::modelMatrix(clipSample.pos, Frame::quatToRotationMatrix(clipSample.quat));
+}
+
+void MotionClip::prefetch(float time)
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+	std::size_t begin = findSegment(time);
+	std::size_t end = std::min(findSegment(time + prefetchSeconds) + 2, m_sampleCount);
+	if (begin >= m_prefetchedBegin && end <= m_prefetchedEnd)
+	{
+		return;
+	}
+
+	m_prefetchedBegin = begin;
+	m_prefetchedEnd = std::min(findSegment(time + 2 * prefetchSeconds) + 2, m_sampleCount);
+	prefetchColumn(m_times, sizeof(float), m_prefetchedBegin, m_prefetchedEnd);
+	prefetchColumn(m_positions, sizeof(glm::vec3), m_prefetchedBegin, m_prefetchedEnd);
+	prefetchColumn(m_quats, sizeof(glm::vec4), m_prefetchedBegin, m_prefetchedEnd);
+}
+
+std::size_t MotionClip::findSegment(float time) const
+{
+	const float* next = std::upper_bound(m_times, m_times + m_sampleCount, m_times[0] + time);
+	return next == m_times ? 0 : static_cast<std::size_t>(next - m_times) - 1;
+}
+
+void MotionClip::prefetchColumn(const void* column, std::size_t elementSize, std::size_t begin,
+	std::size_t end) const
+{
+	std::size_t offset = static_cast<std::size_t>(static_cast<const std::byte*>(column) -
+		m_file.getData());
+	m_file.prefetch(offset + begin * elementSize, (end - begin) * elementSize);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "clip/mappedFile.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+struct ClipSample
+{
+	glm::vec3 pos{};
+	glm::vec4 quat{0, 0, 0, 1};
+};
+
+struct MotionClipInfo
+{
+	bool open{};
+	std::size_t sampleCount{};
+	float duration{};
+	bool hasEulerAngles{};
+	std::size_t byteSize{};
+	float openMs{};
+};
+
+class MotionClip
+{
+public:
+	static constexpr float prefetchSeconds = 2;
+
+	bool open(const std::filesystem::path& path);
+	void close();
+	bool isOpen() const;
+
+	std::size_t getSampleCount() const;
+	float getDuration() const;
+	bool hasEulerAngles() const;
+	std::size_t getByteSize() const;
+
+	std::span<const float> getTimes() const;
+	std::span<const glm::vec3> getPositions() const;
+	std::span<const glm::vec4> getQuats() const;
+	std::span<const glm::vec3> getEulerAngles() const;
+
+	ClipSample sample(float time) const;
+	glm::mat4 modelMatrix(float time) const;
+	void prefetch(float time);
+
+private:
+	MappedFile m_file{};
+	std::size_t m_sampleCount = 0;
+	const float* m_times = nullptr;
+	const glm::vec3* m_positions = nullptr;
+	const glm::vec4* m_quats = nullptr;
+	const glm::vec3* m_eulerAngles = nullptr;
+	std::size_t m_prefetchedBegin = 0;
+	std::size_t m_prefetchedEnd = 0;
+
+	std::size_t findSegment(float time) const;
+	void prefetchColumn(const void* column, std::size_t elementSize, std::size_t begin,
+		std::size_t end) const;
+};
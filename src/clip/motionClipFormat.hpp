@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+static_assert(std::endian::native == std::endian::little,
+	"motion clips are mapped in place and stored little-endian");
+
+namespace MotionClipFormat
+{
+	inline constexpr std::array<char, 8> magic{'M', 'I', 'C', 'L', 'I', 'P', '\0', '\0'};
+	inline constexpr std::uint32_t version = 1;
+	inline constexpr std::size_t columnAlignment = 4096;
+
+	inline constexpr std::uint32_t hasEulerAnglesFlag = 1;
+
+	struct Header
+	{
+		std::array<char, 8> magic{};
+		std::uint32_t version{};
+		std::uint32_t flags{};
+		std::uint64_t sampleCount{};
+		std::uint64_t timesOffset{};
+		std::uint64_t positionsOffset{};
+		std::uint64_t quatsOffset{};
+		std::uint64_t eulerAnglesOffset{};
+		std::uint64_t fileSize{};
+	};
+
+	static_assert(sizeof(Header) == 64);
+
+	inline constexpr std::size_t timeSize = sizeof(float);
+	inline constexpr std::size_t positionSize = 3 * sizeof(float);
+	inline constexpr std::size_t quatSize = 4 * sizeof(float);
+	inline constexpr std::size_t eulerAnglesSize = 3 * sizeof(float);
+
+	constexpr std::uint64_t alignColumn(std::uint64_t offset)
+	{
+		return (offset + columnAlignment - 1) / columnAlignment * columnAlignment;
+	}
+
+	constexpr Header makeHeader(std::uint64_t sampleCount, bool hasEulerAngles)
+	{
+		Header header{};
+		header.magic = magic;
+		header.version = version;
+		header.flags = hasEulerAngles ? hasEulerAnglesFlag : 0;
+		header.sampleCount = sampleCount;
+		header.timesOffset = alignColumn(sizeof(Header));
+		header.positionsOffset = alignColumn(header.timesOffset + sampleCount * timeSize);
+		header.quatsOffset = alignColumn(header.positionsOffset + sampleCount * positionSize);
+		std::uint64_t end = header.quatsOffset + sampleCount * quatSize;
+		if (hasEulerAngles)
+		{
+			header.eulerAnglesOffset = alignColumn(end);
+			end = header.eulerAnglesOffset + sampleCount * eulerAnglesSize;
+		}
+		header.fileSize = end;
+		return header;
+	}
+}
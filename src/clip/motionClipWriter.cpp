@@ -0,0 +1,82 @@
+#include "clip/motionClipWriter.hpp"
+
+MotionClipWriter::MotionClipWriter(const std::filesystem::path& path,
+	std::uint64_t sampleCount, bool hasEulerAngles) :
+	m_file{path, std::ios::binary | std::ios::trunc},
+	m_header{MotionClipFormat::makeHeader(sampleCount, hasEulerAngles)}
+{
+	m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+	m_times.reserve(chunkSize);
+	m_positions.reserve(chunkSize);
+	m_quats.reserve(chunkSize);
+	if (hasEulerAngles)
+	{
+		m_eulerAngles.reserve(chunkSize);
+	}
+}
+
+bool MotionClipWriter::isOpen() const
+{
+	return m_file.good();
+}
+
+bool MotionClipWriter::append(float time, const glm::vec3& pos, const glm::vec4& quat,
+	const glm::vec3& eulerAngles)
+{
+	if (m_writtenCount + m_times.size() >= m_header.sampleCount ||
+		(m_writtenCount + m_times.size() > 0 && time < m_lastTime))
+	{
+		return false;
+	}
+
+	m_lastTime = time;
+	m_times.push_back(time);
+	m_positions.push_back(pos);
+	m_quats.push_back(glm::normalize(quat));
+	if ((m_header.flags & MotionClipFormat::hasEulerAnglesFlag) != 0)
+	{
+		m_eulerAngles.push_back(eulerAngles);
+	}
+	return m_times.size() < chunkSize || flush();
+}
+
+bool MotionClipWriter::finish()
+{
+	if (!flush() || m_writtenCount != m_header.sampleCount)
+	{
+		return false;
+	}
+	m_file.close();
+	return !m_file.fail();
+}
+
+bool MotionClipWriter::flush()
+{
+	if (!m_times.empty())
+	{
+		writeColumn(m_header.timesOffset, MotionClipFormat::timeSize, m_times.data());
+		writeColumn(m_header.positionsOffset, MotionClipFormat::positionSize,
+			m_positions.data());
+		writeColumn(m_header.quatsOffset, MotionClipFormat::quatSize, m_quats.data());
+		if ((m_header.flags & MotionClipFormat::hasEulerAnglesFlag) != 0)
+		{
+			writeColumn(m_header.eulerAnglesOffset, MotionClipFormat::eulerAnglesSize,
+				m_eulerAngles.data());
+		}
+
+		m_writtenCount += m_times.size();
+		m_times.clear();
+		m_positions.clear();
+		m_quats.clear();
+		m_eulerAngles.clear();
+	}
+	return m_file.good();
+}
+
+void MotionClipWriter::writeColumn(std::uint64_t offset, std::size_t elementSize,
+	const void* data)
+{
+	m_file.seekp(static_cast<std::streamoff>(offset + m_writtenCount * elementSize));
+	m_file.write(static_cast<const char*>(data),
+		static_cast<std::streamsize>(m_times.size() * elementSize));
+}
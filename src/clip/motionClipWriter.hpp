@@ -0,0 +1,39 @@
+#pragma once
+
+#include "clip/motionClipFormat.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+class MotionClipWriter
+{
+public:
+	MotionClipWriter(const std::filesystem::path& path, std::uint64_t sampleCount,
+		bool hasEulerAngles);
+
+	bool isOpen() const;
+	bool append(float time, const glm::vec3& pos, const glm::vec4& quat,
+		const glm::vec3& eulerAngles = {});
+	bool finish();
+
+private:
+	static constexpr std::size_t chunkSize = 1 << 16;
+
+	std::ofstream m_file{};
+	MotionClipFormat::Header m_header{};
+	std::uint64_t m_writtenCount = 0;
+	float m_lastTime{};
+
+	std::vector<float> m_times{};
+	std::vector<glm::vec3> m_positions{};
+	std::vector<glm::vec4> m_quats{};
+	std::vector<glm::vec3> m_eulerAngles{};
+
+	bool flush();
+	void writeColumn(std::uint64_t offset, std::size_t elementSize, const void* data);
+};
@@ -0,0 +1,38 @@
+#include "clock/clock.hpp"
+
+#include <cmath>
+
+void Clock::start()
+{
+	m_running = true;
+}
+
+void Clock::stop()
+{
+	m_running = false;
+}
+
+bool Clock::isRunning() const
+{
+	return m_running;
+}
+
+Clock::Ticks Clock::getTicks() const
+{
+	return m_ticks;
+}
+
+void Clock::setTicks(Ticks ticks)
+{
+	m_ticks = ticks;
+}
+
+Clock::Ticks Clock::secondsToTicks(float seconds)
+{
+	return std::llround(static_cast<double>(seconds) * ticksPerSecond);
+}
+
+float Clock::ticksToSeconds(Ticks ticks)
+{
+	return static_cast<float>(static_cast<double>(ticks) / ticksPerSecond);
+}
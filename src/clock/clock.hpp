@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+class Clock
+{
+public:
+	using Ticks = std::int64_t;
+
+	static constexpr Ticks ticksPerSecond = 705'600'000;
+
+	virtual ~Clock() = default;
+
+	virtual void start();
+	void stop();
+	virtual void update() = 0;
+	bool isRunning() const;
+
+	Ticks getTicks() const;
+	virtual void setTicks(Ticks ticks);
+
+	static Ticks secondsToTicks(float seconds);
+	static float ticksToSeconds(Ticks ticks);
+
+protected:
+	Ticks m_ticks = 0;
+	bool m_running = false;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class ClockType
+{
+	realTime,
+	fixedStep,
+	scrubbed
+};
+
+inline const std::array<std::string, 3> clockTypeLabels
+{
+	"Real time",
+	"Fixed step",
+	"Scrubbed"
+};
@@ -0,0 +1,25 @@
+#include "clock/fixedStepClock.hpp"
+
+FixedStepClock::FixedStepClock(int stepsPerSecond) :
+	m_stepTicks{ticksPerSecond / stepsPerSecond}
+{ }
+
+void FixedStepClock::update()
+{
+	if (!m_running)
+	{
+		return;
+	}
+
+	advance(1);
+}
+
+void FixedStepClock::advance(Ticks steps)
+{
+	m_ticks += steps * m_stepTicks;
+}
+
+Clock::Ticks FixedStepClock::getStepTicks() const
+{
+	return m_stepTicks;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "clock/clock.hpp"
+
+class FixedStepClock : public Clock
+{
+public:
+	FixedStepClock(int stepsPerSecond);
+	virtual ~FixedStepClock() = default;
+
+	virtual void update() override;
+	void advance(Ticks steps);
+	Ticks getStepTicks() const;
+
+private:
+	Ticks m_stepTicks{};
+};
@@ -0,0 +1,28 @@
+#include "clock/realTimeClock.hpp"
+
+void RealTimeClock::start()
+{
+	Clock::start();
+	m_startTime = std::chrono::steady_clock::now() -
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(Duration{m_ticks});
+}
+
+void RealTimeClock::update()
+{
+	if (!m_running)
+	{
+		return;
+	}
+
+	m_ticks = std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() -
+		m_startTime).count();
+}
+
+void RealTimeClock::setTicks(Ticks ticks)
+{
+	Clock::setTicks(ticks);
+	if (m_running)
+	{
+		start();
+	}
+}
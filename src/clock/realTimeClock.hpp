@@ -0,0 +1,22 @@
+#pragma once
+
+#include "clock/clock.hpp"
+
+#include <chrono>
+#include <ratio>
+
+class RealTimeClock : public Clock
+{
+	using Duration = std::chrono::duration<Ticks, std::ratio<1, ticksPerSecond>>;
+	using TimePoint = std::chrono::steady_clock::time_point;
+
+public:
+	virtual ~RealTimeClock() = default;
+
+	virtual void start() override;
+	virtual void update() override;
+	virtual void setTicks(Ticks ticks) override;
+
+private:
+	TimePoint m_startTime{};
+};
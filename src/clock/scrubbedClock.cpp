@@ -0,0 +1,4 @@
+#include "clock/scrubbedClock.hpp"
+
+void ScrubbedClock::update()
+{ }
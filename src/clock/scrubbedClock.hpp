@@ -0,0 +1,11 @@
+#pragma once
+
+#include "clock/clock.hpp"
+
+class ScrubbedClock : public Clock
+{
+public:
+	virtual ~ScrubbedClock() = default;
+
+	virtual void update() override;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+template <typename Function>
+void parallelFor(std::size_t count, std::size_t grainSize, const Function& function)
+{
+	std::size_t maxThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	std::size_t threadCount = std::min(maxThreadCount, (count + grainSize - 1) / grainSize);
+	if (threadCount <= 1)
+	{
+		function(std::size_t{0}, count);
+		return;
+	}
+
+	std::size_t chunkSize = (count + threadCount - 1) / threadCount;
+	std::vector<std::jthread> threads{};
+	for (std::size_t begin = chunkSize; begin < count; begin += chunkSize)
+	{
+		std::size_t end = std::min(begin + chunkSize, count);
+		threads.emplace_back([&function, begin, end] () { function(begin, end); });
+	}
+	function(std::size_t{0}, chunkSize);
+}
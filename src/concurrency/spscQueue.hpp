@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+template <typename T, std::size_t capacity>
+class SpscQueue
+{
+	static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+	bool push(const T& value);
+	bool pop(T& value);
+	std::size_t size() const;
+
+private:
+	static constexpr std::size_t indexMask = capacity - 1;
+
+	std::array<T, capacity> m_buffer{};
+	alignas(64) std::atomic<std::size_t> m_head = 0;
+	alignas(64) std::atomic<std::size_t> m_tail = 0;
+};
+
+template <typename T, std::size_t capacity>
+bool SpscQueue<T, capacity>::push(const T& value)
+{
+	std::size_t tail = m_tail.load(std::memory_order_relaxed);
+	if (tail - m_head.load(std::memory_order_acquire) == capacity)
+	{
+		return false;
+	}
+
+	m_buffer[tail & indexMask] = value;
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T, std::size_t capacity>
+bool SpscQueue<T, capacity>::pop(T& value)
+{
+	std::size_t head = m_head.load(std::memory_order_relaxed);
+	if (head == m_tail.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	value = m_buffer[head & indexMask];
+	m_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T, std::size_t capacity>
+std::size_t SpscQueue<T, capacity>::size() const
+{
+	return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+}
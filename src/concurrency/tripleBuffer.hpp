@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+template <typename T>
+class TripleBuffer
+{
+public:
+	T& back();
+	void publish();
+
+	bool update();
+	T& front();
+	const T& front() const;
+
+private:
+	static constexpr std::uint8_t indexMask = 0b011;
+	static constexpr std::uint8_t dirtyBit = 0b100;
+
+	std::array<T, 3> m_buffers{};
+	alignas(64) std::uint8_t m_back = 0;
+	alignas(64) std::atomic<std::uint8_t> m_middle = 1;
+	alignas(64) std::uint8_t m_front = 2;
+};
+
+template <typename T>
+T& TripleBuffer<T>::back()
+{
+	return m_buffers[m_back];
+}
+
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+	m_back = m_middle.exchange(m_back | dirtyBit, std::memory_order_acq_rel) & indexMask;
+}
+
+template <typename T>
+bool TripleBuffer<T>::update()
+{
+	if ((m_middle.load(std::memory_order_relaxed) & dirtyBit) == 0)
+	{
+		return false;
+	}
+
+	m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & indexMask;
+	return true;
+}
+
+template <typename T>
+T& TripleBuffer<T>::front()
+{
+	return m_buffers[m_front];
+}
+
+template <typename T>
+const T& TripleBuffer<T>::front() const
+{
+	return m_buffers[m_front];
+}
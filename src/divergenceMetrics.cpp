@@ -0,0 +1,191 @@
+#include "divergenceMetrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+struct QuatPointers
+{
+	const float* x{};
+	const float* y{};
+	const float* z{};
+	const float* w{};
+};
+
+static QuatPointers getPointers(const QuatSamples& quats, std::size_t offset)
+{
+	return {quats.x.data() + offset, quats.y.data() + offset, quats.z.data() + offset,
+		quats.w.data() + offset};
+}
+
+static inline float atanPositive(float sine, float cosine)
+{
+	float norm = std::sqrt(sine * sine + cosine * cosine);
+	float quarter = sine / (norm + cosine);
+	float eighth = quarter / (1 + std::sqrt(1 + quarter * quarter));
+	float ee = eighth * eighth;
+	return 4 * (eighth + eighth * ee * (-3.33329491539e-1f + ee * (1.99777106478e-1f +
+		ee * (-1.38776856032e-1f + ee * 8.05374449538e-2f))));
+}
+
+static inline float angularDistance(const QuatPointers& first, const QuatPointers& second,
+	std::size_t index)
+{
+	float dot = first.x[index] * second.x[index] + first.y[index] * second.y[index] +
+		first.z[index] * second.z[index] + first.w[index] * second.w[index];
+	float absDot = std::abs(dot);
+	float sign = std::copysign(1.0f, dot);
+	float dx = sign * second.x[index] - absDot * first.x[index];
+	float dy = sign * second.y[index] - absDot * first.y[index];
+	float dz = sign * second.z[index] - absDot * first.z[index];
+	float dw = sign * second.w[index] - absDot * first.w[index];
+	float sine = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+	return 2 * atanPositive(sine, absDot);
+}
+
+const DivergenceMetrics& DivergenceMetricsEngine::update(const Interpolator& interpolator,
+	const PoseCache& cache)
+{
+	m_metrics.version = cache.getVersion();
+
+	bool resampled = !m_computed || m_metrics.sampleCount != cache.getSampleCount();
+	std::array<bool, interpolationTypeCount> changed{};
+	bool anyChanged = false;
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		Key key = makeKey(interpolator, static_cast<InterpolationType>(type));
+		changed[type] = resampled || key != m_keys[type];
+		anyChanged = anyChanged || changed[type];
+		m_keys[type] = key;
+	}
+	if (!anyChanged)
+	{
+		++m_metrics.reuseCount;
+		return m_metrics;
+	}
+
+	m_computed = true;
+	++m_metrics.recomputeCount;
+	m_metrics.sampleCount = cache.getSampleCount();
+
+	int pair = 0;
+	for (int first = 0; first < interpolationTypeCount; ++first)
+	{
+		for (int second = first + 1; second < interpolationTypeCount; ++second)
+		{
+			if (changed[first] || changed[second])
+			{
+				m_metrics.pairs[pair].first = static_cast<InterpolationType>(first);
+				m_metrics.pairs[pair].second = static_cast<InterpolationType>(second);
+				computePair(cache, m_metrics.pairs[pair]);
+			}
+			++pair;
+		}
+	}
+
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		if (changed[type])
+		{
+			computeAngularVelocity(cache, static_cast<InterpolationType>(type),
+				m_metrics.angularVelocities[type]);
+		}
+	}
+	return m_metrics;
+}
+
+void DivergenceMetricsEngine::computePair(const PoseCache& cache, PairDivergence& pair)
+{
+	const QuatSamples& first = cache.getRotations(pair.first);
+	const QuatSamples& second = cache.getRotations(pair.second);
+	std::size_t count = std::min(first.x.size(), second.x.size());
+	if (count == 0)
+	{
+		pair.meanAngle = 0;
+		pair.maxAngle = 0;
+		pair.peakTime = 0;
+		return;
+	}
+
+	m_angles.resize(count);
+	QuatPointers firstQuats = getPointers(first, 0);
+	QuatPointers secondQuats = getPointers(second, 0);
+	float* angles = m_angles.data();
+	double sum = 0;
+	float max = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		float angle = angularDistance(firstQuats, secondQuats, i);
+		angles[i] = angle;
+		sum += angle;
+		max = std::max(max, angle);
+	}
+	std::size_t peak = static_cast<std::size_t>(
+		std::find(m_angles.begin(), m_angles.end(), max) - m_angles.begin());
+
+	pair.meanAngle = static_cast<float>(sum / count);
+	pair.maxAngle = max;
+	pair.peakTime = cache.getSampleTime(peak);
+}
+
+void DivergenceMetricsEngine::computeAngularVelocity(const PoseCache& cache,
+	InterpolationType type, AngularVelocityStats& stats)
+{
+	const QuatSamples& rotations = cache.getRotations(type);
+	if (rotations.x.size() < 2)
+	{
+		stats = {};
+		return;
+	}
+	std::size_t count = rotations.x.size() - 1;
+
+	QuatPointers prev = getPointers(rotations, 0);
+	QuatPointers next = getPointers(rotations, 1);
+	constexpr float rate = PoseCache::samplesPerSecond;
+	double sum = 0;
+	double sumSquares = 0;
+	float max = 0;
+	for (std::size_t i = 0; i + 1 < count; ++i)
+	{
+		float velocity = angularDistance(prev, next, i) * rate;
+		sum += velocity;
+		sumSquares += velocity * velocity;
+		max = std::max(max, velocity);
+	}
+
+	float dTime = cache.getSampleTime(count) - cache.getSampleTime(count - 1);
+	float velocity = dTime > 0 ? angularDistance(prev, next, count - 1) / dTime : 0.0f;
+	sum += velocity;
+	sumSquares += velocity * velocity;
+	max = std::max(max, velocity);
+
+	double mean = sum / count;
+	double variance = std::max(sumSquares / count - mean * mean, 0.0);
+	stats.mean = static_cast<float>(mean);
+	stats.max = max;
+	stats.nonUniformity = mean > 0 ? static_cast<float>(std::sqrt(variance) / mean) : 0.0f;
+}
+
+DivergenceMetricsEngine::Key DivergenceMetricsEngine::makeKey(const Interpolator& interpolator,
+	InterpolationType type)
+{
+	Key key
+	{
+		interpolator.getStartQuat(),
+		interpolator.getEndQuat(),
+		interpolator.getStartEulerAngles(),
+		interpolator.getEndEulerAngles(),
+		interpolator.getEndTime(),
+		interpolator.getTimeWarp()
+	};
+	if (type == InterpolationType::euler)
+	{
+		key.startQuat = {};
+		key.endQuat = {};
+	}
+	else
+	{
+		key.startEulerAngles = {};
+		key.endEulerAngles = {};
+	}
+	return key;
+}
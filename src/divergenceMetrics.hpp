@@ -0,0 +1,70 @@
+#pragma once
+
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+#include "poseCache.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+inline constexpr int interpolationTypePairCount =
+	interpolationTypeCount * (interpolationTypeCount - 1) / 2;
+
+struct PairDivergence
+{
+	InterpolationType first{};
+	InterpolationType second{};
+	float meanAngle{};
+	float maxAngle{};
+	float peakTime{};
+};
+
+struct AngularVelocityStats
+{
+	float mean{};
+	float max{};
+	float nonUniformity{};
+};
+
+struct DivergenceMetrics
+{
+	std::uint64_t version{};
+	std::size_t sampleCount{};
+	std::array<PairDivergence, interpolationTypePairCount> pairs{};
+	std::array<AngularVelocityStats, interpolationTypeCount> angularVelocities{};
+	std::uint64_t recomputeCount{};
+	std::uint64_t reuseCount{};
+};
+
+class DivergenceMetricsEngine
+{
+public:
+	const DivergenceMetrics& update(const Interpolator& interpolator, const PoseCache& cache);
+
+private:
+	struct Key
+	{
+		glm::vec4 startQuat{};
+		glm::vec4 endQuat{};
+		glm::vec3 startEulerAngles{};
+		glm::vec3 endEulerAngles{};
+		float endTime{};
+		TimeWarpSettings timeWarp{};
+
+		bool operator==(const Key&) const = default;
+	};
+
+	bool m_computed = false;
+	std::array<Key, interpolationTypeCount> m_keys{};
+	DivergenceMetrics m_metrics{};
+	std::vector<float> m_angles{};
+
+	void computePair(const PoseCache& cache, PairDivergence& pair);
+	void computeAngularVelocity(const PoseCache& cache, InterpolationType type,
+		AngularVelocityStats& stats);
+	static Key makeKey(const Interpolator& interpolator, InterpolationType type);
+};
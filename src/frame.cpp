@@ -1,30 +1,36 @@
 #include "frame.hpp"
 
-#include "shaderPrograms.hpp"
+#include "math/eulerAngles.hpp"
+
+#include <cmath>
 
 Frame::Frame(bool intermediate) :
 	m_intermediate{intermediate}
+{ }
+
+void Frame::render(Renderer& renderer) const
 {
 	if (m_mainFrameMesh == nullptr)
 	{
 		m_mainFrameMesh = std::make_unique<FrameMesh>(false);
 		m_intermediateFrameMesh = std::make_unique<FrameMesh>(true);
 	}
-}
 
-void Frame::render() const
-{
-	updateShaders();
 	if (m_intermediate)
 	{
-		m_intermediateFrameMesh->render();
+		m_intermediateFrameMesh->render(renderer, m_modelMatrix);
 	}
 	else
 	{
-		m_mainFrameMesh->render();
+		m_mainFrameMesh->render(renderer, m_modelMatrix);
 	}
 }
 
+glm::vec3 Frame::getPos() const
+{
+	return m_pos;
+}
+
 void Frame::setPos(const glm::vec3& pos)
 {
 	m_pos = pos;
@@ -33,36 +39,29 @@ void Frame::setPos(const glm::vec3& pos)
 
 void Frame::setEulerAngles(const glm::vec3& angles)
 {
-	glm::mat4 rotationXMatrix
-	{
-		1, 0, 0, 0,
-		0, std::cos(angles.x), std::sin(angles.x), 0,
-		0, -std::sin(angles.x), std::cos(angles.x), 0,
-		0, 0, 0, 1
-	};
-
-	glm::mat4 rotationYMatrix
-	{
-		std::cos(angles.y), 0, -std::sin(angles.y), 0,
-		0, 1, 0, 0,
-		std::sin(angles.y), 0, std::cos(angles.y), 0,
-		0, 0, 0, 1
-	};
+	m_rotationMatrix = eulerAnglesToRotationMatrix(angles);
+	updateModelMatrix();
+}
 
-	glm::mat4 rotationZMatrix
-	{
-		std::cos(angles.z), std::sin(angles.z), 0, 0,
-		-std::sin(angles.z), std::cos(angles.z), 0, 0,
-		0, 0, 1, 0,
-		0, 0, 0, 1
-	};
+void Frame::setQuat(const glm::vec4& quat)
+{
+	m_rotationMatrix = quatToRotationMatrix(quat);
+	updateModelMatrix();
+}
 
-	m_rotationMatrix = rotationZMatrix * rotationYMatrix * rotationXMatrix;
+void Frame::setModelMatrix(const glm::mat4& modelMatrix)
+{
+	m_pos = modelMatrix[3];
+	m_rotationMatrix = glm::mat4{glm::mat3{modelMatrix}};
+	m_modelMatrix = modelMatrix;
+}
 
-	updateModelMatrix();
+glm::mat4 Frame::eulerAnglesToRotationMatrix(const glm::vec3& angles)
+{
+	return glm::mat4{EulerAngles::toMatrix<EulerOrder::xyz>(angles)};
 }
 
-void Frame::setQuat(const glm::vec4& quat)
+glm::mat4 Frame::quatToRotationMatrix(const glm::vec4& quat)
 {
 	float xx = quat.x * quat.x;
 	float yy = quat.y * quat.y;
@@ -75,35 +74,59 @@ void Frame::setQuat(const glm::vec4& quat)
 	float yw = quat.y * quat.w;
 	float zw = quat.z * quat.w;
 
-	m_rotationMatrix =
+	return
 		{
 			ww + xx - yy - zz, 2 * (xy + zw), 2 * (xz - yw), 0,
 			2 * (xy - zw), ww - xx + yy - zz, 2 * (yz + xw), 0,
 			2 * (xz + yw), 2 * (yz - xw), ww - xx - yy + zz, 0,
 			0, 0, 0, 1
 		};
-
-	updateModelMatrix();
 }
 
-std::unique_ptr<FrameMesh> Frame::m_mainFrameMesh = nullptr;
-std::unique_ptr<FrameMesh> Frame::m_intermediateFrameMesh = nullptr;
-
-void Frame::updateShaders() const
+glm::vec4 Frame::rotationMatrixToQuat(const glm::mat4& rotationMatrix)
 {
-	ShaderPrograms::frame->use();
-	ShaderPrograms::frame->setUniform("modelMatrix", m_modelMatrix);
+	const glm::mat4& m = rotationMatrix;
+	float trace = m[0][0] + m[1][1] + m[2][2];
+
+	if (trace > 0)
+	{
+		float s = 2 * std::sqrt(trace + 1);
+		return {(m[1][2] - m[2][1]) / s, (m[2][0] - m[0][2]) / s, (m[0][1] - m[1][0]) / s,
+			s / 4};
+	}
+	if (m[0][0] > m[1][1] && m[0][0] > m[2][2])
+	{
+		float s = 2 * std::sqrt(1 + m[0][0] - m[1][1] - m[2][2]);
+		return {s / 4, (m[1][0] + m[0][1]) / s, (m[2][0] + m[0][2]) / s,
+			(m[1][2] - m[2][1]) / s};
+	}
+	if (m[1][1] > m[2][2])
+	{
+		float s = 2 * std::sqrt(1 + m[1][1] - m[0][0] - m[2][2]);
+		return {(m[1][0] + m[0][1]) / s, s / 4, (m[2][1] + m[1][2]) / s,
+			(m[2][0] - m[0][2]) / s};
+	}
+	float s = 2 * std::sqrt(1 + m[2][2] - m[0][0] - m[1][1]);
+	return {(m[2][0] + m[0][2]) / s, (m[2][1] + m[1][2]) / s, s / 4, (m[0][1] - m[1][0]) / s};
 }
 
-void Frame::updateModelMatrix()
+glm::mat4 Frame::modelMatrix(const glm::vec3& pos, const glm::mat4& rotationMatrix)
 {
 	glm::mat4 posMatrix
 	{
 		1, 0, 0, 0,
 		0, 1, 0, 0,
 		0, 0, 1, 0,
-		m_pos.x, m_pos.y, m_pos.z, 1
+		pos.x, pos.y, pos.z, 1
 	};
 
-	m_modelMatrix = posMatrix * m_rotationMatrix;
+	return posMatrix * rotationMatrix;
+}
+
+std::unique_ptr<FrameMesh> Frame::m_mainFrameMesh = nullptr;
+std::unique_ptr<FrameMesh> Frame::m_intermediateFrameMesh = nullptr;
+
+void Frame::updateModelMatrix()
+{
+	m_modelMatrix = modelMatrix(m_pos, m_rotationMatrix);
 }
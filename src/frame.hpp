@@ -2,6 +2,7 @@
 
 #include "camera/camera.hpp"
 #include "frameMesh.hpp"
+#include "render/renderer.hpp"
 
 #include <glm/glm.hpp>
 
@@ -12,11 +13,18 @@ class Frame
 public:
 	Frame(bool intermediate = true);
 
-	void render() const;
+	void render(Renderer& renderer) const;
 
+	glm::vec3 getPos() const;
 	void setPos(const glm::vec3& pos);
 	void setEulerAngles(const glm::vec3& angles);
 	void setQuat(const glm::vec4& quat);
+	void setModelMatrix(const glm::mat4& modelMatrix);
+
+	static glm::mat4 eulerAnglesToRotationMatrix(const glm::vec3& angles);
+	static glm::mat4 quatToRotationMatrix(const glm::vec4& quat);
+	static glm::vec4 rotationMatrixToQuat(const glm::mat4& rotationMatrix);
+	static glm::mat4 modelMatrix(const glm::vec3& pos, const glm::mat4& rotationMatrix);
 
 private:
 	static std::unique_ptr<FrameMesh> m_mainFrameMesh;
@@ -26,6 +34,5 @@ private:
 	glm::mat4 m_modelMatrix{1};
 	bool m_intermediate{};
 
-	void updateShaders() const;
 	void updateModelMatrix();
 };
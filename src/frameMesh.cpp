@@ -1,22 +1,31 @@
 #include "frameMesh.hpp"
 
+#include "memory/glResourceTracker.hpp"
+#include "shaderPrograms.hpp"
+
 #include <glad/glad.h>
 
 FrameMesh::FrameMesh(bool intermediate) :
 	m_intermediate{intermediate}
 {
 	glGenVertexArrays(1, &m_VAO);
+	GLResourceTracker::add(GLResourceType::vertexArray);
 }
 
 FrameMesh::~FrameMesh()
 {
 	glDeleteVertexArrays(1, &m_VAO);
+	GLResourceTracker::remove(GLResourceType::vertexArray);
 }
 
-void FrameMesh::render() const
+void FrameMesh::render(Renderer& renderer, const glm::mat4& modelMatrix) const
 {
-	glBindVertexArray(m_VAO);
-	glLineWidth(m_intermediate ? 1.0f : 5.0f);
-	glDrawArrays(GL_POINTS, 0, 1);
-	glBindVertexArray(0);
+	DrawCommand command{};
+	command.program = ShaderPrograms::frame.get();
+	command.VAO = m_VAO;
+	command.lineWidth = m_intermediate ? 1.0f : 5.0f;
+	command.mode = GL_POINTS;
+	command.count = 1;
+	command.setUniform("modelMatrix", modelMatrix);
+	renderer.submit(command);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "render/renderer.hpp"
+
+#include <glm/glm.hpp>
+
 class FrameMesh
 {
 public:
 	FrameMesh(bool intermediate);
 	~FrameMesh();
-	void render() const;
+	void render(Renderer& renderer, const glm::mat4& modelMatrix) const;
 
 private:
 	unsigned int m_VAO{};
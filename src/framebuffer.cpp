@@ -1,11 +1,21 @@
 #include "framebuffer.hpp"
 
+#include "memory/glResourceTracker.hpp"
+
 #include <glad/glad.h>
 
+#include <cstdint>
+
+static constexpr std::int64_t colorBytesPerPixel = 3;
+static constexpr std::int64_t depthStencilBytesPerPixel = 4;
+
+static std::int64_t pixelCount(const glm::ivec2& size);
+
 Framebuffer::Framebuffer(const glm::ivec2& size) :
 	m_size{size}
 {
 	glGenFramebuffers(1, &m_FBO);
+	GLResourceTracker::add(GLResourceType::framebuffer);
 	bind();
 
 	createColorBuffer(size);
@@ -23,6 +33,10 @@ Framebuffer::~Framebuffer()
 	glDeleteRenderbuffers(1, &m_depthStencilBuffer);
 	glDeleteTextures(1, &m_colorBuffer);
 	glDeleteFramebuffers(1, &m_FBO);
+	GLResourceTracker::remove(GLResourceType::renderbuffer, 1,
+		depthStencilBytesPerPixel * pixelCount(m_size));
+	GLResourceTracker::remove(GLResourceType::texture, 1, colorBytesPerPixel * pixelCount(m_size));
+	GLResourceTracker::remove(GLResourceType::framebuffer);
 }
 
 void Framebuffer::bind()
@@ -39,15 +53,21 @@ void Framebuffer::unbind() const
 		m_previousViewport[3]);
 }
 
-void Framebuffer::bindTexture() const
+unsigned int Framebuffer::getTexture() const
 {
-	glBindTexture(GL_TEXTURE_2D, m_colorBuffer);
+	return m_colorBuffer;
 }
 
-void Framebuffer::resize(const glm::ivec2& size) const
+void Framebuffer::resize(const glm::ivec2& size)
 {
 	resizeColorBuffer(size);
 	resizeDepthStencilBuffer(size);
+	GLResourceTracker::resize(GLResourceType::texture, colorBytesPerPixel * pixelCount(m_size),
+		colorBytesPerPixel * pixelCount(size));
+	GLResourceTracker::resize(GLResourceType::renderbuffer,
+		depthStencilBytesPerPixel * pixelCount(m_size),
+		depthStencilBytesPerPixel * pixelCount(size));
+	m_size = size;
 }
 
 void Framebuffer::getTextureData(unsigned char* output) const
@@ -59,6 +79,7 @@ void Framebuffer::createColorBuffer(const glm::ivec2& size)
 {
 	glGenTextures(1, &m_colorBuffer);
 	resizeColorBuffer(size);
+	GLResourceTracker::add(GLResourceType::texture, 1, colorBytesPerPixel * pixelCount(size));
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glBindTexture(GL_TEXTURE_2D, 0);
@@ -68,6 +89,8 @@ void Framebuffer::createDepthStencilBuffer(const glm::ivec2& size)
 {
 	glGenRenderbuffers(1, &m_depthStencilBuffer);
 	resizeDepthStencilBuffer(size);
+	GLResourceTracker::add(GLResourceType::renderbuffer, 1,
+		depthStencilBytesPerPixel * pixelCount(size));
 	glBindRenderbuffer(GL_RENDERBUFFER, 0);
 }
 
@@ -83,3 +106,8 @@ void Framebuffer::resizeDepthStencilBuffer(const glm::ivec2& size) const
 	glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencilBuffer);
 	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, size.x, size.y);
 }
+
+std::int64_t pixelCount(const glm::ivec2& size)
+{
+	return static_cast<std::int64_t>(size.x) * size.y;
+}
@@ -11,8 +11,8 @@ public:
 	~Framebuffer();
 	void bind();
 	void unbind() const;
-	void bindTexture() const;
-	void resize(const glm::ivec2& size) const;
+	unsigned int getTexture() const;
+	void resize(const glm::ivec2& size);
 	void getTextureData(unsigned char* output) const;
 
 private:
@@ -1,5 +1,7 @@
 #include "gui/gui.hpp"
 
+#include "memory/allocationTracker.hpp"
+
 #include <imgui/backends/imgui_impl_glfw.h>
 #include <imgui/backends/imgui_impl_opengl3.h>
 #include <imgui/imgui.h>
@@ -24,6 +26,7 @@ GUI::~GUI()
 
 void GUI::update()
 {
+	AllocationZoneScope zone{AllocationZone::gui};
 	ImGui_ImplGlfw_NewFrame();
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui::NewFrame();
@@ -33,6 +36,7 @@ void GUI::update()
 
 void GUI::render()
 {
+	AllocationZoneScope zone{AllocationZone::gui};
 	ImGui::Render();
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
@@ -1,10 +1,35 @@
 #include "gui/leftPanel.hpp"
 
+#include "blend/blendMethod.hpp"
+#include "blend/motionBlender.hpp"
+#include "clip/clipPlayback.hpp"
+#include "clip/compressedTrack.hpp"
+#include "clip/keyframeReduction.hpp"
+#include "clip/motionClip.hpp"
+#include "clock/clockType.hpp"
+#include "divergenceMetrics.hpp"
 #include "interpolationType.hpp"
+#include "math/positionSpline.hpp"
+#include "math/timeWarp.hpp"
+#include "memory/allocationTracker.hpp"
+#include "memory/allocationZone.hpp"
+#include "memory/glResourceTracker.hpp"
+#include "memory/glResourceType.hpp"
+#include "memory/memoryUsage.hpp"
+#include "poseCache.hpp"
+#include "positionCurveType.hpp"
+#include "render/renderer.hpp"
+#include "sceneCommand.hpp"
+#include "skeleton/skeletalMotion.hpp"
+#include "timeWarpType.hpp"
 
 #include <imgui/imgui.h>
 
 #include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
 
 LeftPanel::LeftPanel(Scene& scene, const glm::ivec2& viewportSize) :
 	m_scene{scene},
@@ -17,6 +42,11 @@ void LeftPanel::update()
 	ImGui::SetNextWindowSize({width, static_cast<float>(m_viewportSize.y)}, ImGuiCond_Always);
 	ImGui::Begin("leftPanel", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoTitleBar);
 	ImGui::PushItemWidth(100);
+	if (m_scene.isInputLocked())
+	{
+		ImGui::TextColored({1.0f, 0.8f, 0.4f, 1.0f}, "replaying input log");
+	}
+	ImGui::BeginDisabled(m_scene.isInputLocked());
 
 	ImGui::SeparatorText("Camera");
 	updateCamera();
@@ -26,46 +56,110 @@ void LeftPanel::update()
 	ImGui::Text("Left pane");
 	updateInterpolationType(
 		[this] () { return m_scene.getInterpolationTypeLeft(); },
-		[this] (InterpolationType type) { m_scene.setInterpolationTypeLeft(type); },
+		[this] (InterpolationType type)
+		{
+			m_scene.submitCommand(SceneCommands::SetInterpolationTypeLeft{type});
+		},
 		"##interpolationTypeLeft");
+	updatePositionCurve(
+		[this] () { return m_scene.getPositionCurveLeft(); },
+		[this] (PositionCurveType type)
+		{
+			m_scene.submitCommand(SceneCommands::SetPositionCurveLeft{type});
+		},
+		m_scene.getInterpolationTypeLeft(), "##positionCurveLeft");
 	ImGui::Spacing();
 	ImGui::Text("Right pane");
 	updateInterpolationType(
 		[this] () { return m_scene.getInterpolationTypeRight(); },
-		[this] (InterpolationType type) { m_scene.setInterpolationTypeRight(type); },
+		[this] (InterpolationType type)
+		{
+			m_scene.submitCommand(SceneCommands::SetInterpolationTypeRight{type});
+		},
 		"##interpolationTypeRight");
+	updatePositionCurve(
+		[this] () { return m_scene.getPositionCurveRight(); },
+		[this] (PositionCurveType type)
+		{
+			m_scene.submitCommand(SceneCommands::SetPositionCurveRight{type});
+		},
+		m_scene.getInterpolationTypeRight(), "##positionCurveRight");
 
 	ImGui::SeparatorText("Start");
 	updatePosAndOrientation(
 		[this] () { return m_scene.getStartPos(); },
-		[this] (const glm::vec3& pos) { m_scene.setStartPos(pos); },
+		[this] (const glm::vec3& pos) { m_scene.submitCommand(SceneCommands::SetStartPos{pos}); },
 		[this] () { return m_scene.getStartEulerAngles(); },
-		[this] (const glm::vec3& eulerAngles) { m_scene.setStartEulerAngles(eulerAngles); },
+		[this] (const glm::vec3& eulerAngles)
+		{
+			m_scene.submitCommand(SceneCommands::SetStartEulerAngles{eulerAngles});
+		},
 		[this] () { return m_scene.getStartQuat(); },
-		[this] (const glm::vec4& quat) { m_scene.setStartQuat(quat); },
-		[this] () { m_scene.normalizeStartQuat(); },
-		"##start");
+		[this] (const glm::vec4& quat)
+		{
+			m_scene.submitCommand(SceneCommands::SetStartQuat{quat});
+		},
+		[this] () { m_scene.submitCommand(SceneCommands::NormalizeStartQuat{}); },
+		"start");
 
 	ImGui::SeparatorText("End");
 	updatePosAndOrientation(
 		[this] () { return m_scene.getEndPos(); },
-		[this] (const glm::vec3& pos) { m_scene.setEndPos(pos); },
+		[this] (const glm::vec3& pos) { m_scene.submitCommand(SceneCommands::SetEndPos{pos}); },
 		[this] () { return m_scene.getEndEulerAngles(); },
-		[this] (const glm::vec3& eulerAngles) { m_scene.setEndEulerAngles(eulerAngles); },
+		[this] (const glm::vec3& eulerAngles)
+		{
+			m_scene.submitCommand(SceneCommands::SetEndEulerAngles{eulerAngles});
+		},
 		[this] () { return m_scene.getEndQuat(); },
-		[this] (const glm::vec4& quat) { m_scene.setEndQuat(quat); },
-		[this] () { m_scene.normalizeEndQuat(); },
-		"##end");
+		[this] (const glm::vec4& quat) { m_scene.submitCommand(SceneCommands::SetEndQuat{quat}); },
+		[this] () { m_scene.submitCommand(SceneCommands::NormalizeEndQuat{}); },
+		"end");
+
+	ImGui::SeparatorText("Position keys");
+	updatePosKeys();
 
 	ImGui::SeparatorText("Animation");
 	updateAnimationTime();
 	ImGui::Spacing();
+	updateTimeWarp();
+	ImGui::Spacing();
 	updateIntermediateFrames();
 	ImGui::Spacing();
+	updateClockType();
+	ImGui::Spacing();
 	updateButtons();
 	ImGui::Spacing();
 	updateTime();
 
+	ImGui::SeparatorText("Clip");
+	updateClip();
+
+	ImGui::SeparatorText("Skeletons");
+	updateSkeletons();
+
+	ImGui::SeparatorText("Blend");
+	updateBlend();
+
+	ImGui::SeparatorText("Divergence");
+	updateDivergenceMetrics();
+
+	ImGui::SeparatorText("Baked cache");
+	updatePoseCache();
+
+	ImGui::SeparatorText("Command queue");
+	updateCommandStats();
+
+	ImGui::SeparatorText("Renderer");
+	updateRenderStats();
+
+	ImGui::SeparatorText("Allocations");
+	updateAllocations();
+
+	ImGui::SeparatorText("Memory");
+	updateMemoryUsages();
+
+	ImGui::EndDisabled();
 	ImGui::PopItemWidth();
 	ImGui::End();
 }
@@ -76,15 +170,15 @@ void LeftPanel::updateCamera()
 }
 
 void LeftPanel::updateInterpolationType(const std::function<InterpolationType(void)>& getter,
-	const std::function<void(InterpolationType)>& setter, const std::string& suffix)
+	const std::function<void(InterpolationType)>& setter, const char* suffix)
 {
 	ImGui::PushItemWidth(170);
 
 	InterpolationType interpolationType = getter();
-	if (ImGui::BeginCombo(suffix.c_str(),
+	if (ImGui::BeginCombo(suffix,
 		interpolationTypeLabels[static_cast<int>(interpolationType)].c_str()))
 	{
-		for (int i = 0; i < 3; ++i)
+		for (int i = 0; i < interpolationTypeCount; ++i)
 		{
 			bool isSelected = i == static_cast<int>(interpolationType);
 			if (ImGui::Selectable(interpolationTypeLabels[i].c_str(), isSelected))
@@ -98,14 +192,42 @@ void LeftPanel::updateInterpolationType(const std::function<InterpolationType(vo
 	ImGui::PopItemWidth();
 }
 
+void LeftPanel::updatePositionCurve(const std::function<PositionCurveType(void)>& getter,
+	const std::function<void(PositionCurveType)>& setter, InterpolationType interpolationType,
+	const char* suffix)
+{
+	ImGui::PushItemWidth(170);
+	ImGui::BeginDisabled(interpolatesPos(interpolationType));
+
+	PositionCurveType positionCurve = interpolatesPos(interpolationType) ?
+		PositionCurveType::linear : getter();
+	if (ImGui::BeginCombo(suffix,
+		positionCurveTypeLabels[static_cast<int>(positionCurve)].c_str()))
+	{
+		for (int i = 0; i < positionCurveTypeCount; ++i)
+		{
+			bool isSelected = i == static_cast<int>(positionCurve);
+			if (ImGui::Selectable(positionCurveTypeLabels[i].c_str(), isSelected))
+			{
+				setter(static_cast<PositionCurveType>(i));
+			}
+		}
+		ImGui::EndCombo();
+	}
+
+	ImGui::EndDisabled();
+	ImGui::PopItemWidth();
+}
+
 void LeftPanel::updatePosAndOrientation(const std::function<glm::vec3(void)>& posGetter,
 	const std::function<void(const glm::vec3&)>& posSetter,
 	const std::function<glm::vec3(void)>& eulerAnglesGetter,
 	const std::function<void(const glm::vec3&)>& eulerAnglesSetter,
 	const std::function<glm::vec4(void)>& quatGetter,
 	const std::function<void(const glm::vec4&)>& quatSetter,
-	const std::function<void(void)>& normalizeQuat, const std::string& suffix)
+	const std::function<void(void)>& normalizeQuat, const char* id)
 {
+	ImGui::PushID(id);
 	ImGui::PushItemWidth(69);
 
 	glm::vec3 pos = posGetter();
@@ -113,11 +235,11 @@ void LeftPanel::updatePosAndOrientation(const std::function<glm::vec3(void)>& po
 
 	constexpr float speedPos = 0.01f;
 	ImGui::Text("Position");
-	ImGui::DragFloat(("x" + suffix + "Pos").c_str(), &pos.x, speedPos);
+	ImGui::DragFloat("x##pos", &pos.x, speedPos);
 	ImGui::SameLine();
-	ImGui::DragFloat(("y" + suffix + "Pos").c_str(), &pos.y, speedPos);
+	ImGui::DragFloat("y##pos", &pos.y, speedPos);
 	ImGui::SameLine();
-	ImGui::DragFloat(("z" + suffix + "Pos").c_str(), &pos.z, speedPos);
+	ImGui::DragFloat("z##pos", &pos.z, speedPos);
 
 	if (pos != prevPos)
 	{
@@ -129,13 +251,13 @@ void LeftPanel::updatePosAndOrientation(const std::function<glm::vec3(void)>& po
 
 	constexpr float speedEulerAngles = 0.2f;
 	ImGui::Text("Euler angles");
-	ImGui::DragFloat(("x" + suffix + "EulerAngles").c_str(), &eulerAngles.x, speedEulerAngles,
+	ImGui::DragFloat("x##eulerAngles", &eulerAngles.x, speedEulerAngles,
 		-180.0f, 180.f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 	ImGui::SameLine();
-	ImGui::DragFloat(("y" + suffix + "EulerAngles").c_str(), &eulerAngles.y, speedEulerAngles,
+	ImGui::DragFloat("y##eulerAngles", &eulerAngles.y, speedEulerAngles,
 		-90.0f, 90.f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 	ImGui::SameLine();
-	ImGui::DragFloat(("z" + suffix + "EulerAngles").c_str(), &eulerAngles.z, speedEulerAngles,
+	ImGui::DragFloat("z##eulerAngles", &eulerAngles.z, speedEulerAngles,
 		-180.0f, 180.f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 
 	if (eulerAngles != prevEulerAngles)
@@ -151,13 +273,13 @@ void LeftPanel::updatePosAndOrientation(const std::function<glm::vec3(void)>& po
 
 	constexpr float speedQuat = 0.01f;
 	ImGui::Text("Quaternion");
-	ImGui::DragFloat(("x" + suffix + "Quaternion").c_str(), &quat.x, speedQuat);
+	ImGui::DragFloat("x##quaternion", &quat.x, speedQuat);
 	ImGui::SameLine();
-	ImGui::DragFloat(("y" + suffix + "Quaternion").c_str(), &quat.y, speedQuat);
+	ImGui::DragFloat("y##quaternion", &quat.y, speedQuat);
 	ImGui::SameLine();
-	ImGui::DragFloat(("z" + suffix + "Quaternion").c_str(), &quat.z, speedQuat);
+	ImGui::DragFloat("z##quaternion", &quat.z, speedQuat);
 	ImGui::SameLine();
-	ImGui::DragFloat(("w" + suffix + "Quaternion").c_str(), &quat.w, speedPos);
+	ImGui::DragFloat("w##quaternion", &quat.w, speedPos);
 
 	if (quat != prevQuat)
 	{
@@ -167,10 +289,97 @@ void LeftPanel::updatePosAndOrientation(const std::function<glm::vec3(void)>& po
 	ImGui::PopItemWidth();
 	ImGui::Spacing();
 
-	if (ImGui::Button(("Normalize" + suffix + "Normalize").c_str()))
+	if (ImGui::Button("Normalize"))
 	{
 		normalizeQuat();
 	}
+
+	ImGui::PopID();
+}
+
+void LeftPanel::updatePosKeys()
+{
+	bool constantSpeed = m_scene.getConstantSpeed();
+	bool prevConstantSpeed = constantSpeed;
+
+	ImGui::Checkbox("constant speed", &constantSpeed);
+
+	if (constantSpeed != prevConstantSpeed)
+	{
+		m_scene.submitCommand(SceneCommands::SetConstantSpeed{constantSpeed});
+	}
+
+	for (int i = 0; i < m_scene.getPosKeyCount(); ++i)
+	{
+		ImGui::Spacing();
+		updatePosKey(i);
+	}
+}
+
+void LeftPanel::updatePosKey(int index)
+{
+	ImGui::PushID(index);
+	bool inner = index > 0 && index < m_scene.getPosKeyCount() - 1;
+
+	if (index == 0)
+	{
+		ImGui::Text("Start");
+	}
+	else if (inner)
+	{
+		ImGui::Text("Key %d", index);
+	}
+	else
+	{
+		ImGui::Text("End");
+	}
+
+	if (index > 0)
+	{
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Insert before"))
+		{
+			m_scene.submitCommand(SceneCommands::InsertPosKey{index});
+		}
+	}
+	if (inner)
+	{
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Remove"))
+		{
+			m_scene.submitCommand(SceneCommands::RemovePosKey{index});
+		}
+	}
+
+	ImGui::PushItemWidth(69);
+
+	PositionKey key = m_scene.getPosKey(index);
+	PositionKey prevKey = key;
+
+	constexpr float speed = 0.01f;
+	if (inner)
+	{
+		ImGui::DragFloat("x##pos", &key.pos.x, speed);
+		ImGui::SameLine();
+		ImGui::DragFloat("y##pos", &key.pos.y, speed);
+		ImGui::SameLine();
+		ImGui::DragFloat("z##pos", &key.pos.z, speed);
+	}
+
+	ImGui::Text("Tangent");
+	ImGui::DragFloat("x##tangent", &key.tangent.x, speed);
+	ImGui::SameLine();
+	ImGui::DragFloat("y##tangent", &key.tangent.y, speed);
+	ImGui::SameLine();
+	ImGui::DragFloat("z##tangent", &key.tangent.z, speed);
+
+	if (key.pos != prevKey.pos || key.tangent != prevKey.tangent)
+	{
+		m_scene.submitCommand(SceneCommands::SetPosKey{index, key});
+	}
+
+	ImGui::PopItemWidth();
+	ImGui::PopID();
 }
 
 void LeftPanel::updateAnimationTime()
@@ -180,12 +389,74 @@ void LeftPanel::updateAnimationTime()
 
 	constexpr float speed = 0.1f;
 	ImGui::Text("Time");
-	ImGui::DragFloat("##animationTime", &animationTime, speed, 0.01f, 3600.0f, "%.2f",
-		ImGuiSliderFlags_AlwaysClamp);
+	ImGui::DragFloat("##animationTime", &animationTime, speed, Interpolator::minEndTime,
+		Interpolator::maxEndTime, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 
 	if (animationTime != prevAnimationTime)
 	{
-		m_scene.setAnimationTime(animationTime);
+		m_scene.submitCommand(SceneCommands::SetAnimationTime{animationTime});
+	}
+}
+
+void LeftPanel::updateTimeWarp()
+{
+	TimeWarpSettings settings = m_scene.getTimeWarp();
+	TimeWarpSettings prevSettings = settings;
+
+	ImGui::Text("Time warp");
+	ImGui::PushItemWidth(170);
+	if (ImGui::BeginCombo("##timeWarpType",
+		timeWarpTypeLabels[static_cast<int>(settings.type)].c_str()))
+	{
+		for (int i = 0; i < timeWarpTypeCount; ++i)
+		{
+			bool isSelected = i == static_cast<int>(settings.type);
+			if (ImGui::Selectable(timeWarpTypeLabels[i].c_str(), isSelected))
+			{
+				settings.type = static_cast<TimeWarpType>(i);
+			}
+		}
+		ImGui::EndCombo();
+	}
+	ImGui::PopItemWidth();
+
+	constexpr float speed = 0.01f;
+	if (settings.type == TimeWarpType::cubicBezier)
+	{
+		ImGui::DragFloat2("p1##timeWarpBezierStart", &settings.bezierStart.x, speed, -1.0f, 2.0f,
+			"%.2f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragFloat2("p2##timeWarpBezierEnd", &settings.bezierEnd.x, speed, -1.0f, 2.0f,
+			"%.2f", ImGuiSliderFlags_AlwaysClamp);
+		settings.bezierStart.x = std::clamp(settings.bezierStart.x, 0.0f, 1.0f);
+		settings.bezierEnd.x = std::clamp(settings.bezierEnd.x, 0.0f, 1.0f);
+	}
+	else if (settings.type == TimeWarpType::piecewise)
+	{
+		for (int i = 1; i + 1 < TimeWarpSettings::knotCount; ++i)
+		{
+			std::array<char, 32> label{};
+			std::snprintf(label.data(), label.size(), "knot %d##timeWarpKnot", i);
+			ImGui::SliderFloat(label.data(), &settings.knots[i], 0.0f, 1.0f, "%.2f");
+		}
+	}
+
+	constexpr int previewSampleCount = 64;
+	TimeWarp timeWarp{settings};
+	std::array<float, previewSampleCount> preview{};
+	for (int i = 0; i < previewSampleCount; ++i)
+	{
+		preview[i] = timeWarp.warp(static_cast<float>(i) / (previewSampleCount - 1));
+	}
+	ImGui::PlotLines("##timeWarpPreview", preview.data(), previewSampleCount, 0, nullptr, -0.25f,
+		1.25f, {170, 60});
+
+	float animationTime = m_scene.getAnimationTime();
+	float t = animationTime > 0 ? std::clamp(m_scene.getTime() / animationTime, 0.0f, 1.0f) : 0;
+	ImGui::Text("t = %.2f -> %.2f", t, timeWarp.warp(t));
+
+	if (settings != prevSettings)
+	{
+		m_scene.submitCommand(SceneCommands::SetTimeWarp{settings});
 	}
 }
 
@@ -196,12 +467,13 @@ void LeftPanel::updateIntermediateFrames()
 
 	constexpr float speed = 0.1f;
 	ImGui::Text("Intermediate frames");
-	ImGui::DragInt("##intermediateFrames", &intermediateFrames, speed, 2, 100, "%d",
+	ImGui::DragInt("##intermediateFrames", &intermediateFrames, speed,
+		SamplingSettings::minBudget, SamplingSettings::maxBudget, "%d",
 		ImGuiSliderFlags_AlwaysClamp);
 
 	if (intermediateFrames != prevIntermediateFrames)
 	{
-		m_scene.setIntermediateFrameCount(intermediateFrames);
+		m_scene.submitCommand(SceneCommands::SetIntermediateFrameCount{intermediateFrames});
 	}
 
 	ImGui::SameLine();
@@ -213,33 +485,571 @@ void LeftPanel::updateIntermediateFrames()
 
 	if (render != prevRender)
 	{
-		m_scene.setRenderIntermediateFrames(render);
+		m_scene.submitCommand(SceneCommands::SetRenderIntermediateFrames{render});
 	}
+
+	updateSampling();
+	updateVelocities();
+	updateMotionBlur();
+}
+
+void LeftPanel::updateVelocities()
+{
+	bool render = m_scene.getRenderVelocities();
+	bool prevRender = render;
+
+	ImGui::Checkbox("render velocities", &render);
+
+	if (render != prevRender)
+	{
+		m_scene.submitCommand(SceneCommands::SetRenderVelocities{render});
+	}
+
+	PoseVelocity left = m_scene.getMainVelocity(m_scene.getInterpolationTypeLeft(),
+		m_scene.getPositionCurveLeft());
+	PoseVelocity right = m_scene.getMainVelocity(m_scene.getInterpolationTypeRight(),
+		m_scene.getPositionCurveRight());
+	ImGui::Text("left  |v| %.2f, |w| %.2f rad/s", glm::length(left.linear),
+		glm::length(left.angular));
+	ImGui::Text("right |v| %.2f, |w| %.2f rad/s", glm::length(right.linear),
+		glm::length(right.angular));
+}
+
+void LeftPanel::updateMotionBlur()
+{
+	bool render = m_scene.getRenderMotionBlur();
+	bool prevRender = render;
+
+	ImGui::Checkbox("motion blur", &render);
+
+	if (render != prevRender)
+	{
+		m_scene.submitCommand(SceneCommands::SetRenderMotionBlur{render});
+	}
+
+	if (!render)
+	{
+		return;
+	}
+
+	MotionBlurSettings settings = m_scene.getMotionBlurSettings();
+	MotionBlurSettings prevSettings = settings;
+
+	ImGui::PushItemWidth(170);
+	ImGui::SliderFloat("shutter##motionBlur", &settings.shutter, 0.0f, 1.0f, "%.2f",
+		ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderFloat("budget##motionBlur", &settings.budgetMs, 0.5f, 33.0f, "%.1f ms",
+		ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("max K##motionBlur", &settings.maxSubFrameCount,
+		MotionBlur::minSubFrameCount, MotionBlur::subFrameCountLimit, "%d",
+		ImGuiSliderFlags_AlwaysClamp);
+	ImGui::PopItemWidth();
+
+	if (settings != prevSettings)
+	{
+		m_scene.submitCommand(SceneCommands::SetMotionBlurSettings{settings});
+	}
+
+	ImGui::Text("K = %d, frame %.2f ms", m_scene.getMotionBlurSubFrameCount(),
+		m_scene.getMotionBlurFrameMs());
+}
+
+void LeftPanel::updateSampling()
+{
+	bool adaptive = m_scene.getAdaptiveSampling();
+	bool prevAdaptive = adaptive;
+
+	ImGui::Checkbox("adaptive", &adaptive);
+
+	if (adaptive != prevAdaptive)
+	{
+		m_scene.submitCommand(SceneCommands::SetAdaptiveSampling{adaptive});
+	}
+
+	if (!adaptive)
+	{
+		return;
+	}
+
+	float angularTolerance = glm::degrees(m_scene.getAngularTolerance());
+	float prevAngularTolerance = angularTolerance;
+
+	constexpr float speedAngularTolerance = 0.1f;
+	ImGui::DragFloat("angle tol.##angularTolerance", &angularTolerance, speedAngularTolerance,
+		0.1f, 90.0f, "%.1f deg", ImGuiSliderFlags_AlwaysClamp);
+
+	if (angularTolerance != prevAngularTolerance)
+	{
+		m_scene.submitCommand(
+			SceneCommands::SetAngularTolerance{glm::radians(angularTolerance)});
+	}
+
+	float positionalTolerance = m_scene.getPositionalTolerance();
+	float prevPositionalTolerance = positionalTolerance;
+
+	constexpr float speedPositionalTolerance = 0.005f;
+	ImGui::DragFloat("pos. tol.##positionalTolerance", &positionalTolerance,
+		speedPositionalTolerance, 0.001f, 10.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+
+	if (positionalTolerance != prevPositionalTolerance)
+	{
+		m_scene.submitCommand(SceneCommands::SetPositionalTolerance{positionalTolerance});
+	}
+
+	ImGui::Text("samples: left %d, right %d",
+		m_scene.getSampleCount(m_scene.getInterpolationTypeLeft()),
+		m_scene.getSampleCount(m_scene.getInterpolationTypeRight()));
+}
+
+void LeftPanel::updateClockType()
+{
+	ImGui::Text("Clock");
+	ImGui::PushItemWidth(170);
+
+	ClockType clockType = m_scene.getClockType();
+	if (ImGui::BeginCombo("##clockType", clockTypeLabels[static_cast<int>(clockType)].c_str()))
+	{
+		for (int i = 0; i < static_cast<int>(clockTypeLabels.size()); ++i)
+		{
+			bool isSelected = i == static_cast<int>(clockType);
+			if (ImGui::Selectable(clockTypeLabels[i].c_str(), isSelected))
+			{
+				m_scene.submitCommand(SceneCommands::SetClockType{static_cast<ClockType>(i)});
+			}
+		}
+		ImGui::EndCombo();
+	}
+
+	ImGui::PopItemWidth();
 }
 
 void LeftPanel::updateButtons()
 {
 	if (ImGui::Button("Start"))
 	{
-		m_scene.startInterpolation();
+		m_scene.submitCommand(SceneCommands::StartInterpolation{});
 	}
 
 	ImGui::SameLine();
 
 	if (ImGui::Button("Stop"))
 	{
-		m_scene.stopInterpolation();
+		m_scene.submitCommand(SceneCommands::StopInterpolation{});
 	}
 
 	ImGui::SameLine();
 
 	if (ImGui::Button("Reset"))
 	{
-		m_scene.resetInterpolation();
+		m_scene.submitCommand(SceneCommands::ResetInterpolation{});
 	}
 }
 
 void LeftPanel::updateTime()
 {
-	ImGui::Text("t = %.2f s", m_scene.getTime());
+	float time = m_scene.getTime();
+	float prevTime = time;
+
+	ImGui::PushItemWidth(170);
+	ImGui::SliderFloat("##time", &time, 0.0f, m_scene.getAnimationTime(), "t = %.2f s",
+		ImGuiSliderFlags_AlwaysClamp);
+	ImGui::PopItemWidth();
+
+	if (time != prevTime)
+	{
+		m_scene.submitCommand(SceneCommands::SetTime{time});
+	}
+}
+
+void LeftPanel::updatePoseCache()
+{
+	bool useBakedCache = m_scene.getUseBakedCache();
+	bool prevUseBakedCache = useBakedCache;
+
+	ImGui::Checkbox("play from cache", &useBakedCache);
+
+	if (useBakedCache != prevUseBakedCache)
+	{
+		m_scene.submitCommand(SceneCommands::SetUseBakedCache{useBakedCache});
+	}
+
+	PoseCacheInfo info = m_scene.getPoseCacheInfo();
+	ImGui::Text("%s, version %llu", info.valid ? "valid" : "stale",
+		static_cast<unsigned long long>(info.version));
+	ImGui::Text("%zu samples @ %d Hz, %.1f KiB", info.sampleCount, PoseCache::samplesPerSecond,
+		info.byteSize / 1024.0f);
+}
+
+void LeftPanel::updateClip()
+{
+	ImGui::PushItemWidth(170);
+	ImGui::InputText("##clipPath", m_clipPath.data(), m_clipPath.size());
+	ImGui::PopItemWidth();
+
+	if (ImGui::Button("Load"))
+	{
+		m_scene.submitCommand(SceneCommands::LoadClip{m_clipPath.data()});
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Close"))
+	{
+		m_scene.submitCommand(SceneCommands::CloseClip{});
+	}
+
+	MotionClipInfo info = m_scene.getClipInfo();
+	if (!info.open)
+	{
+		ImGui::Text("no clip");
+		return;
+	}
+
+	ImGui::Text("%zu samples, %.2f s%s", info.sampleCount, info.duration,
+		info.hasEulerAngles ? ", Euler" : "");
+	ImGui::Text("%.1f MiB mapped in %.3f ms", info.byteSize / (1024.0f * 1024.0f), info.openMs);
+	if (ImGui::Button("Use clip endpoints"))
+	{
+		m_scene.submitCommand(SceneCommands::ApplyClipEndpoints{});
+	}
+
+	ImGui::Spacing();
+	updateClipPlayback();
+	ImGui::Spacing();
+	updateClipCompression();
+	ImGui::Spacing();
+	updateClipReduction();
+}
+
+void LeftPanel::updateClipPlayback()
+{
+	ImGui::Text("Playback");
+	ImGui::PushItemWidth(170);
+
+	ClipPlayback clipPlayback = m_scene.getClipPlayback();
+	if (ImGui::BeginCombo("##clipPlayback",
+		clipPlaybackLabels[static_cast<int>(clipPlayback)].c_str()))
+	{
+		for (int i = 0; i < clipPlaybackCount; ++i)
+		{
+			bool isSelected = i == static_cast<int>(clipPlayback);
+			if (ImGui::Selectable(clipPlaybackLabels[i].c_str(), isSelected))
+			{
+				m_scene.submitCommand(
+					SceneCommands::SetClipPlayback{static_cast<ClipPlayback>(i)});
+			}
+		}
+		ImGui::EndCombo();
+	}
+
+	ImGui::PopItemWidth();
+}
+
+void LeftPanel::updateClipCompression()
+{
+	ImGui::SliderInt("rot. bits##rotationBits", &m_compressionSettings.rotationBits, 4,
+		CompressedTrack::maxBits);
+	ImGui::SliderInt("pos. bits##positionBits", &m_compressionSettings.positionBits, 4,
+		CompressedTrack::maxBits);
+	if (ImGui::Button("Compress"))
+	{
+		m_scene.submitCommand(SceneCommands::CompressClip{m_compressionSettings});
+	}
+
+	const CompressionStats* stats = m_scene.getClipCompressionStats();
+	if (stats == nullptr)
+	{
+		return;
+	}
+
+	ImGui::Text("%.1f KiB -> %.1f KiB (%.2fx)", stats->rawByteSize / 1024.0f,
+		stats->compressedByteSize / 1024.0f, stats->ratio);
+	ImGui::Text("max error %.4f deg, %.5f", glm::degrees(stats->maxAngularError),
+		stats->maxPositionError);
+	ImGui::Text("decode %.1f Msamples/s", stats->decodeSamplesPerSecond / 1e6);
+}
+
+void LeftPanel::updateClipReduction()
+{
+	ImGui::PushItemWidth(170);
+	if (ImGui::BeginCombo("##reductionType",
+		interpolationTypeLabels[static_cast<int>(m_reductionType)].c_str()))
+	{
+		for (int i = 0; i < interpolationTypeCount; ++i)
+		{
+			bool isSelected = i == static_cast<int>(m_reductionType);
+			if (ImGui::Selectable(interpolationTypeLabels[i].c_str(), isSelected))
+			{
+				m_reductionType = static_cast<InterpolationType>(i);
+			}
+		}
+		ImGui::EndCombo();
+	}
+	ImGui::PopItemWidth();
+
+	float angularTolerance = glm::degrees(m_reductionTolerances.angular);
+	constexpr float speedAngularTolerance = 0.01f;
+	ImGui::DragFloat("angle tol.##reductionAngularTolerance", &angularTolerance,
+		speedAngularTolerance, 0.001f, 10.0f, "%.3f deg", ImGuiSliderFlags_AlwaysClamp);
+	m_reductionTolerances.angular = glm::radians(angularTolerance);
+
+	constexpr float speedPositionalTolerance = 0.0005f;
+	ImGui::DragFloat("pos. tol.##reductionPositionalTolerance",
+		&m_reductionTolerances.positional, speedPositionalTolerance, 0.0001f, 1.0f, "%.4f",
+		ImGuiSliderFlags_AlwaysClamp);
+
+	if (ImGui::Button("Reduce keys"))
+	{
+		m_scene.submitCommand(SceneCommands::ReduceClip{m_reductionType, m_reductionTolerances});
+	}
+
+	const ReductionStats* stats = m_scene.getClipReductionStats();
+	if (stats == nullptr)
+	{
+		return;
+	}
+
+	ImGui::Text("%zu -> %zu keys (%.1f%%)", stats->sourceKeyCount, stats->keyCount,
+		100.0f * stats->keyCount / std::max<std::size_t>(stats->sourceKeyCount, 1));
+	ImGui::Text("max error %.4f deg, %.5f", glm::degrees(stats->maxAngularError),
+		stats->maxPositionalError);
+	ImGui::Text("reduced in %.1f ms", stats->seconds * 1000);
+}
+
+void LeftPanel::updateSkeletons()
+{
+	ImGui::PushItemWidth(170);
+	ImGui::InputText("BVH##skeletonPaths", m_skeletonPaths.data(), m_skeletonPaths.size());
+	ImGui::PopItemWidth();
+
+	if (ImGui::Button("Load##skeletons"))
+	{
+		std::vector<std::string> paths{};
+		std::string_view pathList{m_skeletonPaths.data()};
+		while (!pathList.empty())
+		{
+			std::size_t separator = std::min(pathList.find(';'), pathList.size());
+			if (separator > 0)
+			{
+				paths.emplace_back(pathList.substr(0, separator));
+			}
+			pathList.remove_prefix(std::min(separator + 1, pathList.size()));
+		}
+		m_scene.submitCommand(SceneCommands::LoadSkeletons{std::move(paths)});
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Clear##skeletons"))
+	{
+		m_scene.submitCommand(SceneCommands::ClearSkeletons{});
+	}
+	if (m_scene.isLoadingSkeletons())
+	{
+		ImGui::SameLine();
+		ImGui::Text("loading...");
+	}
+
+	const std::vector<SkeletalMotionInfo>& infos = m_scene.getSkeletonInfos();
+	if (infos.empty())
+	{
+		ImGui::Text("no skeletons");
+		return;
+	}
+
+	for (const SkeletalMotionInfo& info : infos)
+	{
+		ImGui::Text("%s", info.name.c_str());
+		ImGui::Text("%zu joints, %zu frames, %.2f s", info.jointCount, info.frameCount,
+			info.duration);
+		ImGui::Text("loaded in %.1f ms", info.loadMs);
+	}
+}
+
+void LeftPanel::updateBlend()
+{
+	bool blend = m_scene.getBlendSkeletons();
+	if (ImGui::Checkbox("blend skeletons", &blend))
+	{
+		m_scene.submitCommand(SceneCommands::SetBlendSkeletons{blend});
+	}
+	if (!m_scene.canBlendSkeletons())
+	{
+		ImGui::Text("needs 2+ matching skeletons");
+		return;
+	}
+
+	ImGui::Text("Left pane");
+	updateBlendMethod(m_scene.getBlendMethodLeft(),
+		[this] (BlendMethod method)
+		{
+			m_scene.submitCommand(SceneCommands::SetBlendMethodLeft{method});
+		},
+		"##blendMethodLeft");
+	ImGui::Text("Right pane");
+	updateBlendMethod(m_scene.getBlendMethodRight(),
+		[this] (BlendMethod method)
+		{
+			m_scene.submitCommand(SceneCommands::SetBlendMethodRight{method});
+		},
+		"##blendMethodRight");
+
+	const std::vector<SkeletalMotionInfo>& infos = m_scene.getSkeletonInfos();
+	constexpr float speedWeight = 0.01f;
+	for (std::size_t i = 0; i < infos.size(); ++i)
+	{
+		int index = static_cast<int>(i);
+		BlendLayer layer = m_scene.getBlendLayer(index);
+		std::array<float, 2> weights{layer.startWeight, layer.endWeight};
+		ImGui::Text("%s", infos[i].name.c_str());
+		ImGui::PushID(index);
+		if (ImGui::DragFloat2("weights##blendLayer", weights.data(), speedWeight, 0.0f, 10.0f,
+			"%.2f", ImGuiSliderFlags_AlwaysClamp))
+		{
+			m_scene.submitCommand(
+				SceneCommands::SetBlendLayer{index, BlendLayer{weights[0], weights[1]}});
+		}
+		ImGui::PopID();
+	}
+}
+
+void LeftPanel::updateBlendMethod(BlendMethod blendMethod,
+	const std::function<void(BlendMethod)>& setter, const char* suffix)
+{
+	ImGui::PushItemWidth(170);
+	if (ImGui::BeginCombo(suffix,
+		blendMethodLabels[static_cast<int>(blendMethod)].c_str()))
+	{
+		for (int i = 0; i < blendMethodCount; ++i)
+		{
+			bool isSelected = i == static_cast<int>(blendMethod);
+			if (ImGui::Selectable(blendMethodLabels[i].c_str(), isSelected))
+			{
+				setter(static_cast<BlendMethod>(i));
+			}
+		}
+		ImGui::EndCombo();
+	}
+	ImGui::PopItemWidth();
+}
+
+void LeftPanel::updateDivergenceMetrics()
+{
+	const DivergenceMetrics& metrics = m_scene.getDivergenceMetrics();
+	if (metrics.sampleCount == 0)
+	{
+		ImGui::Text("waiting for samples");
+		return;
+	}
+
+	for (const PairDivergence& pair : metrics.pairs)
+	{
+		ImGui::Text("%s / %s", interpolationTypeLabels[static_cast<int>(pair.first)].c_str(),
+			interpolationTypeLabels[static_cast<int>(pair.second)].c_str());
+		ImGui::Text("  max %.2f deg @ %.2f s, mean %.2f deg", glm::degrees(pair.maxAngle),
+			pair.peakTime, glm::degrees(pair.meanAngle));
+	}
+
+	ImGui::Spacing();
+	ImGui::Text("Angular velocity");
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		const AngularVelocityStats& stats = metrics.angularVelocities[type];
+		ImGui::Text("%s", interpolationTypeLabels[type].c_str());
+		ImGui::Text("  mean %.1f deg/s, max %.1f, CV %.3f", glm::degrees(stats.mean),
+			glm::degrees(stats.max), stats.nonUniformity);
+	}
+
+	ImGui::Text("%zu samples, recomputed %llu, reused %llu", metrics.sampleCount,
+		static_cast<unsigned long long>(metrics.recomputeCount),
+		static_cast<unsigned long long>(metrics.reuseCount));
+}
+
+void LeftPanel::updateCommandStats()
+{
+	SceneCommandStats stats = m_scene.getCommandStats();
+	ImGui::Text("batch: %zu, max depth: %zu", stats.lastBatchSize, stats.maxDepth);
+	ImGui::Text("applied: %llu, rejected: %llu",
+		static_cast<unsigned long long>(stats.appliedCount),
+		static_cast<unsigned long long>(stats.rejectedCount));
+	ImGui::Text("latency: %.3f ms (avg %.3f, max %.3f)", stats.lastMaxLatencyMs,
+		stats.averageLatencyMs, stats.maxLatencyMs);
+}
+
+void LeftPanel::updateRenderStats()
+{
+	const RenderStats& stats = m_scene.getRenderStats();
+	ImGui::Text("commands: %zu, draw calls: %zu", stats.commandCount, stats.drawCallCount);
+	ImGui::Text("state changes: %zu, elided: %zu", stats.getStateChangeCount(),
+		stats.elidedChangeCount);
+	ImGui::Text("programs: %zu, VAOs: %zu, textures: %zu", stats.programChangeCount,
+		stats.vertexArrayChangeCount, stats.textureChangeCount);
+	ImGui::Text("line widths: %zu, depth writes: %zu", stats.lineWidthChangeCount,
+		stats.depthWriteChangeCount);
+	ImGui::Text("camera uploads: %zu", stats.cameraUploadCount);
+}
+
+void LeftPanel::updateAllocations()
+{
+	if (!AllocationTracker::isEnabled())
+	{
+		ImGui::TextWrapped("disabled, build with MOTION_INTERPOLATION_TRACK_ALLOCATIONS");
+		return;
+	}
+
+	const AllocationStats& stats = AllocationTracker::getStats();
+	const AllocationFrameStats& frame = stats.lastFrame;
+	ImGui::Text("last frame: %llu allocs, %llu B",
+		static_cast<unsigned long long>(frame.total.allocationCount),
+		static_cast<unsigned long long>(frame.total.allocatedBytes));
+	ImGui::Text("peak frame: %llu allocs, %llu B",
+		static_cast<unsigned long long>(stats.peakFrame.total.allocationCount),
+		static_cast<unsigned long long>(stats.peakFrame.total.allocatedBytes));
+	for (int zone = 0; zone < allocationZoneCount; ++zone)
+	{
+		ImGui::Text("%-13s %4llu allocs, %8.1f KiB live", allocationZoneLabels[zone].c_str(),
+			static_cast<unsigned long long>(frame.zones[zone].allocationCount),
+			stats.liveBytes[zone] / 1024.0);
+	}
+
+	ImGui::Text("steady-state frames: %llu",
+		static_cast<unsigned long long>(stats.steadyStateFrameCount));
+	ImVec4 violationColor = stats.steadyStateViolationCount > 0 ?
+		ImVec4{1.0f, 0.4f, 0.4f, 1.0f} : ImVec4{0.4f, 1.0f, 0.4f, 1.0f};
+	ImGui::TextColored(violationColor, "steady-state frames allocating: %llu",
+		static_cast<unsigned long long>(stats.steadyStateViolationCount));
+
+	bool report = AllocationTracker::getReportSteadyStateViolations();
+	if (ImGui::Checkbox("report##reportSteadyStateViolations", &report))
+	{
+		AllocationTracker::setReportSteadyStateViolations(report);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Reset##allocationStats"))
+	{
+		AllocationTracker::resetStats();
+	}
+}
+
+void LeftPanel::updateMemoryUsages()
+{
+	m_scene.getMemoryUsages(m_memoryUsages);
+	ImGui::Text("CPU containers");
+	for (const MemoryUsage& usage : m_memoryUsages)
+	{
+		ImGui::Text("%-21s %9.1f KiB", usage.name, usage.byteSize / 1024.0);
+	}
+
+	ImGui::Spacing();
+	ImGui::Text("GL resources");
+	for (int type = 0; type < glResourceTypeCount; ++type)
+	{
+		GLResourceUsage usage = GLResourceTracker::getUsage(static_cast<GLResourceType>(type));
+		if (usage.byteSize > 0)
+		{
+			ImGui::Text("%-14s %3lld, %9.1f KiB", glResourceTypeLabels[type].c_str(),
+				static_cast<long long>(usage.count), usage.byteSize / 1024.0);
+		}
+		else
+		{
+			ImGui::Text("%-14s %3lld", glResourceTypeLabels[type].c_str(),
+				static_cast<long long>(usage.count));
+		}
+	}
 }
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "blend/blendMethod.hpp"
+#include "clip/compressedTrack.hpp"
+#include "clip/keyframeReduction.hpp"
+#include "interpolationType.hpp"
+#include "memory/memoryUsage.hpp"
 #include "scene.hpp"
 
 #include <glm/glm.hpp>
 
+#include <array>
 #include <functional>
-#include <string>
+#include <vector>
 
 class LeftPanel
 {
@@ -18,19 +24,49 @@ public:
 private:
 	Scene& m_scene;
 	const glm::ivec2& m_viewportSize;
+	std::array<char, 260> m_clipPath{};
+	CompressionSettings m_compressionSettings{};
+	InterpolationType m_reductionType = InterpolationType::quatSlerp;
+	ReductionTolerances m_reductionTolerances{};
+	std::array<char, 1024> m_skeletonPaths{};
+	std::vector<MemoryUsage> m_memoryUsages{};
 
 	void updateCamera();
 	void updateInterpolationType(const std::function<InterpolationType(void)>& getter,
-		const std::function<void(InterpolationType)>& setter, const std::string& suffix);
+		const std::function<void(InterpolationType)>& setter, const char* suffix);
+	void updatePositionCurve(const std::function<PositionCurveType(void)>& getter,
+		const std::function<void(PositionCurveType)>& setter, InterpolationType interpolationType,
+		const char* suffix);
 	void updatePosAndOrientation(const std::function<glm::vec3(void)>& posGetter,
 		const std::function<void(const glm::vec3&)>& posSetter,
 		const std::function<glm::vec3(void)>& eulerAnglesGetter,
 		const std::function<void(const glm::vec3&)>& eulerAnglesSetter,
 		const std::function<glm::vec4(void)>& quatGetter,
 		const std::function<void(const glm::vec4&)>& quatSetter,
-		const std::function<void(void)>& normalizeQuat, const std::string& suffix);
+		const std::function<void(void)>& normalizeQuat, const char* id);
+	void updatePosKeys();
+	void updatePosKey(int index);
 	void updateAnimationTime();
+	void updateTimeWarp();
 	void updateIntermediateFrames();
+	void updateSampling();
+	void updateVelocities();
+	void updateMotionBlur();
+	void updateClockType();
 	void updateButtons();
 	void updateTime();
+	void updatePoseCache();
+	void updateClip();
+	void updateClipPlayback();
+	void updateClipCompression();
+	void updateClipReduction();
+	void updateSkeletons();
+	void updateBlend();
+	void updateBlendMethod(BlendMethod blendMethod,
+		const std::function<void(BlendMethod)>& setter, const char* suffix);
+	void updateDivergenceMetrics();
+	void updateCommandStats();
+	void updateRenderStats();
+	void updateAllocations();
+	void updateMemoryUsages();
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class IkMethod
+{
+	fabrik,
+	ccd
+};
+
+inline constexpr int ikMethodCount = 2;
+
+inline const std::array<std::string, ikMethodCount> ikMethodLabels
+{
+	"FABRIK",
+	"CCD"
+};
@@ -0,0 +1,314 @@
+#include "ik/ikSolver.hpp"
+
+#include "concurrency/parallelFor.hpp"
+#include "frame.hpp"
+#include "interpolator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static constexpr float minLength = 1e-8f;
+static constexpr float antiparallelDot = -1 + 1e-6f;
+
+struct IkScratch
+{
+	std::vector<glm::vec3> positions{};
+	std::vector<glm::vec4> worldQuats{};
+	std::vector<float> lengths{};
+};
+
+static glm::vec4 conjugate(const glm::vec4& quat)
+{
+	return {-glm::vec3{quat}, quat.w};
+}
+
+static glm::vec3 rotate(const glm::vec4& quat, const glm::vec3& vec)
+{
+	glm::vec3 axis{quat};
+	glm::vec3 t = 2.0f * glm::cross(axis, vec);
+	return vec + quat.w * t + glm::cross(axis, t);
+}
+
+static glm::vec4 rotationBetween(const glm::vec3& from, const glm::vec3& to)
+{
+	float fromLength = glm::length(from);
+	float toLength = glm::length(to);
+	if (fromLength < minLength || toLength < minLength)
+	{
+		return {0, 0, 0, 1};
+	}
+
+	glm::vec3 fromDir = from / fromLength;
+	glm::vec3 toDir = to / toLength;
+	float dot = glm::dot(fromDir, toDir);
+	if (dot < antiparallelDot)
+	{
+		glm::vec3 other = std::abs(fromDir.x) < 0.9f ? glm::vec3{1, 0, 0} : glm::vec3{0, 1, 0};
+		return {glm::normalize(glm::cross(fromDir, other)), 0};
+	}
+	return glm::normalize(glm::vec4{glm::cross(fromDir, toDir), 1 + dot});
+}
+
+static void forwardKinematics(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+	const glm::vec3* bones, const glm::vec4* quats, std::size_t count, IkScratch& scratch)
+{
+	scratch.positions.resize(count + 1);
+	scratch.worldQuats.resize(count);
+	scratch.positions[0] = rootPos;
+	glm::vec4 parentQuat = rootParentQuat;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		scratch.worldQuats[i] = Interpolator::quatProduct(parentQuat, quats[i]);
+		scratch.positions[i + 1] = scratch.positions[i] + rotate(scratch.worldQuats[i], bones[i]);
+		parentQuat = scratch.worldQuats[i];
+	}
+}
+
+static glm::vec3 pullTowards(const glm::vec3& from, const glm::vec3& towards,
+	const glm::vec3& fallback, float length)
+{
+	glm::vec3 direction = towards - from;
+	float directionLength = glm::length(direction);
+	return from + (directionLength < minLength ? fallback : direction / directionLength) * length;
+}
+
+static int solveFabrik(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+	const glm::vec3* bones, glm::vec4* quats, std::size_t count, const glm::vec3& target,
+	const IkBudget& budget, IkScratch& scratch)
+{
+	forwardKinematics(rootPos, rootParentQuat, bones, quats, count, scratch);
+	std::vector<glm::vec3>& positions = scratch.positions;
+	if (glm::length(positions[count] - target) <= budget.tolerance)
+	{
+		return 0;
+	}
+
+	scratch.lengths.resize(count);
+	float totalLength = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		scratch.lengths[i] = glm::length(bones[i]);
+		totalLength += scratch.lengths[i];
+	}
+
+	int iterations = 0;
+	glm::vec3 up{0, 1, 0};
+	if (glm::length(target - rootPos) >= totalLength)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			positions[i + 1] = pullTowards(positions[i], target, up, scratch.lengths[i]);
+		}
+		iterations = 1;
+	}
+	else
+	{
+		while (iterations < budget.maxIterations &&
+			glm::length(positions[count] - target) > budget.tolerance)
+		{
+			positions[count] = target;
+			for (std::size_t i = count; i-- > 0;)
+			{
+				positions[i] = pullTowards(positions[i + 1], positions[i], -up,
+					scratch.lengths[i]);
+			}
+			positions[0] = rootPos;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				positions[i + 1] = pullTowards(positions[i], positions[i + 1], up,
+					scratch.lengths[i]);
+			}
+			++iterations;
+		}
+	}
+
+	glm::vec4 parentQuat = rootParentQuat;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		glm::vec4 worldQuat = Interpolator::quatProduct(parentQuat, quats[i]);
+		glm::vec4 delta = rotationBetween(rotate(worldQuat, bones[i]),
+			positions[i + 1] - positions[i]);
+		worldQuat = glm::normalize(Interpolator::quatProduct(delta, worldQuat));
+		quats[i] = glm::normalize(Interpolator::quatProduct(conjugate(parentQuat), worldQuat));
+		parentQuat = worldQuat;
+	}
+	return iterations;
+}
+
+static int solveCcd(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+	const glm::vec3* bones, glm::vec4* quats, std::size_t count, const glm::vec3& target,
+	const IkBudget& budget, IkScratch& scratch)
+{
+	int iterations = 0;
+	while (iterations < budget.maxIterations)
+	{
+		forwardKinematics(rootPos, rootParentQuat, bones, quats, count, scratch);
+		glm::vec3 endEffector = scratch.positions[count];
+		if (glm::length(endEffector - target) <= budget.tolerance)
+		{
+			break;
+		}
+
+		for (std::size_t i = count; i-- > 0;)
+		{
+			const glm::vec3& jointPos = scratch.positions[i];
+			glm::vec4 parentQuat = i == 0 ? rootParentQuat : scratch.worldQuats[i - 1];
+			glm::vec4 delta = rotationBetween(endEffector - jointPos, target - jointPos);
+			glm::vec4 worldQuat =
+				glm::normalize(Interpolator::quatProduct(delta, scratch.worldQuats[i]));
+			quats[i] = glm::normalize(Interpolator::quatProduct(conjugate(parentQuat), worldQuat));
+			endEffector = jointPos + rotate(delta, endEffector - jointPos);
+		}
+		++iterations;
+	}
+	return iterations;
+}
+
+static IkResult solveSingleChain(IkMethod method, const glm::vec3& rootPos,
+	const glm::vec4& rootParentQuat, const glm::vec3* bones, glm::vec4* quats,
+	std::size_t count, const glm::vec3& target, const IkBudget& budget, IkScratch& scratch)
+{
+	IkResult result{};
+	result.iterations = method == IkMethod::fabrik ?
+		solveFabrik(rootPos, rootParentQuat, bones, quats, count, target, budget, scratch) :
+		solveCcd(rootPos, rootParentQuat, bones, quats, count, target, budget, scratch);
+	result.error = glm::length(
+		IkSolver::endEffector(rootPos, rootParentQuat, bones, quats, count) - target);
+	result.converged = result.error <= budget.tolerance;
+	return result;
+}
+
+std::size_t IkChainBatch::getChainCount() const
+{
+	return targets.size();
+}
+
+std::size_t IkChainBatch::addChain(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+	std::span<const glm::vec3> chainBones, std::span<const glm::vec4> chainQuats,
+	const glm::vec3& target)
+{
+	std::size_t count = std::min(chainBones.size(), chainQuats.size());
+	bones.insert(bones.end(), chainBones.begin(), chainBones.begin() + count);
+	quats.insert(quats.end(), chainQuats.begin(), chainQuats.begin() + count);
+	chainOffsets.push_back(bones.size());
+	rootPositions.push_back(rootPos);
+	rootParentQuats.push_back(rootParentQuat);
+	targets.push_back(target);
+	return targets.size() - 1;
+}
+
+namespace IkSolver
+{
+	glm::vec3 endEffector(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+		const glm::vec3* bones, const glm::vec4* quats, std::size_t count)
+	{
+		glm::vec3 pos = rootPos;
+		glm::vec4 worldQuat = rootParentQuat;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			worldQuat = Interpolator::quatProduct(worldQuat, quats[i]);
+			pos += rotate(worldQuat, bones[i]);
+		}
+		return pos;
+	}
+
+	IkResult solveChain(IkMethod method, const glm::vec3& rootPos,
+		const glm::vec4& rootParentQuat, const glm::vec3* bones, glm::vec4* quats,
+		std::size_t count, const glm::vec3& target, const IkBudget& budget)
+	{
+		IkScratch scratch{};
+		return solveSingleChain(method, rootPos, rootParentQuat, bones, quats, count, target,
+			budget, scratch);
+	}
+
+	IkStats solve(IkMethod method, IkChainBatch& batch, const IkBudget& budget,
+		std::vector<IkResult>* results)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		std::size_t chainCount = batch.getChainCount();
+		std::vector<IkResult> chainResults(chainCount);
+		parallelFor(chainCount, chainGrainSize,
+			[&] (std::size_t begin, std::size_t end)
+			{
+				IkScratch scratch{};
+				for (std::size_t chain = begin; chain < end; ++chain)
+				{
+					std::size_t offset = batch.chainOffsets[chain];
+					chainResults[chain] = solveSingleChain(method, batch.rootPositions[chain],
+						batch.rootParentQuats[chain], batch.bones.data() + offset,
+						batch.quats.data() + offset, batch.chainOffsets[chain + 1] - offset,
+						batch.targets[chain], budget, scratch);
+				}
+			});
+
+		IkStats stats{};
+		stats.chainCount = chainCount;
+		for (const IkResult& result : chainResults)
+		{
+			stats.convergedCount += result.converged ? 1 : 0;
+			stats.iterationCount += static_cast<std::size_t>(result.iterations);
+			stats.maxError = std::max(stats.maxError, result.error);
+		}
+		stats.seconds =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stats.microsecondsPerChain = chainCount > 0 ? 1e6 * stats.seconds / chainCount : 0;
+
+		if (results != nullptr)
+		{
+			*results = std::move(chainResults);
+		}
+		return stats;
+	}
+
+	std::vector<std::size_t> chainJoints(const TransformHierarchy& hierarchy,
+		std::size_t endJoint, std::size_t length)
+	{
+		std::vector<std::size_t> joints{endJoint};
+		while (joints.size() <= length && hierarchy.getParent(joints.back()) >= 0)
+		{
+			joints.push_back(static_cast<std::size_t>(hierarchy.getParent(joints.back())));
+		}
+		std::reverse(joints.begin(), joints.end());
+		return joints;
+	}
+
+	std::size_t addChain(IkChainBatch& batch, const TransformHierarchy& hierarchy,
+		std::span<const std::size_t> joints, const glm::vec3& target)
+	{
+		std::vector<glm::vec3> bones{};
+		std::vector<glm::vec4> quats{};
+		for (std::size_t i = 0; i + 1 < joints.size(); ++i)
+		{
+			bones.push_back(hierarchy.getLocalPosition(joints[i + 1]));
+			quats.push_back(hierarchy.getLocalQuat(joints[i]));
+		}
+
+		glm::vec3 rootPos{};
+		glm::vec4 rootParentQuat{0, 0, 0, 1};
+		if (!joints.empty())
+		{
+			rootPos = hierarchy.getWorldMatrix(joints.front())[3];
+			int parent = hierarchy.getParent(joints.front());
+			if (parent >= 0)
+			{
+				rootParentQuat = Frame::rotationMatrixToQuat(
+					hierarchy.getWorldMatrix(static_cast<std::size_t>(parent)));
+			}
+		}
+		return batch.addChain(rootPos, rootParentQuat, bones, quats, target);
+	}
+
+	void applyChain(const IkChainBatch& batch, std::size_t chain, TransformHierarchy& hierarchy,
+		std::span<const std::size_t> joints)
+	{
+		std::size_t offset = batch.chainOffsets[chain];
+		std::size_t count = batch.chainOffsets[chain + 1] - offset;
+		for (std::size_t i = 0; i < count && i < joints.size(); ++i)
+		{
+			hierarchy.setLocalTransform(joints[i], hierarchy.getLocalPosition(joints[i]),
+				batch.quats[offset + i]);
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ik/ikMethod.hpp"
+#include "skeleton/transformHierarchy.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+struct IkBudget
+{
+	int maxIterations = 16;
+	float tolerance = 1e-3f;
+};
+
+struct IkResult
+{
+	int iterations{};
+	float error{};
+	bool converged{};
+};
+
+struct IkStats
+{
+	std::size_t chainCount{};
+	std::size_t convergedCount{};
+	std::size_t iterationCount{};
+	float maxError{};
+	double seconds{};
+	double microsecondsPerChain{};
+};
+
+struct IkChainBatch
+{
+	std::vector<std::size_t> chainOffsets{0};
+	std::vector<glm::vec3> bones{};
+	std::vector<glm::vec4> quats{};
+	std::vector<glm::vec3> rootPositions{};
+	std::vector<glm::vec4> rootParentQuats{};
+	std::vector<glm::vec3> targets{};
+
+	std::size_t getChainCount() const;
+	std::size_t addChain(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+		std::span<const glm::vec3> chainBones, std::span<const glm::vec4> chainQuats,
+		const glm::vec3& target);
+};
+
+namespace IkSolver
+{
+	inline constexpr std::size_t chainGrainSize = 64;
+
+	glm::vec3 endEffector(const glm::vec3& rootPos, const glm::vec4& rootParentQuat,
+		const glm::vec3* bones, const glm::vec4* quats, std::size_t count);
+	IkResult solveChain(IkMethod method, const glm::vec3& rootPos,
+		const glm::vec4& rootParentQuat, const glm::vec3* bones, glm::vec4* quats,
+		std::size_t count, const glm::vec3& target, const IkBudget& budget);
+	IkStats solve(IkMethod method, IkChainBatch& batch, const IkBudget& budget,
+		std::vector<IkResult>* results = nullptr);
+
+	std::vector<std::size_t> chainJoints(const TransformHierarchy& hierarchy,
+		std::size_t endJoint, std::size_t length);
+	std::size_t addChain(IkChainBatch& batch, const TransformHierarchy& hierarchy,
+		std::span<const std::size_t> joints, const glm::vec3& target);
+	void applyChain(const IkChainBatch& batch, std::size_t chain, TransformHierarchy& hierarchy,
+		std::span<const std::size_t> joints);
+}
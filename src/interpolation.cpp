@@ -1,270 +1,390 @@
 #include "interpolation.hpp"
 
-#include <glm/gtc/constants.hpp>
+#include "clock/fixedStepClock.hpp"
+#include "clock/realTimeClock.hpp"
+#include "clock/scrubbedClock.hpp"
 
 #include <algorithm>
-#include <cmath>
 #include <cstddef>
 
-Interpolation::Interpolation(Frame& eulerFrame, std::vector<Frame>& eulerFrames,
-	Frame& quatLinearFrame, std::vector<Frame>& quatLinearFrames,
-	Frame& quatSlerpFrame, std::vector<Frame>& quatSlerpFrames) :
-	m_eulerFrame{eulerFrame},
-	m_eulerFrames{eulerFrames},
-	m_quatLinearFrame{quatLinearFrame},
-	m_quatLinearFrames{quatLinearFrames},
-	m_quatSlerpFrame{quatSlerpFrame},
-	m_quatSlerpFrames{quatSlerpFrames}
+static constexpr int fixedStepsPerSecond = 240;
+
+Interpolation::Interpolation(InterpolationFramesArray& frames,
+	MainPositionsArray& mainPositions) :
+	m_frames{frames},
+	m_mainPositions{mainPositions},
+	m_clock{createClock(m_clockType)}
 { }
 
 void Interpolation::start()
 {
-	if (m_running)
+	if (m_clock->isRunning())
 	{
 		return;
 	}
 
-	m_startTime = now() - std::chrono::duration<float>(m_currTime);
-	m_running = true;
+	m_clock->start();
 }
 
 void Interpolation::stop()
 {
-	m_running = false;
+	m_clock->stop();
+}
+
+bool Interpolation::isRunning() const
+{
+	return m_clock->isRunning();
 }
 
 void Interpolation::reset()
 {
 	stop();
-	m_currTime = 0;
-	updateFrames();
+	m_clock->setTicks(0);
+	updateMainFrames();
 }
 
-void Interpolation::update()
+void Interpolation::update(std::optional<Clock::Ticks> lockedTicks)
 {
-	if (!m_running)
+	updateIntermediateFrames();
+
+	if (!m_clock->isRunning())
 	{
 		return;
 	}
 
-	m_currTime =
-		std::chrono::duration_cast<std::chrono::duration<float>>(now() - m_startTime).count();
-	if (m_currTime >= m_endTime)
+	if (lockedTicks.has_value())
 	{
-		m_currTime = m_endTime;
-		m_running = false;
+		m_clock->setTicks(*lockedTicks);
 	}
-	updateFrames();
+	else
+	{
+		m_clock->update();
+	}
+	Clock::Ticks endTicks = Clock::secondsToTicks(getEndTime());
+	if (m_clock->getTicks() >= endTicks)
+	{
+		m_clock->setTicks(endTicks);
+		m_clock->stop();
+	}
+	updateMainFrames();
 }
 
 void Interpolation::updateFrames()
 {
-	m_eulerFrame.setPos(interpolatePos(m_currTime));
-	m_eulerFrame.setEulerAngles(interpolateEulerAngles(m_currTime));
+	updateMainFrames();
+	m_version = m_poseWorker.submit(m_interpolator, m_samplingSettings);
+}
 
-	m_quatLinearFrame.setPos(interpolatePos(m_currTime));
-	m_quatLinearFrame.setQuat(interpolateQuatLinear(m_currTime));
+Clock::Ticks Interpolation::getTicks() const
+{
+	return m_clock->getTicks();
+}
 
-	m_quatSlerpFrame.setPos(interpolatePos(m_currTime));
-	m_quatSlerpFrame.setQuat(interpolateQuatSlerp(m_currTime));
+float Interpolation::getTime() const
+{
+	return Clock::ticksToSeconds(m_clock->getTicks());
+}
 
-	std::size_t intermediateFrameCount = m_eulerFrames.size();
-	float dTime = m_endTime / (intermediateFrameCount - 1);
-	for (int i = 0; i < intermediateFrameCount; ++i)
-	{
-		float time = i * dTime;
+void Interpolation::setTime(float time)
+{
+	m_clock->setTicks(std::clamp(Clock::secondsToTicks(time), Clock::Ticks{0},
+		Clock::secondsToTicks(getEndTime())));
+	updateMainFrames();
+}
 
-		m_eulerFrames[i].setPos(interpolatePos(time));
-		m_eulerFrames[i].setEulerAngles(interpolateEulerAngles(time));
+float Interpolation::getEndTime() const
+{
+	return m_interpolator.getEndTime();
+}
 
-		m_quatLinearFrames[i].setPos(interpolatePos(time));
-		m_quatLinearFrames[i].setQuat(interpolateQuatLinear(time));
+void Interpolation::setEndTime(float time)
+{
+	m_interpolator.setEndTime(time);
+	m_clock->setTicks(std::min(m_clock->getTicks(), Clock::secondsToTicks(time)));
+	updateFrames();
+}
 
-		m_quatSlerpFrames[i].setPos(interpolatePos(time));
-		m_quatSlerpFrames[i].setQuat(interpolateQuatSlerp(time));
-	}
+TimeWarpSettings Interpolation::getTimeWarp() const
+{
+	return m_interpolator.getTimeWarp();
 }
 
-float Interpolation::getTime() const
+void Interpolation::setTimeWarp(const TimeWarpSettings& settings)
 {
-	return m_currTime;
+	m_interpolator.setTimeWarp(settings);
+	updateFrames();
 }
 
-float Interpolation::getEndTime() const
+ClockType Interpolation::getClockType() const
 {
-	return m_endTime;
+	return m_clockType;
 }
 
-void Interpolation::setEndTime(float time)
+void Interpolation::setClockType(ClockType type)
 {
-	m_endTime = time;
-	m_currTime = std::min(m_currTime, time);
-	updateFrames();
+	Clock::Ticks ticks = m_clock->getTicks();
+	bool running = m_clock->isRunning();
+
+	m_clockType = type;
+	m_clock = createClock(type);
+	m_clock->setTicks(ticks);
+	if (running)
+	{
+		m_clock->start();
+	}
 }
 
 glm::vec3 Interpolation::getStartPos() const
 {
-	return m_startPos;
+	return m_interpolator.getStartPos();
 }
 
 void Interpolation::setStartPos(const glm::vec3& pos)
 {
-	m_startPos = pos;
+	m_interpolator.setStartPos(pos);
 	updateFrames();
 }
 
 glm::vec3 Interpolation::getStartEulerAngles() const
 {
-	return m_startEulerAngles;
+	return m_interpolator.getStartEulerAngles();
 }
 
 void Interpolation::setStartEulerAngles(const glm::vec3& eulerAngles)
 {
-	m_startEulerAngles = eulerAngles;
-	m_startQuat = eulerAnglesToQuat(eulerAngles);
+	m_interpolator.setStartEulerAngles(eulerAngles);
 	updateFrames();
 }
 
 glm::vec4 Interpolation::getStartQuat() const
 {
-	return m_startQuat;
+	return m_interpolator.getStartQuat();
 }
 
 void Interpolation::setStartQuat(const glm::vec4& quat)
 {
-	m_startQuat = quat;
-	m_startEulerAngles = quatToEulerAngles(glm::normalize(quat));
+	m_interpolator.setStartQuat(quat);
 	updateFrames();
 }
 
 void Interpolation::normalizeStartQuat()
 {
-	m_startQuat = glm::normalize(m_startQuat);
+	m_interpolator.normalizeStartQuat();
 }
 
 glm::vec3 Interpolation::getEndPos() const
 {
-	return m_endPos;
+	return m_interpolator.getEndPos();
 }
 
 void Interpolation::setEndPos(const glm::vec3& pos)
 {
-	m_endPos = pos;
+	m_interpolator.setEndPos(pos);
 	updateFrames();
 }
 
 glm::vec3 Interpolation::getEndEulerAngles() const
 {
-	return m_endEulerAngles;
+	return m_interpolator.getEndEulerAngles();
 }
 
 void Interpolation::setEndEulerAngles(const glm::vec3& eulerAngles)
 {
-	m_endEulerAngles = eulerAngles;
-	m_endQuat = eulerAnglesToQuat(eulerAngles);
+	m_interpolator.setEndEulerAngles(eulerAngles);
 	updateFrames();
 }
 
 glm::vec4 Interpolation::getEndQuat() const
 {
-	return m_endQuat;
+	return m_interpolator.getEndQuat();
 }
 
 void Interpolation::setEndQuat(const glm::vec4& quat)
 {
-	m_endQuat = quat;
-	m_endEulerAngles = quatToEulerAngles(glm::normalize(quat));
+	m_interpolator.setEndQuat(quat);
 	updateFrames();
 }
 
 void Interpolation::normalizeEndQuat()
 {
-	m_endQuat = glm::normalize(m_endQuat);
+	m_interpolator.normalizeEndQuat();
+}
+
+int Interpolation::getPosKeyCount() const
+{
+	return m_interpolator.getPosKeyCount();
+}
+
+PositionKey Interpolation::getPosKey(int index) const
+{
+	return m_interpolator.getPosKey(index);
+}
+
+void Interpolation::setPosKey(int index, const PositionKey& key)
+{
+	m_interpolator.setPosKey(index, key);
+	updateFrames();
 }
 
-glm::vec3 Interpolation::interpolatePos(float time) const
+void Interpolation::insertPosKey(int index)
 {
-	return m_startPos + (m_endPos - m_startPos) * time / m_endTime;
+	m_interpolator.insertPosKey(index);
+	updateFrames();
 }
 
-glm::vec3 Interpolation::interpolateEulerAngles(float time) const
+void Interpolation::removePosKey(int index)
 {
-	glm::vec3 start = m_startEulerAngles;
-	glm::vec3 end = m_endEulerAngles;
+	m_interpolator.removePosKey(index);
+	updateFrames();
+}
 
-	if (end.x - start.x > glm::pi<float>()) end.x -= 2 * glm::pi<float>();
-	if (start.x - end.x > glm::pi<float>()) start.x -= 2 * glm::pi<float>();
-	if (end.z - start.z > glm::pi<float>()) end.z -= 2 * glm::pi<float>();
-	if (start.z - end.z > glm::pi<float>()) start.z -= 2 * glm::pi<float>();
+bool Interpolation::getConstantSpeed() const
+{
+	return m_interpolator.getConstantSpeed();
+}
 
-	return start + (end - start) * time / m_endTime;
+void Interpolation::setConstantSpeed(bool constantSpeed)
+{
+	m_interpolator.setConstantSpeed(constantSpeed);
+	updateFrames();
 }
 
-glm::vec4 Interpolation::interpolateQuatLinear(float time) const
+SamplingSettings Interpolation::getSamplingSettings() const
 {
-	glm::vec4 start = glm::normalize(m_startQuat);
-	glm::vec4 end = glm::normalize(m_endQuat);
+	return m_samplingSettings;
+}
 
-	return glm::normalize(start + (end - start) * time / m_endTime);
+void Interpolation::setSamplingSettings(const SamplingSettings& settings)
+{
+	m_samplingSettings = settings;
+	updateFrames();
 }
 
-glm::vec4 Interpolation::interpolateQuatSlerp(float time) const
+bool Interpolation::getUseBakedCache() const
 {
-	glm::vec4 start = glm::normalize(m_startQuat);
-	glm::vec4 end = glm::normalize(m_endQuat);
+	return m_useBakedCache;
+}
 
-	glm::vec4 startInv{-glm::vec3{start}, start.w};
+void Interpolation::setUseBakedCache(bool useBakedCache)
+{
+	m_useBakedCache = useBakedCache;
+	updateMainFrames();
+}
 
-	glm::vec4 product = quatProduct(startInv, end);
-	glm::vec3 productV = product;
-	float angle = 2 * std::atan2(glm::length(productV), product.w) * time / m_endTime;
-	glm::vec3 axis = productV == glm::vec3{0, 0, 0} ? glm::vec3{0, 0, 0} : glm::normalize(productV);
-	return quatProduct(start, glm::vec4{std::sin(angle / 2.0f) * axis, std::cos(angle / 2.0f)});
+PoseCacheInfo Interpolation::getPoseCacheInfo() const
+{
+	if (m_cache == nullptr)
+	{
+		return {};
+	}
+
+	return {isCacheValid(), m_cache->getVersion(), m_cache->getSampleCount(),
+		m_cache->getByteSize()};
 }
 
-glm::vec4 Interpolation::eulerAnglesToQuat(const glm::vec3& eulerAngles)
+const DivergenceMetrics& Interpolation::getDivergenceMetrics() const
 {
-	glm::vec4 quat{};
+	return m_metrics;
+}
 
-	float cx = std::cos(eulerAngles.x * 0.5f);
-	float sx = std::sin(eulerAngles.x * 0.5f);
-	float cy = std::cos(eulerAngles.y * 0.5f);
-	float sy = std::sin(eulerAngles.y * 0.5f);
-	float cz = std::cos(eulerAngles.z * 0.5f);
-	float sz = std::sin(eulerAngles.z * 0.5f);
+PoseVelocity Interpolation::getMainVelocity(InterpolationType type,
+	PositionCurveType curve) const
+{
+	PoseVelocity velocity = m_mainVelocities[static_cast<int>(type)];
+	if (!interpolatesPos(type))
+	{
+		velocity.linear = m_mainPositionVelocities[static_cast<int>(curve)];
+	}
+	return velocity;
+}
 
-	quat.x = sx * cy * cz - cx * sy * sz;
-	quat.y = cx * sy * cz + sx * cy * sz;
-	quat.z = cx * cy * sz - sx * sy * cz;
-	quat.w = cx * cy * cz + sx * sy * sz;
+void Interpolation::interpolateModelMatrices(InterpolationType type, PositionCurveType curve,
+	const float* times, glm::mat4* modelMatrices, std::size_t count)
+{
+	m_interpolator.interpolateModelMatrices(type,
+		interpolatesPos(type) ? PositionCurveType::linear : curve, times, modelMatrices, count);
+}
 
-	return quat;
+bool Interpolation::isCacheValid() const
+{
+	return m_cache != nullptr && m_cache->getVersion() == m_version;
 }
 
-glm::vec3 Interpolation::quatToEulerAngles(const glm::vec4& quat)
+void Interpolation::updateMainFrames()
 {
-	glm::vec3 eulerAngles{};
+	float currTime = getTime();
 
-	eulerAngles.x = std::atan2(2 * (quat.w * quat.x + quat.y * quat.z),
-		1 - 2 * (quat.x * quat.x + quat.y * quat.y));
-	eulerAngles.y = std::asin(2 * (quat.w * quat.y - quat.x * quat.z));
-	eulerAngles.z = std::atan2(2 * (quat.w * quat.z + quat.x * quat.y),
-		1 - 2 * (quat.y * quat.y + quat.z * quat.z));
+	if (m_useBakedCache && isCacheValid())
+	{
+		for (int type = 0; type < interpolationTypeCount; ++type)
+		{
+			InterpolationType interpolationType = static_cast<InterpolationType>(type);
+			m_frames[type].mainFrame.setModelMatrix(
+				m_cache->modelMatrix(interpolationType, currTime));
+			m_mainVelocities[type] = m_cache->velocity(interpolationType, currTime);
+		}
+
+		for (int type = 0; type < positionCurveTypeCount; ++type)
+		{
+			PositionCurveType curve = static_cast<PositionCurveType>(type);
+			m_mainPositions[type] = m_cache->position(curve, currTime);
+			m_mainPositionVelocities[type] = m_cache->positionVelocity(curve, currTime);
+		}
+		return;
+	}
 
-	return eulerAngles;
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		m_frames[type].mainFrame.setModelMatrix(m_interpolator.interpolateModelMatrix(
+			static_cast<InterpolationType>(type), PositionCurveType::linear, currTime,
+			&m_mainVelocities[type]));
+	}
+
+	float rate{};
+	float t = m_interpolator.warpTime(currTime, rate);
+	for (int type = 0; type < positionCurveTypeCount; ++type)
+	{
+		m_mainPositions[type] = m_interpolator.getPositionSpline(
+			static_cast<PositionCurveType>(type)).evaluate(t, m_mainPositionVelocities[type]);
+		m_mainPositionVelocities[type] *= rate;
+	}
 }
 
-glm::vec4 Interpolation::quatProduct(const glm::vec4& q1, const glm::vec4& q2)
+void Interpolation::updateIntermediateFrames()
 {
-	glm::vec3 q1V = q1;
-	glm::vec3 q2V = q2;
-	glm::vec3 crossProduct = glm::cross(q1V, q2V);
-	float dotProduct = glm::dot(q1V, q2V);
-	glm::vec3 qV = crossProduct + q1.w * q2V + q2.w * q1V;
-	return glm::vec4{qV, q1.w * q2.w - dotProduct};
+	const PoseSnapshot* snapshot = m_poseWorker.poll();
+	if (snapshot == nullptr)
+	{
+		return;
+	}
+
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		const PoseSamples& samples = snapshot->samples[type];
+		InterpolationFrames& frames = m_frames[type];
+		frames.intermediateFrames.resize(samples.modelMatrices.size());
+		for (std::size_t i = 0; i < frames.intermediateFrames.size(); ++i)
+		{
+			frames.intermediateFrames[i].setModelMatrix(samples.modelMatrices[i]);
+		}
+		frames.intermediatePositions = samples.positions;
+	}
+	m_cache = snapshot->cache;
+	m_metrics = snapshot->metrics;
 }
 
-Interpolation::TimePoint Interpolation::now()
+std::unique_ptr<Clock> Interpolation::createClock(ClockType type)
 {
-	return std::chrono::high_resolution_clock::now();
+	switch (type)
+	{
+		case ClockType::realTime:
+			return std::make_unique<RealTimeClock>();
+
+		case ClockType::fixedStep:
+			return std::make_unique<FixedStepClock>(fixedStepsPerSecond);
+
+		case ClockType::scrubbed:
+			return std::make_unique<ScrubbedClock>();
+	}
+	return nullptr;
 }
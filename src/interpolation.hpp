@@ -1,27 +1,43 @@
 #pragma once
 
-#include "frame.hpp"
+#include "clock/clock.hpp"
+#include "clock/clockType.hpp"
+#include "divergenceMetrics.hpp"
+#include "interpolationFrames.hpp"
+#include "interpolator.hpp"
+#include "math/positionSpline.hpp"
+#include "math/timeWarp.hpp"
+#include "poseCache.hpp"
+#include "poseSampler.hpp"
+#include "poseWorker.hpp"
+#include "positionCurveType.hpp"
 
-#include <chrono>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <vector>
 
 class Interpolation
 {
-	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock,
-		std::chrono::duration<float, std::nano>>;
-
 public:
-	Interpolation(Frame& eulerFrame, std::vector<Frame>& eulerFrames, Frame& quatLinearFrame,
-		std::vector<Frame>& quatLinearFrames, Frame& quatSlerpFrame,
-		std::vector<Frame>& quatSlerpFrames);
+	Interpolation(InterpolationFramesArray& frames, MainPositionsArray& mainPositions);
 	void start();
 	void stop();
+	bool isRunning() const;
 	void reset();
-	void update();
+	void update(std::optional<Clock::Ticks> lockedTicks = std::nullopt);
 	void updateFrames();
+	Clock::Ticks getTicks() const;
 	float getTime() const;
+	void setTime(float time);
 	float getEndTime() const;
 	void setEndTime(float time);
+	TimeWarpSettings getTimeWarp() const;
+	void setTimeWarp(const TimeWarpSettings& settings);
+	ClockType getClockType() const;
+	void setClockType(ClockType type);
 
 	glm::vec3 getStartPos() const;
 	void setStartPos(const glm::vec3& pos);
@@ -39,33 +55,42 @@ public:
 	void setEndQuat(const glm::vec4& quat);
 	void normalizeEndQuat();
 
-private:
-	Frame& m_eulerFrame;
-	std::vector<Frame>& m_eulerFrames;
-	Frame& m_quatLinearFrame;
-	std::vector<Frame>& m_quatLinearFrames;
-	Frame& m_quatSlerpFrame;
-	std::vector<Frame>& m_quatSlerpFrames;
+	int getPosKeyCount() const;
+	PositionKey getPosKey(int index) const;
+	void setPosKey(int index, const PositionKey& key);
+	void insertPosKey(int index);
+	void removePosKey(int index);
+	bool getConstantSpeed() const;
+	void setConstantSpeed(bool constantSpeed);
+	SamplingSettings getSamplingSettings() const;
+	void setSamplingSettings(const SamplingSettings& settings);
+	bool getUseBakedCache() const;
+	void setUseBakedCache(bool useBakedCache);
+	PoseCacheInfo getPoseCacheInfo() const;
+	const DivergenceMetrics& getDivergenceMetrics() const;
+	PoseVelocity getMainVelocity(InterpolationType type, PositionCurveType curve) const;
+	void interpolateModelMatrices(InterpolationType type, PositionCurveType curve,
+		const float* times, glm::mat4* modelMatrices, std::size_t count);
 
-	TimePoint m_startTime{};
-	float m_currTime = 0;
-	float m_endTime = 5;
-	bool m_running = false;
+private:
+	InterpolationFramesArray& m_frames;
+	MainPositionsArray& m_mainPositions;
 
-	glm::vec3 m_startPos{-1, 0, 0};
-	glm::vec3 m_startEulerAngles{0, 0, 0};
-	glm::vec4 m_startQuat{0, 0, 0, 1};
+	ClockType m_clockType = ClockType::realTime;
+	std::unique_ptr<Clock> m_clock;
 
-	glm::vec3 m_endPos{1, 0, 0};
-	glm::vec3 m_endEulerAngles{0, 0, 0};
-	glm::vec4 m_endQuat{0, 0, 0, 1};
+	Interpolator m_interpolator{};
+	SamplingSettings m_samplingSettings{};
+	std::uint64_t m_version = 0;
+	bool m_useBakedCache = true;
+	std::shared_ptr<const PoseCache> m_cache{};
+	DivergenceMetrics m_metrics{};
+	std::array<PoseVelocity, interpolationTypeCount> m_mainVelocities{};
+	std::array<glm::vec3, positionCurveTypeCount> m_mainPositionVelocities{};
+	PoseWorker m_poseWorker{};
 
-	glm::vec3 interpolatePos(float time) const;
-	glm::vec3 interpolateEulerAngles(float time) const;
-	glm::vec4 interpolateQuatLinear(float time) const;
-	glm::vec4 interpolateQuatSlerp(float time) const;
-	static glm::vec4 eulerAnglesToQuat(const glm::vec3& eulerAngles);
-	static glm::vec3 quatToEulerAngles(const glm::vec4& quat);
-	static glm::vec4 quatProduct(const glm::vec4& q1, const glm::vec4& q2);
-	static TimePoint now();
+	bool isCacheValid() const;
+	void updateMainFrames();
+	void updateIntermediateFrames();
+	static std::unique_ptr<Clock> createClock(ClockType type);
 };
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "frame.hpp"
+#include "interpolationType.hpp"
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+
+struct InterpolationFrames
+{
+	Frame mainFrame{false};
+	std::vector<Frame> intermediateFrames{};
+	std::array<std::vector<glm::vec3>, positionCurveTypeCount> intermediatePositions{};
+};
+
+using InterpolationFramesArray = std::array<InterpolationFrames, interpolationTypeCount>;
+
+using MainPositionsArray = std::array<glm::vec3, positionCurveTypeCount>;
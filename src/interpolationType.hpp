@@ -7,12 +7,23 @@ enum class InterpolationType
 {
 	euler,
 	quatLinear,
-	quatSlerp
+	quatSlerp,
+	quatSlerpFast,
+	dualQuatScLerp
 };
 
-inline const std::array<std::string, 3> interpolationTypeLabels
+inline constexpr int interpolationTypeCount = 5;
+
+inline const std::array<std::string, interpolationTypeCount> interpolationTypeLabels
 {
 	"Euler",
 	"Quaternion linear",
-	"Quaternion slerp"
+	"Quaternion slerp",
+	"Quaternion slerp (fast)",
+	"Dual quaternion ScLERP"
 };
+
+inline constexpr bool interpolatesPos(InterpolationType type)
+{
+	return type == InterpolationType::dualQuatScLerp;
+}
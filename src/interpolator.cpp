@@ -0,0 +1,642 @@
+#include "interpolator.hpp"
+
+#include "frame.hpp"
+#include "math/eulerAngles.hpp"
+#include "math/sinCos.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+static constexpr std::size_t batchSize = 64;
+
+static glm::vec3 angularVelocity(const glm::vec4& quat, const glm::vec4& quatRate)
+{
+	return 2.0f * glm::vec3{Interpolator::quatProduct(quatRate, {-glm::vec3{quat}, quat.w})};
+}
+
+static glm::vec3 slerpAngularVelocity(const glm::vec4& start, const glm::vec4& end)
+{
+	glm::vec4 product = Interpolator::quatProduct(end, {-glm::vec3{start}, start.w});
+	glm::vec3 productV = product;
+	float productLength = glm::length(productV);
+	if (productLength == 0)
+	{
+		return {0, 0, 0};
+	}
+	return 2 * std::atan2(productLength, product.w) / productLength * productV;
+}
+
+static glm::vec3 eulerAngularVelocity(const glm::mat3& rotationMatrix, float zAngle,
+	const glm::vec3& rates)
+{
+	return rates.x * rotationMatrix[0] +
+		rates.y * glm::vec3{-std::sin(zAngle), std::cos(zAngle), 0} +
+		rates.z * glm::vec3{0, 0, 1};
+}
+
+Interpolator::Interpolator()
+{
+	updatePositionSplines();
+}
+
+float Interpolator::getEndTime() const
+{
+	return m_endTime;
+}
+
+void Interpolator::setEndTime(float time)
+{
+	if (!std::isnan(time))
+	{
+		m_endTime = std::clamp(time, minEndTime, maxEndTime);
+	}
+}
+
+TimeWarpSettings Interpolator::getTimeWarp() const
+{
+	return m_timeWarp.getSettings();
+}
+
+void Interpolator::setTimeWarp(const TimeWarpSettings& settings)
+{
+	m_timeWarp = TimeWarp{settings};
+}
+
+float Interpolator::warpTime(float time) const
+{
+	return m_timeWarp.warp(time / m_endTime);
+}
+
+float Interpolator::warpTime(float time, float& rate) const
+{
+	float t = m_timeWarp.warp(time / m_endTime, rate);
+	rate /= m_endTime;
+	return t;
+}
+
+void Interpolator::warpTimes(const float* times, float* ts, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		ts[i] = times[i] / m_endTime;
+	}
+	m_timeWarp.warp(ts, ts, count);
+}
+
+void Interpolator::warpTimes(const float* times, float* ts, float* rates,
+	std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		ts[i] = times[i] / m_endTime;
+	}
+	m_timeWarp.warp(ts, ts, rates, count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		rates[i] /= m_endTime;
+	}
+}
+
+glm::vec3 Interpolator::getStartPos() const
+{
+	return m_posKeys.front().pos;
+}
+
+void Interpolator::setStartPos(const glm::vec3& pos)
+{
+	m_posKeys.front().pos = pos;
+	updatePositionSplines();
+}
+
+glm::vec3 Interpolator::getStartEulerAngles() const
+{
+	return m_startEulerAngles;
+}
+
+void Interpolator::setStartEulerAngles(const glm::vec3& eulerAngles)
+{
+	m_startEulerAngles = eulerAngles;
+	m_startQuat = eulerAnglesToQuat(eulerAngles);
+}
+
+glm::vec4 Interpolator::getStartQuat() const
+{
+	return m_startQuat;
+}
+
+void Interpolator::setStartQuat(const glm::vec4& quat)
+{
+	m_startQuat = quat;
+	m_startEulerAngles = quatToEulerAngles(glm::normalize(quat));
+}
+
+void Interpolator::normalizeStartQuat()
+{
+	m_startQuat = glm::normalize(m_startQuat);
+}
+
+glm::vec3 Interpolator::getEndPos() const
+{
+	return m_posKeys.back().pos;
+}
+
+void Interpolator::setEndPos(const glm::vec3& pos)
+{
+	m_posKeys.back().pos = pos;
+	updatePositionSplines();
+}
+
+glm::vec3 Interpolator::getEndEulerAngles() const
+{
+	return m_endEulerAngles;
+}
+
+void Interpolator::setEndEulerAngles(const glm::vec3& eulerAngles)
+{
+	m_endEulerAngles = eulerAngles;
+	m_endQuat = eulerAnglesToQuat(eulerAngles);
+}
+
+glm::vec4 Interpolator::getEndQuat() const
+{
+	return m_endQuat;
+}
+
+void Interpolator::setEndQuat(const glm::vec4& quat)
+{
+	m_endQuat = quat;
+	m_endEulerAngles = quatToEulerAngles(glm::normalize(quat));
+}
+
+void Interpolator::normalizeEndQuat()
+{
+	m_endQuat = glm::normalize(m_endQuat);
+}
+
+int Interpolator::getPosKeyCount() const
+{
+	return static_cast<int>(m_posKeys.size());
+}
+
+PositionKey Interpolator::getPosKey(int index) const
+{
+	return m_posKeys[index];
+}
+
+void Interpolator::setPosKey(int index, const PositionKey& key)
+{
+	if (index < 0 || index >= getPosKeyCount())
+	{
+		return;
+	}
+
+	m_posKeys[index] = key;
+	updatePositionSplines();
+}
+
+void Interpolator::insertPosKey(int index)
+{
+	if (index <= 0 || index >= getPosKeyCount())
+	{
+		return;
+	}
+
+	const PositionKey& prev = m_posKeys[index - 1];
+	const PositionKey& next = m_posKeys[index];
+	PositionKey key{0.5f * (prev.pos + next.pos), 0.5f * (prev.tangent + next.tangent)};
+	m_posKeys.insert(m_posKeys.begin() + index, key);
+	updatePositionSplines();
+}
+
+void Interpolator::removePosKey(int index)
+{
+	if (index <= 0 || index >= getPosKeyCount() - 1)
+	{
+		return;
+	}
+
+	m_posKeys.erase(m_posKeys.begin() + index);
+	updatePositionSplines();
+}
+
+bool Interpolator::getConstantSpeed() const
+{
+	return m_constantSpeed;
+}
+
+void Interpolator::setConstantSpeed(bool constantSpeed)
+{
+	m_constantSpeed = constantSpeed;
+	updatePositionSplines();
+}
+
+glm::vec3 Interpolator::interpolatePos(PositionCurveType type, float time) const
+{
+	return getPositionSpline(type).evaluate(warpTime(time));
+}
+
+const PositionSpline& Interpolator::getPositionSpline(PositionCurveType type) const
+{
+	return m_positionSplines[static_cast<int>(type)];
+}
+
+void Interpolator::interpolatePositions(PositionCurveType type, const float* times,
+	glm::vec3* positions, std::size_t count, glm::vec3* velocities) const
+{
+	const PositionSpline& spline = getPositionSpline(type);
+	std::array<float, batchSize> ts{};
+	std::array<float, batchSize> rates{};
+	for (std::size_t begin = 0; begin < count; begin += batchSize)
+	{
+		std::size_t size = std::min(batchSize, count - begin);
+		if (velocities == nullptr)
+		{
+			warpTimes(times + begin, ts.data(), size);
+			spline.evaluate(ts.data(), positions + begin, size);
+			continue;
+		}
+
+		warpTimes(times + begin, ts.data(), rates.data(), size);
+		spline.evaluate(ts.data(), positions + begin, velocities + begin, size);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			velocities[begin + i] *= rates[i];
+		}
+	}
+}
+
+glm::vec3 Interpolator::interpolateEulerAngles(float time) const
+{
+	glm::vec3 start{};
+	glm::vec3 end{};
+	getEulerEndpoints(start, end);
+	return start + (end - start) * warpTime(time);
+}
+
+glm::vec4 Interpolator::interpolateQuatLinear(float time) const
+{
+	glm::vec4 start = glm::normalize(m_startQuat);
+	glm::vec4 end = glm::normalize(m_endQuat);
+
+	return glm::normalize(start + (end - start) * warpTime(time));
+}
+
+glm::vec4 Interpolator::interpolateQuatSlerp(float time) const
+{
+	glm::vec4 start = glm::normalize(m_startQuat);
+	glm::vec4 end = glm::normalize(m_endQuat);
+
+	glm::vec4 startInv{-glm::vec3{start}, start.w};
+
+	glm::vec4 product = quatProduct(startInv, end);
+	glm::vec3 productV = product;
+	float angle = 2 * std::atan2(glm::length(productV), product.w) * warpTime(time);
+	glm::vec3 axis = productV == glm::vec3{0, 0, 0} ? glm::vec3{0, 0, 0} : glm::normalize(productV);
+	return quatProduct(start, glm::vec4{std::sin(angle / 2.0f) * axis, std::cos(angle / 2.0f)});
+}
+
+glm::vec4 Interpolator::interpolateQuatSlerpFast(float time) const
+{
+	return getFastSlerp().interpolate(warpTime(time));
+}
+
+FastSlerp Interpolator::getFastSlerp() const
+{
+	return FastSlerp{m_startQuat, m_endQuat};
+}
+
+DualQuat Interpolator::interpolateDualQuatScLerp(float time) const
+{
+	return getDualQuatScLerp().interpolate(warpTime(time));
+}
+
+DualQuatScLerp Interpolator::getDualQuatScLerp() const
+{
+	return DualQuatScLerp
+	{
+		DualQuat::fromRigid(glm::normalize(m_startQuat), getStartPos()),
+		DualQuat::fromRigid(glm::normalize(m_endQuat), getEndPos())
+	};
+}
+
+void Interpolator::interpolateQuats(InterpolationType type, const float* times,
+	glm::vec4* quats, std::size_t count) const
+{
+	switch (type)
+	{
+		case InterpolationType::euler:
+		{
+			std::array<glm::vec3, batchSize> angles{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					angles[i] = interpolateEulerAngles(times[begin + i]);
+				}
+				EulerAngles::toQuats<EulerOrder::xyz>(angles.data(), quats + begin, size);
+			}
+			break;
+		}
+
+		case InterpolationType::quatLinear:
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				quats[i] = interpolateQuatLinear(times[i]);
+			}
+			break;
+
+		case InterpolationType::quatSlerp:
+		{
+			glm::vec4 start = glm::normalize(m_startQuat);
+			glm::vec4 end = glm::normalize(m_endQuat);
+			glm::vec4 product = quatProduct({-glm::vec3{start}, start.w}, end);
+			glm::vec3 productV = product;
+			float halfAngle = std::atan2(glm::length(productV), product.w);
+			glm::vec3 axis = productV == glm::vec3{0, 0, 0} ? glm::vec3{0, 0, 0} :
+				glm::normalize(productV);
+
+			std::array<float, batchSize> halfAngles{};
+			std::array<float, batchSize> sines{};
+			std::array<float, batchSize> cosines{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				warpTimes(times + begin, halfAngles.data(), size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					halfAngles[i] *= halfAngle;
+				}
+				sinCos(halfAngles.data(), sines.data(), cosines.data(), size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					quats[begin + i] = quatProduct(start, {sines[i] * axis, cosines[i]});
+				}
+			}
+			break;
+		}
+
+		case InterpolationType::quatSlerpFast:
+		{
+			FastSlerp slerp = getFastSlerp();
+			std::array<float, batchSize> ts{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				warpTimes(times + begin, ts.data(), size);
+				slerp.interpolate(ts.data(), quats + begin, size);
+			}
+			break;
+		}
+
+		case InterpolationType::dualQuatScLerp:
+		{
+			DualQuatScLerp scLerp = getDualQuatScLerp();
+			std::array<float, batchSize> ts{};
+			std::array<DualQuat, batchSize> dualQuats{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				warpTimes(times + begin, ts.data(), size);
+				scLerp.interpolate(ts.data(), dualQuats.data(), size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					quats[begin + i] = dualQuats[i].real;
+				}
+			}
+			break;
+		}
+	}
+}
+
+glm::mat4 Interpolator::interpolateModelMatrix(InterpolationType type, PositionCurveType curve,
+	float time, PoseVelocity* velocity) const
+{
+	glm::mat4 modelMatrix{};
+	interpolateModelMatrices(type, curve, &time, &modelMatrix, 1, velocity);
+	return modelMatrix;
+}
+
+void Interpolator::interpolateModelMatrices(InterpolationType type, PositionCurveType curve,
+	const float* times, glm::mat4* modelMatrices, std::size_t count,
+	PoseVelocity* velocities) const
+{
+	glm::vec3 startPos = getStartPos();
+	glm::vec3 posDelta = getEndPos() - startPos;
+	const PositionSpline& spline = getPositionSpline(curve);
+	std::array<float, batchSize> ts{};
+	std::array<float, batchSize> rates{};
+	std::array<glm::vec3, batchSize> positions{};
+	std::array<glm::vec3, batchSize> linearVelocities{};
+	auto evaluatePositions = [&] (std::size_t begin, std::size_t size)
+	{
+		warpTimes(times + begin, ts.data(), rates.data(), size);
+		if (velocities == nullptr)
+		{
+			spline.evaluate(ts.data(), positions.data(), size);
+			return;
+		}
+
+		spline.evaluate(ts.data(), positions.data(), linearVelocities.data(), size);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			linearVelocities[i] *= rates[i];
+		}
+	};
+	switch (type)
+	{
+		case InterpolationType::euler:
+		{
+			glm::vec3 start{};
+			glm::vec3 end{};
+			getEulerEndpoints(start, end);
+			std::array<glm::vec3, batchSize> angles{};
+			std::array<glm::mat3, batchSize> rotationMatrices{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				evaluatePositions(begin, size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					angles[i] = start + (end - start) * ts[i];
+				}
+				EulerAngles::toMatrices<EulerOrder::xyz>(angles.data(), rotationMatrices.data(),
+					size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					modelMatrices[begin + i] = Frame::modelMatrix(positions[i],
+						glm::mat4{rotationMatrices[i]});
+				}
+				if (velocities == nullptr)
+				{
+					continue;
+				}
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					velocities[begin + i] =
+					{
+						linearVelocities[i],
+						eulerAngularVelocity(rotationMatrices[i], angles[i].z,
+							(end - start) * rates[i])
+					};
+				}
+			}
+			break;
+		}
+
+		case InterpolationType::quatLinear:
+		{
+			glm::vec4 start = glm::normalize(m_startQuat);
+			glm::vec4 delta = glm::normalize(m_endQuat) - start;
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				evaluatePositions(begin, size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					glm::vec4 sum = start + delta * ts[i];
+					float length = glm::length(sum);
+					glm::vec4 quat = sum / length;
+					modelMatrices[begin + i] = Frame::modelMatrix(positions[i],
+						Frame::quatToRotationMatrix(quat));
+					if (velocities != nullptr)
+					{
+						glm::vec4 quatRate = (delta - glm::dot(quat, delta) * quat) *
+							(rates[i] / length);
+						velocities[begin + i] =
+							{linearVelocities[i], angularVelocity(quat, quatRate)};
+					}
+				}
+			}
+			break;
+		}
+
+		case InterpolationType::quatSlerp:
+		{
+			glm::vec4 start = glm::normalize(m_startQuat);
+			glm::vec4 end = glm::normalize(m_endQuat);
+			glm::vec4 product = quatProduct({-glm::vec3{start}, start.w}, end);
+			glm::vec3 productV = product;
+			float halfAngle = std::atan2(glm::length(productV), product.w);
+			glm::vec3 axis = productV == glm::vec3{0, 0, 0} ? glm::vec3{0, 0, 0} :
+				glm::normalize(productV);
+			glm::vec3 angular = slerpAngularVelocity(start, end);
+
+			std::array<float, batchSize> halfAngles{};
+			std::array<float, batchSize> sines{};
+			std::array<float, batchSize> cosines{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				evaluatePositions(begin, size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					halfAngles[i] = halfAngle * ts[i];
+				}
+				sinCos(halfAngles.data(), sines.data(), cosines.data(), size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					modelMatrices[begin + i] = Frame::modelMatrix(positions[i],
+						Frame::quatToRotationMatrix(
+							quatProduct(start, {sines[i] * axis, cosines[i]})));
+					if (velocities != nullptr)
+					{
+						velocities[begin + i] = {linearVelocities[i], angular * rates[i]};
+					}
+				}
+			}
+			break;
+		}
+
+		case InterpolationType::quatSlerpFast:
+		{
+			FastSlerp slerp = getFastSlerp();
+			glm::vec3 angular =
+				slerpAngularVelocity(glm::normalize(m_startQuat), glm::normalize(m_endQuat));
+			std::array<glm::vec4, batchSize> quats{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				evaluatePositions(begin, size);
+				slerp.interpolate(ts.data(), quats.data(), size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					modelMatrices[begin + i] = Frame::modelMatrix(positions[i],
+						Frame::quatToRotationMatrix(quats[i]));
+					if (velocities != nullptr)
+					{
+						velocities[begin + i] = {linearVelocities[i], angular * rates[i]};
+					}
+				}
+			}
+			break;
+		}
+
+		case InterpolationType::dualQuatScLerp:
+		{
+			DualQuatScLerp scLerp = getDualQuatScLerp();
+			std::array<DualQuat, batchSize> dualQuats{};
+			for (std::size_t begin = 0; begin < count; begin += batchSize)
+			{
+				std::size_t size = std::min(batchSize, count - begin);
+				evaluatePositions(begin, size);
+				scLerp.interpolate(ts.data(), dualQuats.data(), size);
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					glm::vec3 screwPos = dualQuats[i].translation();
+					glm::vec3 offset = positions[i] - (startPos + posDelta * ts[i]);
+					modelMatrices[begin + i] = Frame::modelMatrix(screwPos + offset,
+						Frame::quatToRotationMatrix(dualQuats[i].real));
+					if (velocities != nullptr)
+					{
+						velocities[begin + i] =
+						{
+							scLerp.getLinearVelocity(screwPos) * rates[i] +
+								linearVelocities[i] - posDelta * rates[i],
+							scLerp.getAngularVelocity() * rates[i]
+						};
+					}
+				}
+			}
+			break;
+		}
+	}
+}
+
+glm::vec4 Interpolator::eulerAnglesToQuat(const glm::vec3& eulerAngles)
+{
+	return EulerAngles::toQuat<EulerOrder::xyz>(eulerAngles);
+}
+
+glm::vec3 Interpolator::quatToEulerAngles(const glm::vec4& quat)
+{
+	return EulerAngles::fromQuat<EulerOrder::xyz>(quat);
+}
+
+glm::vec4 Interpolator::quatProduct(const glm::vec4& q1, const glm::vec4& q2)
+{
+	return DualQuat::quatProduct(q1, q2);
+}
+
+void Interpolator::updatePositionSplines()
+{
+	for (int type = 0; type < positionCurveTypeCount; ++type)
+	{
+		m_positionSplines[type].update(static_cast<PositionCurveType>(type), m_posKeys,
+			m_constantSpeed);
+	}
+}
+
+void Interpolator::getEulerEndpoints(glm::vec3& start, glm::vec3& end) const
+{
+	start = m_startEulerAngles;
+	end = m_endEulerAngles;
+
+	if (end.x - start.x > glm::pi<float>()) end.x -= 2 * glm::pi<float>();
+	if (start.x - end.x > glm::pi<float>()) start.x -= 2 * glm::pi<float>();
+	if (end.z - start.z > glm::pi<float>()) end.z -= 2 * glm::pi<float>();
+	if (start.z - end.z > glm::pi<float>()) start.z -= 2 * glm::pi<float>();
+}
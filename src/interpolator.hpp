@@ -0,0 +1,104 @@
+#pragma once
+
+#include "interpolationType.hpp"
+#include "math/dualQuat.hpp"
+#include "math/dualQuatScLerp.hpp"
+#include "math/fastSlerp.hpp"
+#include "math/positionSpline.hpp"
+#include "math/timeWarp.hpp"
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+struct PoseVelocity
+{
+	glm::vec3 linear{};
+	glm::vec3 angular{};
+};
+
+class Interpolator
+{
+public:
+	static constexpr float minEndTime = 0.01f;
+	static constexpr float maxEndTime = 3600.0f;
+
+	Interpolator();
+
+	float getEndTime() const;
+	void setEndTime(float time);
+	TimeWarpSettings getTimeWarp() const;
+	void setTimeWarp(const TimeWarpSettings& settings);
+	float warpTime(float time) const;
+	float warpTime(float time, float& rate) const;
+	void warpTimes(const float* times, float* ts, std::size_t count) const;
+	void warpTimes(const float* times, float* ts, float* rates, std::size_t count) const;
+
+	glm::vec3 getStartPos() const;
+	void setStartPos(const glm::vec3& pos);
+	glm::vec3 getStartEulerAngles() const;
+	void setStartEulerAngles(const glm::vec3& eulerAngles);
+	glm::vec4 getStartQuat() const;
+	void setStartQuat(const glm::vec4& quat);
+	void normalizeStartQuat();
+
+	glm::vec3 getEndPos() const;
+	void setEndPos(const glm::vec3& pos);
+	glm::vec3 getEndEulerAngles() const;
+	void setEndEulerAngles(const glm::vec3& eulerAngles);
+	glm::vec4 getEndQuat() const;
+	void setEndQuat(const glm::vec4& quat);
+	void normalizeEndQuat();
+
+	int getPosKeyCount() const;
+	PositionKey getPosKey(int index) const;
+	void setPosKey(int index, const PositionKey& key);
+	void insertPosKey(int index);
+	void removePosKey(int index);
+	bool getConstantSpeed() const;
+	void setConstantSpeed(bool constantSpeed);
+
+	glm::vec3 interpolatePos(PositionCurveType type, float time) const;
+	const PositionSpline& getPositionSpline(PositionCurveType type) const;
+	void interpolatePositions(PositionCurveType type, const float* times, glm::vec3* positions,
+		std::size_t count, glm::vec3* velocities = nullptr) const;
+	glm::vec3 interpolateEulerAngles(float time) const;
+	glm::vec4 interpolateQuatLinear(float time) const;
+	glm::vec4 interpolateQuatSlerp(float time) const;
+	glm::vec4 interpolateQuatSlerpFast(float time) const;
+	FastSlerp getFastSlerp() const;
+	DualQuat interpolateDualQuatScLerp(float time) const;
+	DualQuatScLerp getDualQuatScLerp() const;
+
+	void interpolateQuats(InterpolationType type, const float* times, glm::vec4* quats,
+		std::size_t count) const;
+	glm::mat4 interpolateModelMatrix(InterpolationType type, PositionCurveType curve, float time,
+		PoseVelocity* velocity = nullptr) const;
+	void interpolateModelMatrices(InterpolationType type, PositionCurveType curve,
+		const float* times, glm::mat4* modelMatrices, std::size_t count,
+		PoseVelocity* velocities = nullptr) const;
+
+	static glm::vec4 eulerAnglesToQuat(const glm::vec3& eulerAngles);
+	static glm::vec3 quatToEulerAngles(const glm::vec4& quat);
+	static glm::vec4 quatProduct(const glm::vec4& q1, const glm::vec4& q2);
+
+private:
+	float m_endTime = 5;
+	TimeWarp m_timeWarp{};
+
+	std::vector<PositionKey> m_posKeys{{{-1, 0, 0}, {2, 0, 0}}, {{1, 0, 0}, {2, 0, 0}}};
+	bool m_constantSpeed = false;
+	std::array<PositionSpline, positionCurveTypeCount> m_positionSplines{};
+
+	glm::vec3 m_startEulerAngles{0, 0, 0};
+	glm::vec4 m_startQuat{0, 0, 0, 1};
+
+	glm::vec3 m_endEulerAngles{0, 0, 0};
+	glm::vec4 m_endQuat{0, 0, 0, 1};
+
+	void updatePositionSplines();
+	void getEulerEndpoints(glm::vec3& start, glm::vec3& end) const;
+};
@@ -1,23 +1,91 @@
 #include "gui/gui.hpp"
+#include "memory/allocationTracker.hpp"
+#include "replay/inputSession.hpp"
 #include "scene.hpp"
 #include "window.hpp"
 
-int main()
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+struct Options
+{
+	std::filesystem::path recordPath{};
+	std::filesystem::path replayPath{};
+	std::filesystem::path reportPath = "replayReport.json";
+};
+
+void printUsage()
+{
+	std::fprintf(stderr,
+		"usage: motion-interpolation [--record LOG] [--replay LOG] [--report JSON]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
 {
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument = argv[i];
+		std::string value = argv[i + 1];
+		if (argument == "--record")
+		{
+			options.recordPath = value;
+		}
+		else if (argument == "--replay")
+		{
+			options.replayPath = value;
+		}
+		else if (argument == "--report")
+		{
+			options.reportPath = value;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return argc % 2 == 1 && (options.recordPath.empty() || options.replayPath.empty());
+}
+
+int main(int argc, char** argv)
+{
+	Options options{};
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 2;
+	}
+
 	Window window{};
 	Scene scene{window.viewportSize()};
 	GUI gui{window.getPtr(), scene, window.viewportSize()};
 	window.init(scene);
 
-	while (!window.shouldClose())
+	InputSession session{window, scene};
+	if (!options.recordPath.empty() && !session.startRecording(options.recordPath))
+	{
+		std::fprintf(stderr, "cannot record to %s\n", options.recordPath.string().c_str());
+		return 1;
+	}
+	if (!options.replayPath.empty() &&
+		!session.startReplay(options.replayPath, options.reportPath))
+	{
+		std::fprintf(stderr, "cannot replay %s\n", options.replayPath.string().c_str());
+		return 1;
+	}
+
+	while (!window.shouldClose() && !session.isReplayFinished())
 	{
+		session.beginFrame();
 		gui.update();
 		scene.update();
 		scene.render();
 		gui.render();
 		window.swapBuffers();
 		window.pollEvents();
+		session.endFrame();
+		AllocationTracker::endFrame(scene.isRunning());
 	}
 
-	return 0;
+	return session.finish() ? 0 : 1;
 }
@@ -0,0 +1,34 @@
+#include "math/dualQuat.hpp"
+
+DualQuat DualQuat::fromRigid(const glm::vec4& rotation, const glm::vec3& translation)
+{
+	return {rotation, 0.5f * quatProduct(glm::vec4{translation, 0}, rotation)};
+}
+
+DualQuat DualQuat::product(const DualQuat& dq1, const DualQuat& dq2)
+{
+	return
+	{
+		quatProduct(dq1.real, dq2.real),
+		quatProduct(dq1.real, dq2.dual) + quatProduct(dq1.dual, dq2.real)
+	};
+}
+
+glm::vec4 DualQuat::quatProduct(const glm::vec4& q1, const glm::vec4& q2)
+{
+	glm::vec3 q1V = q1;
+	glm::vec3 q2V = q2;
+	glm::vec3 qV = glm::cross(q1V, q2V) + q1.w * q2V + q2.w * q1V;
+	return glm::vec4{qV, q1.w * q2.w - glm::dot(q1V, q2V)};
+}
+
+DualQuat DualQuat::conjugate() const
+{
+	return {glm::vec4{-glm::vec3{real}, real.w}, glm::vec4{-glm::vec3{dual}, dual.w}};
+}
+
+glm::vec3 DualQuat::translation() const
+{
+	glm::vec4 realConjugate{-glm::vec3{real}, real.w};
+	return 2.0f * glm::vec3{quatProduct(dual, realConjugate)};
+}
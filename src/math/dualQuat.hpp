@@ -0,0 +1,16 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct DualQuat
+{
+	glm::vec4 real{0, 0, 0, 1};
+	glm::vec4 dual{0, 0, 0, 0};
+
+	static DualQuat fromRigid(const glm::vec4& rotation, const glm::vec3& translation);
+	static DualQuat product(const DualQuat& dq1, const DualQuat& dq2);
+	static glm::vec4 quatProduct(const glm::vec4& q1, const glm::vec4& q2);
+
+	DualQuat conjugate() const;
+	glm::vec3 translation() const;
+};
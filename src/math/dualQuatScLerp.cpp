@@ -0,0 +1,125 @@
+#include "math/dualQuatScLerp.hpp"
+
+#include "math/sinCos.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+static constexpr float angleEpsilon = 1e-6f;
+static constexpr std::size_t batchSize = 64;
+
+DualQuatScLerp::DualQuatScLerp(const DualQuat& start, const DualQuat& end)
+{
+	float startNorm = glm::length(start.real);
+	float endNorm = glm::length(end.real);
+	m_start = {start.real / startNorm, start.dual / startNorm};
+	DualQuat normalizedEnd{end.real / endNorm, end.dual / endNorm};
+	if (glm::dot(m_start.real, normalizedEnd.real) < 0)
+	{
+		normalizedEnd = {-normalizedEnd.real, -normalizedEnd.dual};
+	}
+
+	DualQuat relative = DualQuat::product(m_start.conjugate(), normalizedEnd);
+	glm::vec3 relativeV = relative.real;
+	glm::vec3 translation = relative.translation();
+	float halfSine = glm::length(relativeV);
+	m_halfAngle = std::atan2(halfSine, relative.real.w);
+
+	glm::vec3 axis{};
+	glm::vec3 moment{};
+	glm::vec3 axisPoint{};
+	if (halfSine > angleEpsilon)
+	{
+		axis = relativeV / halfSine;
+		float pitch = glm::dot(translation, axis);
+		glm::vec3 perpendicular = translation - pitch * axis;
+		moment = 0.5f * (glm::cross(translation, axis) +
+			perpendicular * relative.real.w / halfSine);
+		axisPoint = 0.5f * (perpendicular +
+			glm::cross(axis, perpendicular) * relative.real.w / halfSine);
+		m_halfPitch = 0.5f * pitch;
+	}
+	else
+	{
+		m_halfAngle = 0;
+		float pitch = glm::length(translation);
+		axis = pitch > 0 ? translation / pitch : glm::vec3{0, 0, 0};
+		m_halfPitch = 0.5f * pitch;
+	}
+
+	m_realSine = DualQuat::quatProduct(m_start.real, glm::vec4{axis, 0});
+	m_dualSine = DualQuat::quatProduct(m_start.real, glm::vec4{moment, 0}) +
+		DualQuat::quatProduct(m_start.dual, glm::vec4{axis, 0});
+
+	glm::vec4 startConjugate{-glm::vec3{m_start.real}, m_start.real.w};
+	glm::vec3 worldAxis = DualQuat::quatProduct(m_realSine, startConjugate);
+	glm::vec3 worldAxisPoint =
+		DualQuat::quatProduct(DualQuat::quatProduct(m_start.real, glm::vec4{axisPoint, 0}),
+		startConjugate);
+	m_angularVelocity = 2 * m_halfAngle * worldAxis;
+	m_axisPoint = m_start.translation() + worldAxisPoint;
+	m_axisVelocity = 2 * m_halfPitch * worldAxis;
+}
+
+DualQuat DualQuatScLerp::interpolate(float t) const
+{
+	float halfSine{};
+	float halfCosine{};
+	sinCos(t * m_halfAngle, halfSine, halfCosine);
+	return interpolate(t, halfSine, halfCosine);
+}
+
+void DualQuatScLerp::interpolate(const float* t, DualQuat* dualQuats, std::size_t count) const
+{
+	std::array<float, batchSize> halfAngles{};
+	std::array<float, batchSize> halfSines{};
+	std::array<float, batchSize> halfCosines{};
+
+	for (std::size_t begin = 0; begin < count; begin += batchSize)
+	{
+		std::size_t size = std::min(batchSize, count - begin);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			halfAngles[i] = t[begin + i] * m_halfAngle;
+		}
+
+		sinCos(halfAngles.data(), halfSines.data(), halfCosines.data(), size);
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			dualQuats[begin + i] = interpolate(t[begin + i], halfSines[i], halfCosines[i]);
+		}
+	}
+}
+
+float DualQuatScLerp::getAngle() const
+{
+	return 2 * m_halfAngle;
+}
+
+float DualQuatScLerp::getPitch() const
+{
+	return 2 * m_halfPitch;
+}
+
+glm::vec3 DualQuatScLerp::getAngularVelocity() const
+{
+	return m_angularVelocity;
+}
+
+glm::vec3 DualQuatScLerp::getLinearVelocity(const glm::vec3& pos) const
+{
+	return glm::cross(m_angularVelocity, pos - m_axisPoint) + m_axisVelocity;
+}
+
+DualQuat DualQuatScLerp::interpolate(float t, float halfSine, float halfCosine) const
+{
+	float halfDisplacement = t * m_halfPitch;
+	return
+	{
+		halfSine * m_realSine + halfCosine * m_start.real,
+		halfSine * m_dualSine + halfCosine * m_start.dual +
+			halfDisplacement * (halfCosine * m_realSine - halfSine * m_start.real)
+	};
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "math/dualQuat.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+class DualQuatScLerp
+{
+public:
+	DualQuatScLerp(const DualQuat& start, const DualQuat& end);
+
+	DualQuat interpolate(float t) const;
+	void interpolate(const float* t, DualQuat* dualQuats, std::size_t count) const;
+
+	float getAngle() const;
+	float getPitch() const;
+	glm::vec3 getAngularVelocity() const;
+	glm::vec3 getLinearVelocity(const glm::vec3& pos) const;
+
+private:
+	DualQuat m_start{};
+	glm::vec4 m_realSine{};
+	glm::vec4 m_dualSine{};
+	float m_halfAngle{};
+	float m_halfPitch{};
+	glm::vec3 m_angularVelocity{};
+	glm::vec3 m_axisPoint{};
+	glm::vec3 m_axisVelocity{};
+
+	DualQuat interpolate(float t, float halfSine, float halfCosine) const;
+};
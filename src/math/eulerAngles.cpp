@@ -0,0 +1,53 @@
+#include "math/eulerAngles.hpp"
+
+namespace EulerAngles
+{
+	template <EulerOrder... orders>
+	struct DispatchTable
+	{
+		static constexpr std::array<glm::vec4 (*)(const glm::vec3&), eulerOrderCount> toQuat
+		{
+			&EulerAngles::toQuat<orders>...
+		};
+
+		static constexpr std::array<glm::vec3 (*)(const glm::vec4&), eulerOrderCount> fromQuat
+		{
+			&EulerAngles::fromQuat<orders>...
+		};
+
+		static constexpr std::array<glm::mat3 (*)(const glm::vec3&), eulerOrderCount> toMatrix
+		{
+			&EulerAngles::toMatrix<orders>...
+		};
+
+		static constexpr std::array<void (*)(const glm::vec3*, glm::vec4*, std::size_t),
+			eulerOrderCount> toQuats
+		{
+			&EulerAngles::toQuats<orders>...
+		};
+	};
+
+	using Dispatch = DispatchTable<EulerOrder::xyz, EulerOrder::xzy, EulerOrder::yxz,
+		EulerOrder::yzx, EulerOrder::zxy, EulerOrder::zyx, EulerOrder::xyx, EulerOrder::xzx,
+		EulerOrder::yxy, EulerOrder::yzy, EulerOrder::zxz, EulerOrder::zyz>;
+
+	glm::vec4 toQuat(EulerOrder order, const glm::vec3& angles)
+	{
+		return Dispatch::toQuat[static_cast<int>(order)](angles);
+	}
+
+	glm::vec3 fromQuat(EulerOrder order, const glm::vec4& quat)
+	{
+		return Dispatch::fromQuat[static_cast<int>(order)](quat);
+	}
+
+	glm::mat3 toMatrix(EulerOrder order, const glm::vec3& angles)
+	{
+		return Dispatch::toMatrix[static_cast<int>(order)](angles);
+	}
+
+	void toQuats(EulerOrder order, const glm::vec3* angles, glm::vec4* quats, std::size_t count)
+	{
+		Dispatch::toQuats[static_cast<int>(order)](angles, quats, count);
+	}
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "math/eulerOrder.hpp"
+#include "math/sinCos.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace EulerAngles
+{
+	template <EulerOrder order>
+	struct Axes
+	{
+		static constexpr std::array<std::array<int, 3>, eulerOrderCount> sequences
+		{{
+			{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0},
+			{0, 1, 0}, {0, 2, 0}, {1, 0, 1}, {1, 2, 1}, {2, 0, 2}, {2, 1, 2}
+		}};
+
+		static constexpr int first = sequences[static_cast<int>(order)][0];
+		static constexpr int second = sequences[static_cast<int>(order)][1];
+		static constexpr int third = sequences[static_cast<int>(order)][2];
+		static constexpr bool proper = first == third;
+		static constexpr int remaining = 3 - first - second;
+		static constexpr float parity =
+			(first - second) * (second - remaining) * (remaining - first) / 2;
+	};
+
+	template <EulerOrder order>
+	glm::vec4 toQuat(const glm::vec3& halfSines, const glm::vec3& halfCosines);
+	template <EulerOrder order>
+	glm::vec4 toQuat(const glm::vec3& angles);
+	template <EulerOrder order>
+	glm::vec3 fromQuat(const glm::vec4& quat);
+	template <EulerOrder order>
+	glm::mat3 toMatrix(const glm::vec3& sines, const glm::vec3& cosines);
+	template <EulerOrder order>
+	glm::mat3 toMatrix(const glm::vec3& angles);
+
+	template <EulerOrder order>
+	void toQuats(const glm::vec3* angles, glm::vec4* quats, std::size_t count);
+	template <EulerOrder order>
+	void toMatrices(const glm::vec3* angles, glm::mat3* matrices, std::size_t count);
+
+	glm::vec4 toQuat(EulerOrder order, const glm::vec3& angles);
+	glm::vec3 fromQuat(EulerOrder order, const glm::vec4& quat);
+	glm::mat3 toMatrix(EulerOrder order, const glm::vec3& angles);
+	void toQuats(EulerOrder order, const glm::vec3* angles, glm::vec4* quats, std::size_t count);
+
+	inline constexpr std::size_t batchSize = 64;
+
+	template <EulerOrder order>
+	glm::vec4 toQuat(const glm::vec3& halfSines, const glm::vec3& halfCosines)
+	{
+		using A = Axes<order>;
+
+		float s1 = halfSines[0];
+		float s2 = halfSines[1];
+		float s3 = halfSines[2];
+		float c1 = halfCosines[0];
+		float c2 = halfCosines[1];
+		float c3 = halfCosines[2];
+
+		glm::vec4 quat{};
+		if constexpr (A::proper)
+		{
+			quat[A::first] = c2 * (c3 * s1 + s3 * c1);
+			quat[A::second] = s2 * (c3 * c1 + s3 * s1);
+			quat[A::remaining] = A::parity * s2 * (s3 * c1 - c3 * s1);
+			quat.w = c2 * (c3 * c1 - s3 * s1);
+		}
+		else
+		{
+			quat[A::first] = c3 * s1 * c2 - A::parity * s3 * c1 * s2;
+			quat[A::second] = c3 * c1 * s2 + A::parity * s3 * s1 * c2;
+			quat[A::third] = s3 * c1 * c2 - A::parity * c3 * s1 * s2;
+			quat.w = c3 * c1 * c2 + A::parity * s3 * s1 * s2;
+		}
+		return quat;
+	}
+
+	template <EulerOrder order>
+	glm::vec4 toQuat(const glm::vec3& angles)
+	{
+		glm::vec3 halfSines{};
+		glm::vec3 halfCosines{};
+		for (int i = 0; i < 3; ++i)
+		{
+			sinCos(0.5f * angles[i], halfSines[i], halfCosines[i]);
+		}
+		return toQuat<order>(halfSines, halfCosines);
+	}
+
+	template <EulerOrder order>
+	glm::vec3 fromQuat(const glm::vec4& quat)
+	{
+		using A = Axes<order>;
+		static constexpr float pi = glm::pi<float>();
+		static constexpr float singularityEpsilon = 1e-6f;
+
+		float a{};
+		float b{};
+		float c{};
+		float d{};
+		if constexpr (A::proper)
+		{
+			a = quat.w;
+			b = quat[A::first];
+			c = quat[A::second];
+			d = A::parity * quat[A::remaining];
+		}
+		else
+		{
+			a = quat.w - quat[A::second];
+			b = quat[A::first] + A::parity * quat[A::third];
+			c = quat[A::second] + quat.w;
+			d = A::parity * quat[A::third] - quat[A::first];
+		}
+
+		glm::vec3 angles{};
+		angles[1] = 2 * std::atan2(std::hypot(c, d), std::hypot(a, b));
+		float halfSum = std::atan2(b, a);
+		float halfDifference = std::atan2(d, c);
+
+		if (std::abs(angles[1]) < singularityEpsilon)
+		{
+			angles[0] = 2 * halfSum;
+		}
+		else if (std::abs(angles[1] - pi) < singularityEpsilon)
+		{
+			angles[0] = -2 * halfDifference;
+		}
+		else
+		{
+			angles[0] = halfSum - halfDifference;
+			angles[2] = halfSum + halfDifference;
+		}
+
+		if constexpr (!A::proper)
+		{
+			angles[2] *= A::parity;
+			angles[1] -= pi / 2;
+		}
+
+		for (int i = 0; i < 3; ++i)
+		{
+			if (angles[i] > pi)
+			{
+				angles[i] -= 2 * pi;
+			}
+			else if (angles[i] < -pi)
+			{
+				angles[i] += 2 * pi;
+			}
+		}
+		return angles;
+	}
+
+	template <EulerOrder order>
+	glm::mat3 toMatrix(const glm::vec3& sines, const glm::vec3& cosines)
+	{
+		using A = Axes<order>;
+		static constexpr int i = A::first;
+		static constexpr int j = A::second;
+		static constexpr int k = A::remaining;
+		static constexpr float p = A::parity;
+
+		float si = p * sines[0];
+		float sj = p * sines[1];
+		float sh = p * sines[2];
+		float ci = cosines[0];
+		float cj = cosines[1];
+		float ch = cosines[2];
+		float cc = ci * ch;
+		float cs = ci * sh;
+		float sc = si * ch;
+		float ss = si * sh;
+
+		glm::mat3 matrix{};
+		if constexpr (A::proper)
+		{
+			matrix[i][i] = cj;
+			matrix[j][i] = sj * si;
+			matrix[k][i] = sj * ci;
+			matrix[i][j] = sj * sh;
+			matrix[j][j] = -cj * ss + cc;
+			matrix[k][j] = -cj * cs - sc;
+			matrix[i][k] = -sj * ch;
+			matrix[j][k] = cj * sc + cs;
+			matrix[k][k] = cj * cc - ss;
+		}
+		else
+		{
+			matrix[i][i] = cj * ch;
+			matrix[j][i] = sj * sc - cs;
+			matrix[k][i] = sj * cc + ss;
+			matrix[i][j] = cj * sh;
+			matrix[j][j] = sj * ss + cc;
+			matrix[k][j] = sj * cs - sc;
+			matrix[i][k] = -sj;
+			matrix[j][k] = cj * si;
+			matrix[k][k] = cj * ci;
+		}
+		return matrix;
+	}
+
+	template <EulerOrder order>
+	glm::mat3 toMatrix(const glm::vec3& angles)
+	{
+		glm::vec3 sines{};
+		glm::vec3 cosines{};
+		for (int i = 0; i < 3; ++i)
+		{
+			sinCos(angles[i], sines[i], cosines[i]);
+		}
+		return toMatrix<order>(sines, cosines);
+	}
+
+	template <EulerOrder order>
+	void toQuats(const glm::vec3* angles, glm::vec4* quats, std::size_t count)
+	{
+		std::array<float, 3 * batchSize> halfAngles{};
+		std::array<float, 3 * batchSize> halfSines{};
+		std::array<float, 3 * batchSize> halfCosines{};
+
+		for (std::size_t begin = 0; begin < count; begin += batchSize)
+		{
+			std::size_t size = std::min(batchSize, count - begin);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					halfAngles[axis * size + i] = 0.5f * angles[begin + i][axis];
+				}
+			}
+
+			sinCos(halfAngles.data(), halfSines.data(), halfCosines.data(), 3 * size);
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				quats[begin + i] = toQuat<order>(
+					{halfSines[i], halfSines[size + i], halfSines[2 * size + i]},
+					{halfCosines[i], halfCosines[size + i], halfCosines[2 * size + i]});
+			}
+		}
+	}
+
+	template <EulerOrder order>
+	void toMatrices(const glm::vec3* angles, glm::mat3* matrices, std::size_t count)
+	{
+		std::array<float, 3 * batchSize> flatAngles{};
+		std::array<float, 3 * batchSize> sines{};
+		std::array<float, 3 * batchSize> cosines{};
+
+		for (std::size_t begin = 0; begin < count; begin += batchSize)
+		{
+			std::size_t size = std::min(batchSize, count - begin);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					flatAngles[axis * size + i] = angles[begin + i][axis];
+				}
+			}
+
+			sinCos(flatAngles.data(), sines.data(), cosines.data(), 3 * size);
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				matrices[begin + i] = toMatrix<order>(
+					{sines[i], sines[size + i], sines[2 * size + i]},
+					{cosines[i], cosines[size + i], cosines[2 * size + i]});
+			}
+		}
+	}
+}
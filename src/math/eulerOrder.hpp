@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class EulerOrder
+{
+	xyz,
+	xzy,
+	yxz,
+	yzx,
+	zxy,
+	zyx,
+	xyx,
+	xzx,
+	yxy,
+	yzy,
+	zxz,
+	zyz
+};
+
+inline constexpr int eulerOrderCount = 12;
+
+inline const std::array<std::string, eulerOrderCount> eulerOrderLabels
+{
+	"XYZ",
+	"XZY",
+	"YXZ",
+	"YZX",
+	"ZXY",
+	"ZYX",
+	"XYX",
+	"XZX",
+	"YXY",
+	"YZY",
+	"ZXZ",
+	"ZYZ"
+};
@@ -0,0 +1,137 @@
+#include "math/fastSlerp.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+static constexpr int termCount = 6;
+static constexpr double lastTermCorrection = 1.83372;
+
+static constexpr std::array<float, termCount> uCoefficients = []
+{
+	std::array<float, termCount> u{};
+	for (int i = 1; i <= termCount; ++i)
+	{
+		double correction = i == termCount ? lastTermCorrection : 1.0;
+		u[i - 1] = static_cast<float>(correction / (i * (2.0 * i + 1)));
+	}
+	return u;
+}();
+
+static constexpr std::array<float, termCount> vCoefficients = []
+{
+	std::array<float, termCount> v{};
+	for (int i = 1; i <= termCount; ++i)
+	{
+		double correction = i == termCount ? lastTermCorrection : 1.0;
+		v[i - 1] = static_cast<float>(correction * i / (2.0 * i + 1));
+	}
+	return v;
+}();
+
+FastSlerp::FastSlerp(const glm::vec4& start, const glm::vec4& end) :
+	m_start{glm::normalize(start)},
+	m_end{glm::normalize(end)}
+{
+	glm::vec4 sum = m_start + m_end;
+	float sumLength = glm::length(sum);
+	if (sumLength < 1e-6f)
+	{
+		m_mid = m_start;
+		m_end = m_start;
+	}
+	else
+	{
+		m_mid = sum / sumLength;
+	}
+	m_halfCosMinusOne = glm::dot(m_start, m_mid) - 1;
+}
+
+glm::vec4 FastSlerp::interpolate(float t) const
+{
+	float s = 2 * t;
+	bool secondHalf = s > 1;
+	return interpolateHalf(secondHalf ? m_mid : m_start, secondHalf ? m_end : m_mid,
+		secondHalf ? s - 1 : s);
+}
+
+void FastSlerp::interpolate(const float* t, glm::vec4* quats, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		quats[i] = interpolate(t[i]);
+	}
+}
+
+FastSlerpAccuracy FastSlerp::measureAccuracy(int angleSteps, int tSteps, int axisCount)
+{
+	FastSlerpAccuracy accuracy{};
+
+	for (int axisIndex = 0; axisIndex < axisCount; ++axisIndex)
+	{
+		double z = 1 - 2 * (axisIndex + 0.5) / axisCount;
+		double azimuth = axisIndex * glm::pi<double>() * (3 - std::sqrt(5.0));
+		double radius = std::sqrt(1 - z * z);
+		glm::dvec3 axis{radius * std::cos(azimuth), radius * std::sin(azimuth), z};
+
+		for (int angleIndex = 0; angleIndex < angleSteps; ++angleIndex)
+		{
+			double halfAngle = (glm::pi<double>() - antipodalMargin) * angleIndex / angleSteps;
+			glm::vec4 startFloat{0, 0, 0, 1};
+			glm::vec4 endFloat{glm::dvec4{std::sin(halfAngle) * axis, std::cos(halfAngle)}};
+			FastSlerp slerp{startFloat, endFloat};
+
+			glm::dvec4 start{startFloat};
+			glm::dvec4 end = glm::normalize(glm::dvec4{endFloat});
+			double angle = std::atan2(glm::length(glm::dvec3{end}), end.w);
+
+			for (int tIndex = 0; tIndex <= tSteps; ++tIndex)
+			{
+				double t = static_cast<double>(tIndex) / tSteps;
+				glm::dvec4 exact = angle == 0 ? start :
+					(std::sin((1 - t) * angle) * start + std::sin(t * angle) * end) /
+					std::sin(angle);
+				glm::dvec4 approx{slerp.interpolate(static_cast<float>(t))};
+
+				double approxLength = glm::length(approx);
+				glm::dvec4 approxUnit = approx / approxLength;
+				glm::dvec3 relativeV = exact.w * glm::dvec3{approxUnit} -
+					approxUnit.w * glm::dvec3{exact} -
+					glm::cross(glm::dvec3{exact}, glm::dvec3{approxUnit});
+				double relativeW = glm::dot(exact, approxUnit);
+				double error = 2 * std::atan2(glm::length(relativeV), std::abs(relativeW));
+
+				if (error > accuracy.maxAngularError)
+				{
+					accuracy.maxAngularError = error;
+					accuracy.worstAngle = 2 * angle;
+					accuracy.worstT = t;
+				}
+				accuracy.maxNormError =
+					std::max(accuracy.maxNormError, std::abs(approxLength - 1));
+				++accuracy.sampleCount;
+			}
+		}
+	}
+
+	return accuracy;
+}
+
+glm::vec4 FastSlerp::interpolateHalf(const glm::vec4& start, const glm::vec4& end, float t) const
+{
+	return coefficient(1 - t, m_halfCosMinusOne) * start +
+		coefficient(t, m_halfCosMinusOne) * end;
+}
+
+float FastSlerp::coefficient(float t, float cosMinusOne)
+{
+	float tt = t * t;
+	float result = 1;
+	for (int i = termCount - 1; i >= 0; --i)
+	{
+		result = 1 + (uCoefficients[i] * tt - vCoefficients[i]) * cosMinusOne * result;
+	}
+	return t * result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+struct FastSlerpAccuracy
+{
+	double maxAngularError{};
+	double maxNormError{};
+	double worstAngle{};
+	double worstT{};
+	std::size_t sampleCount{};
+};
+
+class FastSlerp
+{
+public:
+	static constexpr float maxAngularError = 1e-4f;
+	static constexpr float antipodalMargin = 1e-2f;
+
+	FastSlerp(const glm::vec4& start, const glm::vec4& end);
+
+	glm::vec4 interpolate(float t) const;
+	void interpolate(const float* t, glm::vec4* quats, std::size_t count) const;
+
+	static FastSlerpAccuracy measureAccuracy(int angleSteps, int tSteps, int axisCount);
+
+private:
+	glm::vec4 m_start{};
+	glm::vec4 m_mid{};
+	glm::vec4 m_end{};
+	float m_halfCosMinusOne{};
+
+	glm::vec4 interpolateHalf(const glm::vec4& start, const glm::vec4& end, float t) const;
+	static float coefficient(float t, float cosMinusOne);
+};
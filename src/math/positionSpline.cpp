@@ -0,0 +1,300 @@
+#include "math/positionSpline.hpp"
+
+#include <algorithm>
+#include <array>
+
+static constexpr int arcLengthSubsteps = 4;
+static constexpr std::size_t evaluateChunkSize = 256;
+
+static void evaluateRun(float a, float b, float c, float d, const float* u, float* out,
+	std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = ((a * u[i] + b) * u[i] + c) * u[i] + d;
+	}
+}
+
+static void evaluateDerivativeRun(float a, float b, float c, const float* u, const float* rates,
+	float* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = ((3.0f * a * u[i] + 2.0f * b) * u[i] + c) * rates[i];
+	}
+}
+
+PositionSpline::PositionSpline(PositionCurveType type, const std::vector<PositionKey>& keys,
+	bool constantSpeed)
+{
+	update(type, keys, constantSpeed);
+}
+
+void PositionSpline::update(PositionCurveType type, const std::vector<PositionKey>& keys,
+	bool constantSpeed)
+{
+	m_segments.clear();
+	m_arcLengthTable.clear();
+	std::size_t last = keys.size() - 1;
+	switch (type)
+	{
+		case PositionCurveType::linear:
+			for (std::size_t i = 0; i < last; ++i)
+			{
+				glm::vec3 direction = keys[i + 1].pos - keys[i].pos;
+				addHermiteSegment(keys[i].pos, keys[i + 1].pos, direction, direction);
+			}
+			break;
+
+		case PositionCurveType::catmullRom:
+			for (std::size_t i = 0; i < last; ++i)
+			{
+				glm::vec3 m0 = i == 0 ? keys[1].pos - keys[0].pos :
+					0.5f * (keys[i + 1].pos - keys[i - 1].pos);
+				glm::vec3 m1 = i + 1 == last ? keys[last].pos - keys[last - 1].pos :
+					0.5f * (keys[i + 2].pos - keys[i].pos);
+				addHermiteSegment(keys[i].pos, keys[i + 1].pos, m0, m1);
+			}
+			break;
+
+		case PositionCurveType::hermite:
+			for (std::size_t i = 0; i < last; ++i)
+			{
+				addHermiteSegment(keys[i].pos, keys[i + 1].pos, keys[i].tangent,
+					keys[i + 1].tangent);
+			}
+			break;
+
+		case PositionCurveType::bezier:
+		{
+			std::size_t i = 0;
+			for (; i + 3 <= last; i += 3)
+			{
+				addBezierSegment(keys[i].pos, keys[i + 1].pos, keys[i + 2].pos, keys[i + 3].pos);
+			}
+			if (i + 2 == last)
+			{
+				const glm::vec3& p0 = keys[i].pos;
+				const glm::vec3& p1 = keys[i + 1].pos;
+				const glm::vec3& p2 = keys[i + 2].pos;
+				addBezierSegment(p0, p0 + 2.0f / 3.0f * (p1 - p0), p2 + 2.0f / 3.0f * (p1 - p2),
+					p2);
+			}
+			else if (i + 1 == last)
+			{
+				glm::vec3 direction = keys[i + 1].pos - keys[i].pos;
+				addHermiteSegment(keys[i].pos, keys[i + 1].pos, direction, direction);
+			}
+			break;
+		}
+	}
+
+	if (constantSpeed)
+	{
+		buildArcLengthTable();
+	}
+}
+
+glm::vec3 PositionSpline::evaluate(float t) const
+{
+	return evaluateUniform(reparameterize(t));
+}
+
+glm::vec3 PositionSpline::evaluate(float t, glm::vec3& velocity) const
+{
+	float rate{};
+	glm::vec3 pos = evaluateUniform(reparameterize(t, rate), velocity);
+	velocity *= rate;
+	return pos;
+}
+
+void PositionSpline::evaluate(const float* t, glm::vec3* positions, std::size_t count) const
+{
+	std::array<int, evaluateChunkSize> indices{};
+	std::array<float, evaluateChunkSize> u{};
+	std::array<std::array<float, evaluateChunkSize>, 3> pos{};
+	for (std::size_t begin = 0; begin < count; begin += evaluateChunkSize)
+	{
+		std::size_t size = std::min(evaluateChunkSize, count - begin);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			locate(reparameterize(t[begin + i]), indices[i], u[i]);
+		}
+		for (std::size_t runBegin = 0; runBegin < size;)
+		{
+			std::size_t runEnd = runBegin + 1;
+			while (runEnd < size && indices[runEnd] == indices[runBegin])
+			{
+				++runEnd;
+			}
+			const Segment& segment = m_segments[indices[runBegin]];
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				evaluateRun(segment.a[axis], segment.b[axis], segment.c[axis], segment.d[axis],
+					u.data() + runBegin, pos[axis].data() + runBegin, runEnd - runBegin);
+			}
+			runBegin = runEnd;
+		}
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			positions[begin + i] = {pos[0][i], pos[1][i], pos[2][i]};
+		}
+	}
+}
+
+void PositionSpline::evaluate(const float* t, glm::vec3* positions, glm::vec3* velocities,
+	std::size_t count) const
+{
+	float segmentCount = static_cast<float>(m_segments.size());
+	std::array<int, evaluateChunkSize> indices{};
+	std::array<float, evaluateChunkSize> u{};
+	std::array<float, evaluateChunkSize> rates{};
+	std::array<std::array<float, evaluateChunkSize>, 3> pos{};
+	std::array<std::array<float, evaluateChunkSize>, 3> vel{};
+	for (std::size_t begin = 0; begin < count; begin += evaluateChunkSize)
+	{
+		std::size_t size = std::min(evaluateChunkSize, count - begin);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			locate(reparameterize(t[begin + i], rates[i]), indices[i], u[i]);
+			rates[i] *= segmentCount;
+		}
+		for (std::size_t runBegin = 0; runBegin < size;)
+		{
+			std::size_t runEnd = runBegin + 1;
+			while (runEnd < size && indices[runEnd] == indices[runBegin])
+			{
+				++runEnd;
+			}
+			const Segment& segment = m_segments[indices[runBegin]];
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				evaluateRun(segment.a[axis], segment.b[axis], segment.c[axis], segment.d[axis],
+					u.data() + runBegin, pos[axis].data() + runBegin, runEnd - runBegin);
+				evaluateDerivativeRun(segment.a[axis], segment.b[axis], segment.c[axis],
+					u.data() + runBegin, rates.data() + runBegin, vel[axis].data() + runBegin,
+					runEnd - runBegin);
+			}
+			runBegin = runEnd;
+		}
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			positions[begin + i] = {pos[0][i], pos[1][i], pos[2][i]};
+			velocities[begin + i] = {vel[0][i], vel[1][i], vel[2][i]};
+		}
+	}
+}
+
+void PositionSpline::addHermiteSegment(const glm::vec3& p0, const glm::vec3& p1,
+	const glm::vec3& m0, const glm::vec3& m1)
+{
+	m_segments.push_back
+	({
+		2.0f * p0 - 2.0f * p1 + m0 + m1,
+		-3.0f * p0 + 3.0f * p1 - 2.0f * m0 - m1,
+		m0,
+		p0
+	});
+}
+
+void PositionSpline::addBezierSegment(const glm::vec3& p0, const glm::vec3& p1,
+	const glm::vec3& p2, const glm::vec3& p3)
+{
+	m_segments.push_back
+	({
+		-p0 + 3.0f * p1 - 3.0f * p2 + p3,
+		3.0f * p0 - 6.0f * p1 + 3.0f * p2,
+		-3.0f * p0 + 3.0f * p1,
+		p0
+	});
+}
+
+void PositionSpline::buildArcLengthTable()
+{
+	int sampleCount = arcLengthTableSize * arcLengthSubsteps;
+	std::vector<float> lengths(sampleCount + 1);
+	glm::vec3 prevPos = evaluateUniform(0);
+	for (int i = 1; i <= sampleCount; ++i)
+	{
+		glm::vec3 pos = evaluateUniform(static_cast<float>(i) / sampleCount);
+		lengths[i] = lengths[i - 1] + glm::length(pos - prevPos);
+		prevPos = pos;
+	}
+	float totalLength = lengths.back();
+	if (totalLength <= 0)
+	{
+		return;
+	}
+
+	m_arcLengthTable.resize(arcLengthTableSize);
+	int sample = 0;
+	for (int i = 0; i < arcLengthTableSize; ++i)
+	{
+		float length = totalLength * i / (arcLengthTableSize - 1);
+		while (sample < sampleCount - 1 && lengths[sample + 1] < length)
+		{
+			++sample;
+		}
+		float segmentLength = lengths[sample + 1] - lengths[sample];
+		float fraction = segmentLength > 0 ?
+			std::clamp((length - lengths[sample]) / segmentLength, 0.0f, 1.0f) : 0.0f;
+		m_arcLengthTable[i] = (sample + fraction) / sampleCount;
+	}
+}
+
+float PositionSpline::reparameterize(float t) const
+{
+	if (m_arcLengthTable.empty())
+	{
+		return t;
+	}
+
+	float x = std::clamp(t, 0.0f, 1.0f) * (arcLengthTableSize - 1);
+	int index = std::min(static_cast<int>(x), arcLengthTableSize - 2);
+	float fraction = x - static_cast<float>(index);
+	return m_arcLengthTable[index] +
+		(m_arcLengthTable[index + 1] - m_arcLengthTable[index]) * fraction;
+}
+
+float PositionSpline::reparameterize(float t, float& rate) const
+{
+	if (m_arcLengthTable.empty())
+	{
+		rate = 1;
+		return t;
+	}
+
+	float x = std::clamp(t, 0.0f, 1.0f) * (arcLengthTableSize - 1);
+	int index = std::min(static_cast<int>(x), arcLengthTableSize - 2);
+	float fraction = x - static_cast<float>(index);
+	float step = m_arcLengthTable[index + 1] - m_arcLengthTable[index];
+	rate = step * (arcLengthTableSize - 1);
+	return m_arcLengthTable[index] + step * fraction;
+}
+
+void PositionSpline::locate(float t, int& index, float& u) const
+{
+	float x = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(m_segments.size());
+	index = std::min(static_cast<int>(x), static_cast<int>(m_segments.size()) - 1);
+	u = x - static_cast<float>(index);
+}
+
+glm::vec3 PositionSpline::evaluateUniform(float t) const
+{
+	int index{};
+	float u{};
+	locate(t, index, u);
+	const Segment& segment = m_segments[index];
+	return ((segment.a * u + segment.b) * u + segment.c) * u + segment.d;
+}
+
+glm::vec3 PositionSpline::evaluateUniform(float t, glm::vec3& velocity) const
+{
+	int index{};
+	float u{};
+	locate(t, index, u);
+	const Segment& segment = m_segments[index];
+	float segmentCount = static_cast<float>(m_segments.size());
+	velocity = ((3.0f * segment.a * u + 2.0f * segment.b) * u + segment.c) * segmentCount;
+	return ((segment.a * u + segment.b) * u + segment.c) * u + segment.d;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+struct PositionKey
+{
+	glm::vec3 pos{};
+	glm::vec3 tangent{};
+};
+
+class PositionSpline
+{
+public:
+	static constexpr int arcLengthTableSize = 256;
+
+	PositionSpline() = default;
+	PositionSpline(PositionCurveType type, const std::vector<PositionKey>& keys,
+		bool constantSpeed);
+
+	void update(PositionCurveType type, const std::vector<PositionKey>& keys,
+		bool constantSpeed);
+
+	glm::vec3 evaluate(float t) const;
+	glm::vec3 evaluate(float t, glm::vec3& velocity) const;
+	void evaluate(const float* t, glm::vec3* positions, std::size_t count) const;
+	void evaluate(const float* t, glm::vec3* positions, glm::vec3* velocities,
+		std::size_t count) const;
+
+private:
+	struct Segment
+	{
+		glm::vec3 a{};
+		glm::vec3 b{};
+		glm::vec3 c{};
+		glm::vec3 d{};
+	};
+
+	std::vector<Segment> m_segments{};
+	std::vector<float> m_arcLengthTable{};
+
+	void addHermiteSegment(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& m0,
+		const glm::vec3& m1);
+	void addBezierSegment(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2,
+		const glm::vec3& p3);
+	void buildArcLengthTable();
+	float reparameterize(float t) const;
+	float reparameterize(float t, float& rate) const;
+	void locate(float t, int& index, float& u) const;
+	glm::vec3 evaluateUniform(float t) const;
+	glm::vec3 evaluateUniform(float t, glm::vec3& velocity) const;
+};
@@ -0,0 +1,41 @@
+#include "math/sinCos.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+static constexpr float twoOverPi = 0.636619772367581343f;
+static constexpr float halfPi1 = 1.5703125f;
+static constexpr float halfPi2 = 4.837512969970703125e-4f;
+static constexpr float halfPi3 = 7.54978995489188216e-8f;
+
+static inline void sinCosKernel(float angle, float& sine, float& cosine)
+{
+	float quadrant = std::nearbyint(angle * twoOverPi);
+	float x = ((angle - quadrant * halfPi1) - quadrant * halfPi2) - quadrant * halfPi3;
+	float xx = x * x;
+
+	float sinX = x + x * xx *
+		(-1.6666654611e-1f + xx * (8.3321608736e-3f + xx * -1.9515295891e-4f));
+	float cosX = 1 - 0.5f * xx + xx * xx *
+		(4.166664568298827e-2f + xx * (-1.388731625493765e-3f + xx * 2.443315711809948e-5f));
+
+	std::int32_t q = static_cast<std::int32_t>(quadrant);
+	bool swap = (q & 1) != 0;
+	float sinValue = swap ? cosX : sinX;
+	float cosValue = swap ? sinX : cosX;
+	sine = (q & 2) != 0 ? -sinValue : sinValue;
+	cosine = ((q + 1) & 2) != 0 ? -cosValue : cosValue;
+}
+
+void sinCos(float angle, float& sine, float& cosine)
+{
+	sinCosKernel(angle, sine, cosine);
+}
+
+void sinCos(const float* angles, float* sines, float* cosines, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		sinCosKernel(angles[i], sines[i], cosines[i]);
+	}
+}
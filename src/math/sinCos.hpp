@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstddef>
+
+void sinCos(float angle, float& sine, float& cosine);
+void sinCos(const float* angles, float* sines, float* cosines, std::size_t count);
@@ -0,0 +1,158 @@
+#include "math/timeWarp.hpp"
+
+#include <algorithm>
+
+static constexpr int bezierBisectionSteps = 24;
+
+TimeWarp::TimeWarp(const TimeWarpSettings& settings) :
+	m_settings{settings}
+{
+	m_settings.bezierStart.x = std::clamp(m_settings.bezierStart.x, 0.0f, 1.0f);
+	m_settings.bezierEnd.x = std::clamp(m_settings.bezierEnd.x, 0.0f, 1.0f);
+	for (int i = 0; i <= tableSize; ++i)
+	{
+		m_table[i] = evaluate(m_settings, static_cast<float>(i) / tableSize);
+	}
+}
+
+const TimeWarpSettings& TimeWarp::getSettings() const
+{
+	return m_settings;
+}
+
+float TimeWarp::warp(float t) const
+{
+	return m_settings.type == TimeWarpType::linear ? std::clamp(t, 0.0f, 1.0f) : lookUp(t);
+}
+
+float TimeWarp::warp(float t, float& rate) const
+{
+	if (m_settings.type == TimeWarpType::linear)
+	{
+		rate = 1;
+		return std::clamp(t, 0.0f, 1.0f);
+	}
+	return lookUp(t, rate);
+}
+
+void TimeWarp::warp(const float* t, float* warped, std::size_t count) const
+{
+	if (m_settings.type == TimeWarpType::linear)
+	{
+		std::transform(t, t + count, warped,
+			[] (float value) { return std::clamp(value, 0.0f, 1.0f); });
+		return;
+	}
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		warped[i] = lookUp(t[i]);
+	}
+}
+
+void TimeWarp::warp(const float* t, float* warped, float* rates, std::size_t count) const
+{
+	if (m_settings.type == TimeWarpType::linear)
+	{
+		std::transform(t, t + count, warped,
+			[] (float value) { return std::clamp(value, 0.0f, 1.0f); });
+		std::fill(rates, rates + count, 1.0f);
+		return;
+	}
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		warped[i] = lookUp(t[i], rates[i]);
+	}
+}
+
+float TimeWarp::lookUp(float t) const
+{
+	float x = std::clamp(t, 0.0f, 1.0f) * tableSize;
+	int index = std::min(static_cast<int>(x), tableSize - 1);
+	float fraction = x - static_cast<float>(index);
+	return m_table[index] + (m_table[index + 1] - m_table[index]) * fraction;
+}
+
+float TimeWarp::lookUp(float t, float& rate) const
+{
+	float x = std::clamp(t, 0.0f, 1.0f) * tableSize;
+	int index = std::min(static_cast<int>(x), tableSize - 1);
+	float fraction = x - static_cast<float>(index);
+	float step = m_table[index + 1] - m_table[index];
+	rate = step * tableSize;
+	return m_table[index] + step * fraction;
+}
+
+float TimeWarp::evaluate(const TimeWarpSettings& settings, float t)
+{
+	switch (settings.type)
+	{
+		case TimeWarpType::linear:
+			return t;
+
+		case TimeWarpType::easeIn:
+			return t * t * t;
+
+		case TimeWarpType::easeOut:
+			return 1 - (1 - t) * (1 - t) * (1 - t);
+
+		case TimeWarpType::easeInOut:
+			return t < 0.5f ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+
+		case TimeWarpType::cubicBezier:
+			return evaluateBezier(settings.bezierStart, settings.bezierEnd, t);
+
+		case TimeWarpType::piecewise:
+			return evaluatePiecewise(settings.knots, t);
+	}
+	return t;
+}
+
+float TimeWarp::evaluateBezier(const glm::vec2& p1, const glm::vec2& p2, float t)
+{
+	auto bezier = [] (float a, float b, float s)
+	{
+		float r = 1 - s;
+		return 3 * r * r * s * a + 3 * r * s * s * b + s * s * s;
+	};
+
+	float low = 0;
+	float high = 1;
+	for (int step = 0; step < bezierBisectionSteps; ++step)
+	{
+		float mid = 0.5f * (low + high);
+		(bezier(p1.x, p2.x, mid) < t ? low : high) = mid;
+	}
+	return bezier(p1.y, p2.y, 0.5f * (low + high));
+}
+
+float TimeWarp::evaluatePiecewise(const std::array<float, TimeWarpSettings::knotCount>& knots,
+	float t)
+{
+	constexpr int segmentCount = TimeWarpSettings::knotCount - 1;
+	constexpr float spacing = 1.0f / segmentCount;
+
+	std::array<float, segmentCount> slopes{};
+	for (int i = 0; i < segmentCount; ++i)
+	{
+		slopes[i] = (knots[i + 1] - knots[i]) / spacing;
+	}
+	std::array<float, TimeWarpSettings::knotCount> tangents{};
+	tangents.front() = slopes.front();
+	tangents.back() = slopes.back();
+	for (int i = 1; i < segmentCount; ++i)
+	{
+		float product = slopes[i - 1] * slopes[i];
+		tangents[i] = product > 0 ? 2 * product / (slopes[i - 1] + slopes[i]) : 0;
+	}
+
+	int segment = std::clamp(static_cast<int>(t / spacing), 0, segmentCount - 1);
+	float u = (t - segment * spacing) / spacing;
+	float u2 = u * u;
+	float u3 = u2 * u;
+	return (2 * u3 - 3 * u2 + 1) * knots[segment] +
+		(u3 - 2 * u2 + u) * spacing * tangents[segment] +
+		(-2 * u3 + 3 * u2) * knots[segment + 1] +
+		(u3 - u2) * spacing * tangents[segment + 1];
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "timeWarpType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+
+struct TimeWarpSettings
+{
+	static constexpr int knotCount = 5;
+
+	TimeWarpType type = TimeWarpType::linear;
+	glm::vec2 bezierStart{0.42f, 0};
+	glm::vec2 bezierEnd{0.58f, 1};
+	std::array<float, knotCount> knots{0, 0.25f, 0.5f, 0.75f, 1};
+
+	bool operator==(const TimeWarpSettings&) const = default;
+};
+
+class TimeWarp
+{
+public:
+	static constexpr int tableSize = 256;
+
+	TimeWarp() = default;
+	TimeWarp(const TimeWarpSettings& settings);
+
+	const TimeWarpSettings& getSettings() const;
+	float warp(float t) const;
+	float warp(float t, float& rate) const;
+	void warp(const float* t, float* warped, std::size_t count) const;
+	void warp(const float* t, float* warped, float* rates, std::size_t count) const;
+
+private:
+	TimeWarpSettings m_settings{};
+	std::array<float, tableSize + 1> m_table{};
+
+	float lookUp(float t) const;
+	float lookUp(float t, float& rate) const;
+	static float evaluate(const TimeWarpSettings& settings, float t);
+	static float evaluateBezier(const glm::vec2& p1, const glm::vec2& p2, float t);
+	static float evaluatePiecewise(const std::array<float, TimeWarpSettings::knotCount>& knots,
+		float t);
+};
@@ -0,0 +1,331 @@
+#include "memory/allocationTracker.hpp"
+
+#include "profiling/zoneTimer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+
+struct ZoneCounters
+{
+	std::atomic<std::uint64_t> allocationCount{};
+	std::atomic<std::uint64_t> deallocationCount{};
+	std::atomic<std::uint64_t> allocatedBytes{};
+	std::atomic<std::uint64_t> deallocatedBytes{};
+};
+
+struct alignas(alignof(std::max_align_t)) AllocationHeader
+{
+	void* block{};
+	std::size_t size{};
+	AllocationZone zone{};
+};
+
+static std::array<ZoneCounters, allocationZoneCount> zoneCounters{};
+static thread_local AllocationZone currentZone = AllocationZone::other;
+
+static AllocationStats stats{};
+static std::array<AllocationCounts, allocationZoneCount> frameStartCounts{};
+static int playingFrameCount = 0;
+static bool reportViolations = false;
+
+static AllocationCounts operator-(const AllocationCounts& counts, const AllocationCounts& start);
+static AllocationCounts& operator+=(AllocationCounts& counts, const AllocationCounts& other);
+static void reportSteadyStateViolation(const AllocationFrameStats& frame);
+
+namespace AllocationTracker
+{
+	bool isEnabled()
+	{
+#ifdef MOTION_INTERPOLATION_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	AllocationZone getZone()
+	{
+		return currentZone;
+	}
+
+	AllocationZone setZone(AllocationZone zone)
+	{
+		AllocationZone prevZone = currentZone;
+		currentZone = zone;
+		ZoneTimer::switchZone(zone);
+		return prevZone;
+	}
+
+	AllocationCounts getCounts(AllocationZone zone)
+	{
+		const ZoneCounters& counters = zoneCounters[static_cast<int>(zone)];
+		return
+			{
+				counters.allocationCount.load(std::memory_order_relaxed),
+				counters.deallocationCount.load(std::memory_order_relaxed),
+				counters.allocatedBytes.load(std::memory_order_relaxed),
+				counters.deallocatedBytes.load(std::memory_order_relaxed)
+			};
+	}
+
+	void endFrame(bool playing)
+	{
+		AllocationFrameStats frame{};
+		for (int zone = 0; zone < allocationZoneCount; ++zone)
+		{
+			AllocationCounts counts = getCounts(static_cast<AllocationZone>(zone));
+			frame.zones[zone] = counts - frameStartCounts[zone];
+			frame.total += frame.zones[zone];
+			frameStartCounts[zone] = counts;
+			stats.liveBytes[zone] = counts.allocatedBytes - counts.deallocatedBytes;
+		}
+
+		playingFrameCount = playing ? playingFrameCount + 1 : 0;
+		frame.steadyState = playingFrameCount > steadyStateWarmUpFrames;
+
+		stats.lastFrame = frame;
+		if (frame.total.allocationCount > stats.peakFrame.total.allocationCount)
+		{
+			stats.peakFrame = frame;
+		}
+		++stats.frameCount;
+		if (!frame.steadyState)
+		{
+			return;
+		}
+
+		++stats.steadyStateFrameCount;
+		if (frame.total.allocationCount > 0)
+		{
+			++stats.steadyStateViolationCount;
+			if (reportViolations)
+			{
+				reportSteadyStateViolation(frame);
+			}
+		}
+	}
+
+	const AllocationStats& getStats()
+	{
+		return stats;
+	}
+
+	void resetStats()
+	{
+		std::array<std::uint64_t, allocationZoneCount> liveBytes = stats.liveBytes;
+		stats = AllocationStats{};
+		stats.liveBytes = liveBytes;
+	}
+
+	bool getReportSteadyStateViolations()
+	{
+		return reportViolations;
+	}
+
+	void setReportSteadyStateViolations(bool report)
+	{
+		reportViolations = report;
+	}
+}
+
+AllocationZoneScope::AllocationZoneScope(AllocationZone zone) :
+	m_prevZone{AllocationTracker::setZone(zone)}
+{ }
+
+AllocationZoneScope::~AllocationZoneScope()
+{
+	AllocationTracker::setZone(m_prevZone);
+}
+
+AllocationCounts operator-(const AllocationCounts& counts, const AllocationCounts& start)
+{
+	return
+		{
+			counts.allocationCount - start.allocationCount,
+			counts.deallocationCount - start.deallocationCount,
+			counts.allocatedBytes - start.allocatedBytes,
+			counts.deallocatedBytes - start.deallocatedBytes
+		};
+}
+
+AllocationCounts& operator+=(AllocationCounts& counts, const AllocationCounts& other)
+{
+	counts.allocationCount += other.allocationCount;
+	counts.deallocationCount += other.deallocationCount;
+	counts.allocatedBytes += other.allocatedBytes;
+	counts.deallocatedBytes += other.deallocatedBytes;
+	return counts;
+}
+
+void reportSteadyStateViolation(const AllocationFrameStats& frame)
+{
+	std::cerr << "Steady-state allocations: " << frame.total.allocationCount << " ("
+		<< frame.total.allocatedBytes << " B)";
+	for (int zone = 0; zone < allocationZoneCount; ++zone)
+	{
+		if (frame.zones[zone].allocationCount > 0)
+		{
+			std::cerr << ", " << allocationZoneLabels[zone] << ' '
+				<< frame.zones[zone].allocationCount;
+		}
+	}
+	std::cerr << '\n';
+}
+
+#ifdef MOTION_INTERPOLATION_TRACK_ALLOCATIONS
+static void* allocate(std::size_t size, std::size_t alignment = alignof(AllocationHeader))
+{
+	alignment = std::max(alignment, alignof(AllocationHeader));
+	std::size_t overhead = sizeof(AllocationHeader) +
+		(alignment > alignof(AllocationHeader) ? alignment : 0);
+	if (size > std::numeric_limits<std::size_t>::max() - overhead)
+	{
+		return nullptr;
+	}
+	void* block = std::malloc(overhead + size);
+	if (block == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block) + sizeof(AllocationHeader);
+	address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+	AllocationHeader* header = new (reinterpret_cast<AllocationHeader*>(address) - 1)
+		AllocationHeader{block, size, currentZone};
+	ZoneCounters& counters = zoneCounters[static_cast<int>(header->zone)];
+	counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+	counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	return header + 1;
+}
+
+static void deallocate(void* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+	ZoneCounters& counters = zoneCounters[static_cast<int>(header->zone)];
+	counters.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+	counters.deallocatedBytes.fetch_add(header->size, std::memory_order_relaxed);
+	std::free(header->block);
+}
+
+static void* allocateOrThrow(std::size_t size,
+	std::size_t alignment = alignof(AllocationHeader))
+{
+	void* ptr = allocate(size, alignment);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc{};
+	}
+	return ptr;
+}
+
+void* operator new(std::size_t size)
+{
+	return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+	const std::nothrow_t&) noexcept
+{
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	deallocate(ptr);
+}
+#endif
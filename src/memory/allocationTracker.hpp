@@ -0,0 +1,63 @@
+#pragma once
+
+#include "memory/allocationZone.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+struct AllocationCounts
+{
+	std::uint64_t allocationCount{};
+	std::uint64_t deallocationCount{};
+	std::uint64_t allocatedBytes{};
+	std::uint64_t deallocatedBytes{};
+};
+
+struct AllocationFrameStats
+{
+	std::array<AllocationCounts, allocationZoneCount> zones{};
+	AllocationCounts total{};
+	bool steadyState{};
+};
+
+struct AllocationStats
+{
+	AllocationFrameStats lastFrame{};
+	AllocationFrameStats peakFrame{};
+	std::array<std::uint64_t, allocationZoneCount> liveBytes{};
+	std::uint64_t frameCount{};
+	std::uint64_t steadyStateFrameCount{};
+	std::uint64_t steadyStateViolationCount{};
+};
+
+namespace AllocationTracker
+{
+	inline constexpr int steadyStateWarmUpFrames = 3;
+
+	bool isEnabled();
+	AllocationZone getZone();
+	AllocationZone setZone(AllocationZone zone);
+	AllocationCounts getCounts(AllocationZone zone);
+
+	void endFrame(bool playing);
+	const AllocationStats& getStats();
+	void resetStats();
+	bool getReportSteadyStateViolations();
+	void setReportSteadyStateViolations(bool report);
+}
+
+class AllocationZoneScope
+{
+public:
+	AllocationZoneScope(AllocationZone zone);
+	AllocationZoneScope(const AllocationZoneScope&) = delete;
+	AllocationZoneScope(AllocationZoneScope&&) = delete;
+	~AllocationZoneScope();
+
+	AllocationZoneScope& operator=(const AllocationZoneScope&) = delete;
+	AllocationZoneScope& operator=(AllocationZoneScope&&) = delete;
+
+private:
+	AllocationZone m_prevZone{};
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class AllocationZone
+{
+	other,
+	gui,
+	commands,
+	interpolation,
+	skeletons,
+	rendering,
+	sampling,
+	clips
+};
+
+inline constexpr int allocationZoneCount = 8;
+
+inline const std::array<std::string, allocationZoneCount> allocationZoneLabels
+{
+	"Other",
+	"GUI",
+	"Commands",
+	"Interpolation",
+	"Skeletons",
+	"Rendering",
+	"Sampling",
+	"Clips"
+};
@@ -0,0 +1,30 @@
+#include "memory/glResourceTracker.hpp"
+
+#include <array>
+
+static std::array<GLResourceUsage, glResourceTypeCount> usages{};
+
+namespace GLResourceTracker
+{
+	void add(GLResourceType type, std::int64_t count, std::int64_t byteSize)
+	{
+		GLResourceUsage& usage = usages[static_cast<int>(type)];
+		usage.count += count;
+		usage.byteSize += byteSize;
+	}
+
+	void remove(GLResourceType type, std::int64_t count, std::int64_t byteSize)
+	{
+		add(type, -count, -byteSize);
+	}
+
+	void resize(GLResourceType type, std::int64_t prevByteSize, std::int64_t byteSize)
+	{
+		add(type, 0, byteSize - prevByteSize);
+	}
+
+	GLResourceUsage getUsage(GLResourceType type)
+	{
+		return usages[static_cast<int>(type)];
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "memory/glResourceType.hpp"
+
+#include <cstdint>
+
+struct GLResourceUsage
+{
+	std::int64_t count{};
+	std::int64_t byteSize{};
+};
+
+namespace GLResourceTracker
+{
+	void add(GLResourceType type, std::int64_t count = 1, std::int64_t byteSize = 0);
+	void remove(GLResourceType type, std::int64_t count = 1, std::int64_t byteSize = 0);
+	void resize(GLResourceType type, std::int64_t prevByteSize, std::int64_t byteSize);
+	GLResourceUsage getUsage(GLResourceType type);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class GLResourceType
+{
+	framebuffer,
+	texture,
+	renderbuffer,
+	vertexArray,
+	buffer,
+	program,
+	query
+};
+
+inline constexpr int glResourceTypeCount = 7;
+
+inline const std::array<std::string, glResourceTypeCount> glResourceTypeLabels
+{
+	"Framebuffers",
+	"Textures",
+	"Renderbuffers",
+	"Vertex arrays",
+	"Buffers",
+	"Programs",
+	"Queries"
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct MemoryUsage
+{
+	const char* name{};
+	std::size_t byteSize{};
+};
+
+template <typename T>
+std::size_t capacityBytes(const std::vector<T>& vector)
+{
+	return vector.capacity() * sizeof(T);
+}
@@ -0,0 +1,169 @@
+#include "motionBlur.hpp"
+
+#include "memory/glResourceTracker.hpp"
+#include "shaderPrograms.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+static constexpr float underBudgetRatio = 0.75f;
+
+MotionBlur::MotionBlur()
+{
+	glGenVertexArrays(1, &m_VAO);
+	glGenBuffers(1, &m_VBO);
+	glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+	GLResourceTracker::add(GLResourceType::vertexArray);
+	GLResourceTracker::add(GLResourceType::buffer);
+	GLResourceTracker::add(GLResourceType::query, static_cast<std::int64_t>(m_queries.size()));
+
+	glBindVertexArray(m_VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	for (int column = 0; column < 4; ++column)
+	{
+		glVertexAttribPointer(column, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+			reinterpret_cast<void*>(offsetof(Instance, modelMatrix) + column * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(column);
+		glVertexAttribDivisor(column, 1);
+	}
+	glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(Instance),
+		reinterpret_cast<void*>(offsetof(Instance, alpha)));
+	glEnableVertexAttribArray(4);
+	glVertexAttribDivisor(4, 1);
+	glBindVertexArray(0);
+}
+
+MotionBlur::~MotionBlur()
+{
+	glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteVertexArrays(1, &m_VAO);
+	GLResourceTracker::remove(GLResourceType::query, static_cast<std::int64_t>(m_queries.size()));
+	GLResourceTracker::remove(GLResourceType::buffer, 1,
+		static_cast<std::int64_t>(m_bufferCapacity * sizeof(Instance)));
+	GLResourceTracker::remove(GLResourceType::vertexArray);
+}
+
+MotionBlurSettings MotionBlur::getSettings() const
+{
+	return m_settings;
+}
+
+void MotionBlur::setSettings(const MotionBlurSettings& settings)
+{
+	m_settings = settings;
+	m_settings.maxSubFrameCount =
+		std::clamp(m_settings.maxSubFrameCount, minSubFrameCount, subFrameCountLimit);
+	m_subFrameCount = std::min(m_subFrameCount, m_settings.maxSubFrameCount);
+}
+
+int MotionBlur::getSubFrameCount() const
+{
+	return m_subFrameCount;
+}
+
+float MotionBlur::getFrameMs() const
+{
+	return m_frameMs;
+}
+
+std::size_t MotionBlur::getByteSize() const
+{
+	return m_subFrameTimes.capacity() * sizeof(float) + m_instances.capacity() * sizeof(Instance);
+}
+
+void MotionBlur::beginFrame()
+{
+	m_frameStart = std::chrono::steady_clock::now();
+
+	unsigned int query = m_queries[m_query];
+	if (m_queriesPending[m_query])
+	{
+		GLint available{};
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available)
+		{
+			GLuint64 elapsedNs{};
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+			m_gpuMs = static_cast<float>(elapsedNs) * 1e-6f;
+		}
+	}
+	glBeginQuery(GL_TIME_ELAPSED, query);
+	m_queriesPending[m_query] = true;
+}
+
+void MotionBlur::endFrame()
+{
+	glEndQuery(GL_TIME_ELAPSED);
+	m_query = (m_query + 1) % static_cast<int>(m_queries.size());
+
+	float cpuMs = std::chrono::duration<float, std::milli>(
+		std::chrono::steady_clock::now() - m_frameStart).count();
+	m_frameMs = std::max(cpuMs, m_gpuMs);
+	updateSubFrameCount(m_frameMs);
+}
+
+const std::vector<float>& MotionBlur::getSubFrameTimes(float time, float frameInterval)
+{
+	float shutterInterval = m_settings.shutter * std::max(frameInterval, 0.0f);
+	m_subFrameTimes.resize(static_cast<std::size_t>(m_subFrameCount));
+	for (int i = 0; i < m_subFrameCount; ++i)
+	{
+		float offset = static_cast<float>(m_subFrameCount - 1 - i) / (m_subFrameCount - 1);
+		m_subFrameTimes[i] = std::max(time - shutterInterval * offset, 0.0f);
+	}
+	return m_subFrameTimes;
+}
+
+void MotionBlur::render(Renderer& renderer, const glm::mat4* modelMatrices,
+	std::size_t count)
+{
+	m_instances.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		m_instances[i].modelMatrix = modelMatrices[i];
+		m_instances[i].alpha = static_cast<float>(i + 1) / count;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	if (count > m_bufferCapacity)
+	{
+		std::size_t capacity = std::max(count, 2 * m_bufferCapacity);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(Instance)),
+			nullptr, GL_STREAM_DRAW);
+		GLResourceTracker::resize(GLResourceType::buffer,
+			static_cast<std::int64_t>(m_bufferCapacity * sizeof(Instance)),
+			static_cast<std::int64_t>(capacity * sizeof(Instance)));
+		m_bufferCapacity = capacity;
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(Instance)),
+		m_instances.data());
+
+	DrawCommand command{};
+	command.pass = RenderPass::transparent;
+	command.program = ShaderPrograms::motionBlur.get();
+	command.VAO = m_VAO;
+	command.lineWidth = 5.0f;
+	command.depthWrite = false;
+	command.mode = GL_POINTS;
+	command.count = 1;
+	command.instanceCount = static_cast<int>(count);
+	renderer.submit(command);
+}
+
+void MotionBlur::updateSubFrameCount(float frameMs)
+{
+	if (frameMs > m_settings.budgetMs)
+	{
+		m_subFrameCount = m_subFrameCount * 3 / 4;
+	}
+	else if (frameMs < underBudgetRatio * m_settings.budgetMs)
+	{
+		m_subFrameCount += std::max(m_subFrameCount / 8, 1);
+	}
+	m_subFrameCount = std::clamp(m_subFrameCount, minSubFrameCount,
+		m_settings.maxSubFrameCount);
+}
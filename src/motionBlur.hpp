@@ -0,0 +1,65 @@
+#pragma once
+
+#include "render/renderer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+struct MotionBlurSettings
+{
+	float shutter = 0.5f;
+	float budgetMs = 4.0f;
+	int maxSubFrameCount = 64;
+
+	bool operator==(const MotionBlurSettings&) const = default;
+};
+
+class MotionBlur
+{
+public:
+	static constexpr int minSubFrameCount = 2;
+	static constexpr int subFrameCountLimit = 256;
+
+	MotionBlur();
+	~MotionBlur();
+
+	MotionBlurSettings getSettings() const;
+	void setSettings(const MotionBlurSettings& settings);
+	int getSubFrameCount() const;
+	float getFrameMs() const;
+	std::size_t getByteSize() const;
+
+	void beginFrame();
+	void endFrame();
+	const std::vector<float>& getSubFrameTimes(float time, float frameInterval);
+	void render(Renderer& renderer, const glm::mat4* modelMatrices, std::size_t count);
+
+private:
+	struct Instance
+	{
+		glm::mat4 modelMatrix{};
+		float alpha{};
+	};
+
+	MotionBlurSettings m_settings{};
+	int m_subFrameCount = minSubFrameCount;
+	float m_frameMs{};
+
+	unsigned int m_VAO{};
+	unsigned int m_VBO{};
+	std::size_t m_bufferCapacity{};
+	std::array<unsigned int, 2> m_queries{};
+	std::array<bool, 2> m_queriesPending{};
+	int m_query{};
+	float m_gpuMs{};
+	std::chrono::steady_clock::time_point m_frameStart{};
+
+	std::vector<float> m_subFrameTimes{};
+	std::vector<Instance> m_instances{};
+
+	void updateSubFrameCount(float frameMs);
+};
@@ -6,14 +6,11 @@ Plane::Plane(float scale) :
 	m_scale{scale}
 { }
 
-void Plane::render() const
+void Plane::render(Renderer& renderer) const
 {
-	updateShaders();
-	m_quad.render();
-}
-
-void Plane::updateShaders() const
-{
-	ShaderPrograms::plane->use();
-	ShaderPrograms::plane->setUniform("scale", m_scale);
+	DrawCommand command{};
+	command.pass = RenderPass::transparent;
+	command.program = ShaderPrograms::plane.get();
+	command.setUniform("scale", m_scale);
+	m_quad.render(renderer, command);
 }
@@ -1,16 +1,15 @@
 #pragma once
 
 #include "quad.hpp"
+#include "render/renderer.hpp"
 
 class Plane
 {
 public:
 	Plane(float scale);
-	void render() const;
+	void render(Renderer& renderer) const;
 
 private:
 	float m_scale{};
 	Quad m_quad{};
-
-	void updateShaders() const;
 };
@@ -0,0 +1,168 @@
+#include "poseCache.hpp"
+
+#include "concurrency/parallelFor.hpp"
+#include "frame.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr std::size_t grainSize = 1024;
+
+static glm::vec4 getQuat(const QuatSamples& quats, std::size_t index)
+{
+	return {quats.x[index], quats.y[index], quats.z[index], quats.w[index]};
+}
+
+void PoseCache::bake(const Interpolator& interpolator, std::uint64_t version)
+{
+	m_version = version;
+	m_endTime = interpolator.getEndTime();
+	m_sampleCount = std::max<std::size_t>(
+		static_cast<std::size_t>(std::ceil(m_endTime * samplesPerSecond)) + 1, 2);
+
+	std::vector<float> times(m_sampleCount);
+	for (std::size_t i = 0; i < m_sampleCount; ++i)
+	{
+		times[i] = getSampleTime(i);
+	}
+
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		m_rotations[type].x.resize(m_sampleCount);
+		m_rotations[type].y.resize(m_sampleCount);
+		m_rotations[type].z.resize(m_sampleCount);
+		m_rotations[type].w.resize(m_sampleCount);
+		m_translations[type].resize(m_sampleCount);
+		m_velocities[type].resize(m_sampleCount);
+	}
+	for (int type = 0; type < positionCurveTypeCount; ++type)
+	{
+		m_positions[type].resize(m_sampleCount);
+		m_positionVelocities[type].resize(m_sampleCount);
+	}
+
+	parallelFor(m_sampleCount, grainSize,
+		[&] (std::size_t begin, std::size_t end)
+		{
+			std::vector<glm::mat4> modelMatrices(end - begin);
+			for (int type = 0; type < interpolationTypeCount; ++type)
+			{
+				interpolator.interpolateModelMatrices(static_cast<InterpolationType>(type),
+					PositionCurveType::linear, times.data() + begin, modelMatrices.data(),
+					end - begin, m_velocities[type].data() + begin);
+				QuatSamples& rotations = m_rotations[type];
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const glm::mat4& modelMatrix = modelMatrices[i - begin];
+					glm::vec4 rotation = Frame::rotationMatrixToQuat(modelMatrix);
+					if (i > begin && glm::dot(rotation, getQuat(rotations, i - 1)) < 0)
+					{
+						rotation = -rotation;
+					}
+					rotations.x[i] = rotation.x;
+					rotations.y[i] = rotation.y;
+					rotations.z[i] = rotation.z;
+					rotations.w[i] = rotation.w;
+					m_translations[type][i] = modelMatrix[3];
+				}
+			}
+
+			for (int type = 0; type < positionCurveTypeCount; ++type)
+			{
+				interpolator.interpolatePositions(static_cast<PositionCurveType>(type),
+					times.data() + begin, m_positions[type].data() + begin, end - begin,
+					m_positionVelocities[type].data() + begin);
+			}
+		});
+}
+
+std::uint64_t PoseCache::getVersion() const
+{
+	return m_version;
+}
+
+std::size_t PoseCache::getSampleCount() const
+{
+	return m_sampleCount;
+}
+
+std::size_t PoseCache::getByteSize() const
+{
+	return m_sampleCount *
+		(interpolationTypeCount * (sizeof(glm::vec4) + sizeof(glm::vec3) + sizeof(PoseVelocity)) +
+		positionCurveTypeCount * 2 * sizeof(glm::vec3));
+}
+
+float PoseCache::getSampleTime(std::size_t index) const
+{
+	return std::min(static_cast<float>(index) / samplesPerSecond, m_endTime);
+}
+
+const QuatSamples& PoseCache::getRotations(InterpolationType type) const
+{
+	return m_rotations[static_cast<int>(type)];
+}
+
+glm::mat4 PoseCache::modelMatrix(InterpolationType type, float time) const
+{
+	Lookup sample = lookup(time);
+	const QuatSamples& rotations = m_rotations[static_cast<int>(type)];
+	const std::vector<glm::vec3>& translations = m_translations[static_cast<int>(type)];
+
+	glm::vec4 prevRotation = getQuat(rotations, sample.index);
+	glm::vec4 nextRotation = getQuat(rotations, sample.index + 1);
+	if (glm::dot(prevRotation, nextRotation) < 0)
+	{
+		nextRotation = -nextRotation;
+	}
+	glm::vec4 rotation =
+		glm::normalize(prevRotation + (nextRotation - prevRotation) * sample.fraction);
+	glm::vec3 translation = translations[sample.index] +
+		(translations[sample.index + 1] - translations[sample.index]) * sample.fraction;
+
+	return Frame::modelMatrix(translation, Frame::quatToRotationMatrix(rotation));
+}
+
+PoseVelocity PoseCache::velocity(InterpolationType type, float time) const
+{
+	Lookup sample = lookup(time);
+	const PoseVelocity& prev = m_velocities[static_cast<int>(type)][sample.index];
+	const PoseVelocity& next = m_velocities[static_cast<int>(type)][sample.index + 1];
+	return
+		{
+			prev.linear + (next.linear - prev.linear) * sample.fraction,
+			prev.angular + (next.angular - prev.angular) * sample.fraction
+		};
+}
+
+glm::vec3 PoseCache::position(PositionCurveType type, float time) const
+{
+	Lookup sample = lookup(time);
+	const std::vector<glm::vec3>& positions = m_positions[static_cast<int>(type)];
+	return positions[sample.index] +
+		(positions[sample.index + 1] - positions[sample.index]) * sample.fraction;
+}
+
+glm::vec3 PoseCache::positionVelocity(PositionCurveType type, float time) const
+{
+	Lookup sample = lookup(time);
+	const std::vector<glm::vec3>& velocities = m_positionVelocities[static_cast<int>(type)];
+	return velocities[sample.index] +
+		(velocities[sample.index + 1] - velocities[sample.index]) * sample.fraction;
+}
+
+PoseCache::Lookup PoseCache::lookup(float time) const
+{
+	if (m_sampleCount < 2)
+	{
+		return {};
+	}
+
+	float x = std::clamp(time, 0.0f, m_endTime) * samplesPerSecond;
+	std::size_t index = std::min(static_cast<std::size_t>(x), m_sampleCount - 2);
+	float prevTime = getSampleTime(index);
+	float nextTime = getSampleTime(index + 1);
+	float fraction = nextTime > prevTime ?
+		std::clamp((time - prevTime) / (nextTime - prevTime), 0.0f, 1.0f) : 0.0f;
+	return {index, fraction};
+}
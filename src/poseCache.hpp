@@ -0,0 +1,65 @@
+#pragma once
+
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct PoseCacheInfo
+{
+	bool valid{};
+	std::uint64_t version{};
+	std::size_t sampleCount{};
+	std::size_t byteSize{};
+};
+
+struct QuatSamples
+{
+	std::vector<float> x{};
+	std::vector<float> y{};
+	std::vector<float> z{};
+	std::vector<float> w{};
+};
+
+class PoseCache
+{
+public:
+	static constexpr int samplesPerSecond = 120;
+
+	void bake(const Interpolator& interpolator, std::uint64_t version);
+
+	std::uint64_t getVersion() const;
+	std::size_t getSampleCount() const;
+	std::size_t getByteSize() const;
+	float getSampleTime(std::size_t index) const;
+	const QuatSamples& getRotations(InterpolationType type) const;
+
+	glm::mat4 modelMatrix(InterpolationType type, float time) const;
+	PoseVelocity velocity(InterpolationType type, float time) const;
+	glm::vec3 position(PositionCurveType type, float time) const;
+	glm::vec3 positionVelocity(PositionCurveType type, float time) const;
+
+private:
+	struct Lookup
+	{
+		std::size_t index{};
+		float fraction{};
+	};
+
+	std::uint64_t m_version{};
+	float m_endTime{};
+	std::size_t m_sampleCount{};
+	std::array<QuatSamples, interpolationTypeCount> m_rotations{};
+	std::array<std::vector<glm::vec3>, interpolationTypeCount> m_translations{};
+	std::array<std::vector<PoseVelocity>, interpolationTypeCount> m_velocities{};
+	std::array<std::vector<glm::vec3>, positionCurveTypeCount> m_positions{};
+	std::array<std::vector<glm::vec3>, positionCurveTypeCount> m_positionVelocities{};
+
+	Lookup lookup(float time) const;
+};
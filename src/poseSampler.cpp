@@ -0,0 +1,213 @@
+#include "poseSampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+
+static constexpr int seedIntervalCount = 8;
+static constexpr float minIntervalFraction = 1e-5f;
+static constexpr float minTolerance = 1e-4f;
+
+PoseSampler::PoseSampler(const Interpolator& interpolator, const SamplingSettings& settings) :
+	m_interpolator{interpolator},
+	m_settings{settings}
+{
+	m_settings.budget =
+		std::clamp(m_settings.budget, SamplingSettings::minBudget, SamplingSettings::maxBudget);
+	m_settings.angularTolerance = std::max(m_settings.angularTolerance, minTolerance);
+	m_settings.positionalTolerance = std::max(m_settings.positionalTolerance, minTolerance);
+}
+
+void PoseSampler::sample(InterpolationType type, PoseSamples& samples,
+	PoseSamplerScratch& scratch) const
+{
+	if (m_settings.adaptive)
+	{
+		sampleAdaptive(type, samples, scratch);
+	}
+	else
+	{
+		sampleUniform(type, samples, scratch);
+	}
+}
+
+void PoseSampler::sampleUniform(InterpolationType type, PoseSamples& samples,
+	PoseSamplerScratch& scratch) const
+{
+	std::size_t count = static_cast<std::size_t>(m_settings.budget);
+	float dTime = m_interpolator.getEndTime() / (count - 1);
+	samples.times.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		samples.times[i] = i * dTime;
+	}
+	evaluate(type, samples, scratch.ts);
+}
+
+void PoseSampler::sampleAdaptive(InterpolationType type, PoseSamples& samples,
+	PoseSamplerScratch& scratch) const
+{
+	std::size_t budget = static_cast<std::size_t>(m_settings.budget);
+	float endTime = m_interpolator.getEndTime();
+	float minInterval = minIntervalFraction * endTime;
+
+	std::size_t seedCount = std::min<std::size_t>(budget, seedIntervalCount + 1);
+	samples.times.resize(seedCount);
+	for (std::size_t i = 0; i < seedCount; ++i)
+	{
+		samples.times[i] = endTime * i / (seedCount - 1);
+	}
+	evaluate(type, samples, scratch.ts);
+
+	std::vector<float>& errors = scratch.errors;
+	errors.resize(seedCount - 1);
+	for (std::size_t i = 0; i < errors.size(); ++i)
+	{
+		errors[i] = intervalError(type, samples, i);
+	}
+
+	std::vector<std::pair<float, std::size_t>>& candidates = scratch.candidates;
+	std::vector<std::size_t>& intervals = scratch.intervals;
+	PoseSamples& midpoints = scratch.midpoints;
+	while (samples.times.size() < budget)
+	{
+		candidates.clear();
+		for (std::size_t i = 0; i < errors.size(); ++i)
+		{
+			if (errors[i] > 1 && samples.times[i + 1] - samples.times[i] > minInterval)
+			{
+				candidates.push_back({errors[i], i});
+			}
+		}
+		if (candidates.empty())
+		{
+			break;
+		}
+
+		std::size_t remaining = budget - samples.times.size();
+		if (candidates.size() > remaining)
+		{
+			std::nth_element(candidates.begin(), candidates.begin() + remaining,
+				candidates.end(), std::greater<>{});
+			candidates.resize(remaining);
+		}
+
+		intervals.clear();
+		for (const auto& [error, interval] : candidates)
+		{
+			intervals.push_back(interval);
+		}
+		std::sort(intervals.begin(), intervals.end());
+
+		midpoints.times.resize(intervals.size());
+		for (std::size_t i = 0; i < intervals.size(); ++i)
+		{
+			midpoints.times[i] =
+				0.5f * (samples.times[intervals[i]] + samples.times[intervals[i] + 1]);
+		}
+		evaluate(type, midpoints, scratch.ts);
+		merge(samples, errors, midpoints, intervals);
+		for (std::size_t interval : intervals)
+		{
+			errors[interval] = intervalError(type, samples, interval);
+			errors[interval + 1] = intervalError(type, samples, interval + 1);
+		}
+	}
+}
+
+void PoseSampler::evaluate(InterpolationType type, PoseSamples& samples,
+	std::vector<float>& ts) const
+{
+	std::size_t count = samples.times.size();
+	samples.modelMatrices.resize(count);
+	for (std::vector<glm::vec3>& positions : samples.positions)
+	{
+		positions.resize(count);
+	}
+
+	m_interpolator.interpolateModelMatrices(type, PositionCurveType::linear,
+		samples.times.data(), samples.modelMatrices.data(), count);
+	ts.resize(count);
+	m_interpolator.warpTimes(samples.times.data(), ts.data(), count);
+	for (int curve = 0; curve < positionCurveTypeCount; ++curve)
+	{
+		m_interpolator.getPositionSpline(static_cast<PositionCurveType>(curve)).evaluate(
+			ts.data(), samples.positions[curve].data(), count);
+	}
+}
+
+float PoseSampler::intervalError(InterpolationType type, const PoseSamples& samples,
+	std::size_t index) const
+{
+	const glm::mat4& prev = samples.modelMatrices[index];
+	const glm::mat4& next = samples.modelMatrices[index + 1];
+
+	float trace = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		trace += glm::dot(glm::vec3{prev[i]}, glm::vec3{next[i]});
+	}
+	float angle = std::acos(std::clamp((trace - 1) / 2, -1.0f, 1.0f));
+
+	float distance = 0;
+	if (interpolatesPos(type))
+	{
+		distance = glm::length(glm::vec3{next[3]} - glm::vec3{prev[3]});
+	}
+	else
+	{
+		for (const std::vector<glm::vec3>& positions : samples.positions)
+		{
+			distance = std::max(distance, glm::length(positions[index + 1] - positions[index]));
+		}
+	}
+
+	return std::max(angle / m_settings.angularTolerance,
+		distance / m_settings.positionalTolerance);
+}
+
+void PoseSampler::merge(PoseSamples& samples, std::vector<float>& errors,
+	const PoseSamples& midpoints, std::vector<std::size_t>& intervals)
+{
+	std::size_t prevCount = samples.times.size();
+	std::size_t count = prevCount + intervals.size();
+	samples.times.resize(count);
+	samples.modelMatrices.resize(count);
+	for (std::vector<glm::vec3>& positions : samples.positions)
+	{
+		positions.resize(count);
+	}
+	errors.resize(count - 1);
+
+	auto move = [&samples] (const PoseSamples& source, std::size_t from, std::size_t to)
+	{
+		samples.times[to] = source.times[from];
+		samples.modelMatrices[to] = source.modelMatrices[from];
+		for (int curve = 0; curve < positionCurveTypeCount; ++curve)
+		{
+			samples.positions[curve][to] = source.positions[curve][from];
+		}
+	};
+
+	std::size_t target = count;
+	std::size_t midpoint = intervals.size();
+	for (std::size_t i = prevCount; midpoint > 0 && i-- > 0;)
+	{
+		bool split = intervals[midpoint - 1] == i;
+		if (split)
+		{
+			move(midpoints, --midpoint, --target);
+		}
+		--target;
+		if (!split && i + 1 < prevCount)
+		{
+			errors[target] = errors[i];
+		}
+		move(samples, i, target);
+		if (split)
+		{
+			intervals[midpoint] = target;
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+#include "math/positionSpline.hpp"
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+struct SamplingSettings
+{
+	static constexpr int minBudget = 2;
+	static constexpr int maxBudget = 500;
+
+	bool adaptive = false;
+	int budget = 30;
+	float angularTolerance = 0.1f;
+	float positionalTolerance = 0.1f;
+};
+
+struct PoseSamples
+{
+	std::vector<float> times{};
+	std::vector<glm::mat4> modelMatrices{};
+	std::array<std::vector<glm::vec3>, positionCurveTypeCount> positions{};
+};
+
+struct PoseSamplerScratch
+{
+	std::vector<float> ts{};
+	std::vector<float> errors{};
+	std::vector<std::pair<float, std::size_t>> candidates{};
+	std::vector<std::size_t> intervals{};
+	PoseSamples midpoints{};
+};
+
+class PoseSampler
+{
+public:
+	PoseSampler(const Interpolator& interpolator, const SamplingSettings& settings);
+
+	void sample(InterpolationType type, PoseSamples& samples, PoseSamplerScratch& scratch) const;
+
+private:
+	const Interpolator& m_interpolator;
+	SamplingSettings m_settings{};
+
+	void sampleUniform(InterpolationType type, PoseSamples& samples,
+		PoseSamplerScratch& scratch) const;
+	void sampleAdaptive(InterpolationType type, PoseSamples& samples,
+		PoseSamplerScratch& scratch) const;
+	void evaluate(InterpolationType type, PoseSamples& samples, std::vector<float>& ts) const;
+	float intervalError(InterpolationType type, const PoseSamples& samples,
+		std::size_t index) const;
+	static void merge(PoseSamples& samples, std::vector<float>& errors,
+		const PoseSamples& midpoints, std::vector<std::size_t>& intervals);
+};
@@ -0,0 +1,82 @@
+#include "poseWorker.hpp"
+
+#include "concurrency/parallelFor.hpp"
+#include "memory/allocationTracker.hpp"
+
+#include <utility>
+
+PoseWorker::PoseWorker() :
+	m_thread{&PoseWorker::run, this}
+{ }
+
+PoseWorker::~PoseWorker()
+{
+	m_stopRequested.store(true, std::memory_order_release);
+	m_submittedVersion.fetch_add(1, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	m_thread.join();
+}
+
+std::uint64_t PoseWorker::submit(const Interpolator& interpolator,
+	const SamplingSettings& settings)
+{
+	Job& job = m_jobs.back();
+	job.version = ++m_lastVersion;
+	job.interpolator = interpolator;
+	job.settings = settings;
+	m_jobs.publish();
+
+	m_submittedVersion.store(m_lastVersion, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	return m_lastVersion;
+}
+
+const PoseSnapshot* PoseWorker::poll()
+{
+	return m_snapshots.update() ? &m_snapshots.front() : nullptr;
+}
+
+void PoseWorker::run()
+{
+	AllocationTracker::setZone(AllocationZone::sampling);
+	std::uint64_t seenVersion = 0;
+	while (true)
+	{
+		m_submittedVersion.wait(seenVersion, std::memory_order_acquire);
+		seenVersion = m_submittedVersion.load(std::memory_order_acquire);
+		if (m_stopRequested.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if (!m_jobs.update())
+		{
+			continue;
+		}
+
+		computePoses(m_jobs.front(), m_snapshots.back());
+		m_snapshots.publish();
+	}
+}
+
+void PoseWorker::computePoses(const Job& job, PoseSnapshot& snapshot)
+{
+	snapshot.version = job.version;
+
+	PoseSampler sampler{job.interpolator, job.settings};
+	parallelFor(interpolationTypeCount, 1,
+		[&] (std::size_t begin, std::size_t end)
+		{
+			AllocationZoneScope zone{AllocationZone::sampling};
+			for (std::size_t type = begin; type < end; ++type)
+			{
+				sampler.sample(static_cast<InterpolationType>(type), snapshot.samples[type],
+					m_samplerScratch[type]);
+			}
+		});
+
+	std::shared_ptr<PoseCache> cache = std::make_shared<PoseCache>();
+	cache->bake(job.interpolator, job.version);
+	snapshot.metrics = m_metricsEngine.update(job.interpolator, *cache);
+	snapshot.cache = std::move(cache);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "concurrency/tripleBuffer.hpp"
+#include "divergenceMetrics.hpp"
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+#include "poseCache.hpp"
+#include "poseSampler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+struct PoseSnapshot
+{
+	std::uint64_t version{};
+	std::array<PoseSamples, interpolationTypeCount> samples{};
+	std::shared_ptr<const PoseCache> cache{};
+	DivergenceMetrics metrics{};
+};
+
+class PoseWorker
+{
+public:
+	PoseWorker();
+	PoseWorker(const PoseWorker&) = delete;
+	PoseWorker(PoseWorker&&) = delete;
+	~PoseWorker();
+
+	PoseWorker& operator=(const PoseWorker&) = delete;
+	PoseWorker& operator=(PoseWorker&&) = delete;
+
+	std::uint64_t submit(const Interpolator& interpolator, const SamplingSettings& settings);
+	const PoseSnapshot* poll();
+
+private:
+	struct Job
+	{
+		std::uint64_t version{};
+		Interpolator interpolator{};
+		SamplingSettings settings{};
+	};
+
+	TripleBuffer<Job> m_jobs{};
+	TripleBuffer<PoseSnapshot> m_snapshots{};
+	std::uint64_t m_lastVersion = 0;
+	std::atomic<std::uint64_t> m_submittedVersion = 0;
+	std::atomic<bool> m_stopRequested = false;
+	std::array<PoseSamplerScratch, interpolationTypeCount> m_samplerScratch{};
+	DivergenceMetricsEngine m_metricsEngine{};
+	std::thread m_thread;
+
+	void run();
+	void computePoses(const Job& job, PoseSnapshot& snapshot);
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class PositionCurveType
+{
+	linear,
+	catmullRom,
+	hermite,
+	bezier
+};
+
+inline constexpr int positionCurveTypeCount = 4;
+
+inline const std::array<std::string, positionCurveTypeCount> positionCurveTypeLabels
+{
+	"Linear",
+	"Catmull-Rom",
+	"Cubic Hermite",
+	"Cubic Bezier"
+};
@@ -0,0 +1,34 @@
+#include "profiling/zoneTimer.hpp"
+
+#include <chrono>
+
+using TimerClock = std::chrono::steady_clock;
+
+static thread_local ZoneTimes zoneTimes{};
+static thread_local AllocationZone currentZone = AllocationZone::other;
+static thread_local TimerClock::time_point switchTime = TimerClock::now();
+
+static std::int64_t elapsedNs(TimerClock::time_point start, TimerClock::time_point end);
+
+namespace ZoneTimer
+{
+	void switchZone(AllocationZone zone)
+	{
+		TimerClock::time_point now = TimerClock::now();
+		zoneTimes[static_cast<int>(currentZone)] += elapsedNs(switchTime, now);
+		currentZone = zone;
+		switchTime = now;
+	}
+
+	ZoneTimes getTimes()
+	{
+		ZoneTimes times = zoneTimes;
+		times[static_cast<int>(currentZone)] += elapsedNs(switchTime, TimerClock::now());
+		return times;
+	}
+}
+
+std::int64_t elapsedNs(TimerClock::time_point start, TimerClock::time_point end)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "memory/allocationZone.hpp"
+
+#include <array>
+#include <cstdint>
+
+using ZoneTimes = std::array<std::int64_t, allocationZoneCount>;
+
+namespace ZoneTimer
+{
+	void switchZone(AllocationZone zone);
+	ZoneTimes getTimes();
+}
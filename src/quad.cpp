@@ -1,9 +1,12 @@
 #include "quad.hpp"
 
+#include "memory/glResourceTracker.hpp"
+
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
 #include <array>
+#include <cstdint>
 
 static constexpr int vertexCount = 6;
 
@@ -31,11 +34,25 @@ Quad::Quad()
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(glm::vec3)),
 		vertices.data(), GL_STATIC_DRAW);
+
+	GLResourceTracker::add(GLResourceType::vertexArray);
+	GLResourceTracker::add(GLResourceType::buffer, 1,
+		static_cast<std::int64_t>(vertices.size() * sizeof(glm::vec3)));
 }
 
-void Quad::render() const
+Quad::~Quad()
 {
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertexCount));
-	glBindVertexArray(0);
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteVertexArrays(1, &m_VAO);
+	GLResourceTracker::remove(GLResourceType::buffer, 1,
+		static_cast<std::int64_t>(vertexCount * sizeof(glm::vec3)));
+	GLResourceTracker::remove(GLResourceType::vertexArray);
+}
+
+void Quad::render(Renderer& renderer, DrawCommand command) const
+{
+	command.VAO = m_VAO;
+	command.mode = GL_TRIANGLES;
+	command.count = vertexCount;
+	renderer.submit(command);
 }
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "render/renderer.hpp"
+
 class Quad
 {
 public:
 	Quad();
-	void render() const;
+	~Quad();
+	void render(Renderer& renderer, DrawCommand command) const;
 
 private:
 	unsigned int m_VBO{};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "render/renderPass.hpp"
+#include "shaderProgram.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <variant>
+
+using UniformValue = std::variant<bool, float, glm::vec3, glm::mat4>;
+
+struct Uniform
+{
+	const char* name{};
+	UniformValue value{};
+};
+
+struct DrawCommand
+{
+	static constexpr int maxUniformCount = 4;
+
+	RenderPass pass = RenderPass::opaque;
+	const ShaderProgram* program{};
+	unsigned int VAO{};
+	unsigned int texture{};
+	float lineWidth = 1.0f;
+	bool depthWrite = true;
+
+	unsigned int mode{};
+	int first{};
+	int count{};
+	int instanceCount = 1;
+
+	std::array<Uniform, maxUniformCount> uniforms{};
+	int uniformCount{};
+
+	void setUniform(const char* name, const UniformValue& value)
+	{
+		uniforms[uniformCount++] = {name, value};
+	}
+};
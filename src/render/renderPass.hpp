@@ -0,0 +1,13 @@
+#pragma once
+
+enum class RenderPass
+{
+	opaque,
+	transparent,
+	composite
+};
+
+inline constexpr bool isStateSorted(RenderPass pass)
+{
+	return pass == RenderPass::opaque;
+}
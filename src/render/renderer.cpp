@@ -0,0 +1,206 @@
+#include "render/renderer.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <variant>
+
+static constexpr int passShift = 56;
+static constexpr int programShift = 40;
+static constexpr int vertexArrayShift = 24;
+static constexpr int textureShift = 16;
+static constexpr float lineWidthSteps = 4.0f;
+
+void Renderer::beginFrame()
+{
+	m_frameStats = {};
+	m_program = unknownName;
+	m_VAO = unknownName;
+	m_texture = unknownName;
+	m_lineWidthKnown = false;
+	m_depthWriteKnown = false;
+}
+
+void Renderer::endFrame()
+{
+	m_stats = m_frameStats;
+}
+
+void Renderer::setCamera(const glm::mat4& projectionViewMatrix,
+	const glm::mat4& projectionViewMatrixInverse)
+{
+	if (projectionViewMatrix == m_projectionViewMatrix &&
+		projectionViewMatrixInverse == m_projectionViewMatrixInverse)
+	{
+		return;
+	}
+
+	m_projectionViewMatrix = projectionViewMatrix;
+	m_projectionViewMatrixInverse = projectionViewMatrixInverse;
+	++m_cameraVersion;
+}
+
+void Renderer::submit(const DrawCommand& command)
+{
+	m_commands.push_back(command);
+}
+
+void Renderer::flush()
+{
+	m_order.clear();
+	for (std::size_t i = 0; i < m_commands.size(); ++i)
+	{
+		m_order.emplace_back(sortKey(m_commands[i]), static_cast<std::uint32_t>(i));
+	}
+	std::sort(m_order.begin(), m_order.end());
+
+	for (const std::pair<std::uint64_t, std::uint32_t>& entry : m_order)
+	{
+		execute(m_commands[entry.second]);
+	}
+	setDepthWrite(true);
+
+	m_frameStats.commandCount += m_commands.size();
+	m_commands.clear();
+}
+
+const RenderStats& Renderer::getStats() const
+{
+	return m_stats;
+}
+
+void Renderer::execute(const DrawCommand& command)
+{
+	useProgram(*command.program);
+	bindVertexArray(command.VAO);
+	if (command.texture != 0)
+	{
+		bindTexture(command.texture);
+	}
+	setLineWidth(command.lineWidth);
+	setDepthWrite(command.depthWrite);
+
+	for (int i = 0; i < command.uniformCount; ++i)
+	{
+		const Uniform& uniform = command.uniforms[i];
+		std::visit([&command, &uniform] (const auto& value)
+			{
+				command.program->setUniform(uniform.name, value);
+			}, uniform.value);
+	}
+
+	if (command.instanceCount == 1)
+	{
+		glDrawArrays(command.mode, command.first, command.count);
+	}
+	else
+	{
+		glDrawArraysInstanced(command.mode, command.first, command.count,
+			command.instanceCount);
+	}
+	++m_frameStats.drawCallCount;
+}
+
+void Renderer::useProgram(const ShaderProgram& program)
+{
+	if (program.getId() == m_program)
+	{
+		++m_frameStats.elidedChangeCount;
+	}
+	else
+	{
+		program.use();
+		m_program = program.getId();
+		++m_frameStats.programChangeCount;
+	}
+	uploadCamera(program);
+}
+
+void Renderer::bindVertexArray(unsigned int VAO)
+{
+	if (VAO == m_VAO)
+	{
+		++m_frameStats.elidedChangeCount;
+		return;
+	}
+
+	glBindVertexArray(VAO);
+	m_VAO = VAO;
+	++m_frameStats.vertexArrayChangeCount;
+}
+
+void Renderer::bindTexture(unsigned int texture)
+{
+	if (texture == m_texture)
+	{
+		++m_frameStats.elidedChangeCount;
+		return;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	m_texture = texture;
+	++m_frameStats.textureChangeCount;
+}
+
+void Renderer::setLineWidth(float lineWidth)
+{
+	if (m_lineWidthKnown && lineWidth == m_lineWidth)
+	{
+		++m_frameStats.elidedChangeCount;
+		return;
+	}
+
+	glLineWidth(lineWidth);
+	m_lineWidth = lineWidth;
+	m_lineWidthKnown = true;
+	++m_frameStats.lineWidthChangeCount;
+}
+
+void Renderer::setDepthWrite(bool depthWrite)
+{
+	if (m_depthWriteKnown && depthWrite == m_depthWrite)
+	{
+		++m_frameStats.elidedChangeCount;
+		return;
+	}
+
+	glDepthMask(depthWrite ? GL_TRUE : GL_FALSE);
+	m_depthWrite = depthWrite;
+	m_depthWriteKnown = true;
+	++m_frameStats.depthWriteChangeCount;
+}
+
+void Renderer::uploadCamera(const ShaderProgram& program)
+{
+	unsigned int id = program.getId();
+	if (id >= m_programCameraVersions.size())
+	{
+		m_programCameraVersions.resize(id + 1);
+	}
+	if (m_programCameraVersions[id] == m_cameraVersion)
+	{
+		return;
+	}
+
+	program.setUniform("projectionViewMatrix", m_projectionViewMatrix);
+	program.setUniform("projectionViewMatrixInverse", m_projectionViewMatrixInverse);
+	m_programCameraVersions[id] = m_cameraVersion;
+	++m_frameStats.cameraUploadCount;
+}
+
+std::uint64_t Renderer::sortKey(const DrawCommand& command)
+{
+	std::uint64_t key = static_cast<std::uint64_t>(command.pass) << passShift;
+	if (!isStateSorted(command.pass))
+	{
+		return key;
+	}
+
+	std::uint64_t lineWidth =
+		static_cast<std::uint64_t>(command.lineWidth * lineWidthSteps) & 0x7fff;
+	return key |
+		static_cast<std::uint64_t>(command.program->getId() & 0xffff) << programShift |
+		static_cast<std::uint64_t>(command.VAO & 0xffff) << vertexArrayShift |
+		static_cast<std::uint64_t>(command.texture & 0xff) << textureShift |
+		lineWidth << 1 | static_cast<std::uint64_t>(command.depthWrite);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "render/drawCommand.hpp"
+#include "shaderProgram.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct RenderStats
+{
+	std::size_t commandCount{};
+	std::size_t drawCallCount{};
+	std::size_t programChangeCount{};
+	std::size_t vertexArrayChangeCount{};
+	std::size_t textureChangeCount{};
+	std::size_t lineWidthChangeCount{};
+	std::size_t depthWriteChangeCount{};
+	std::size_t cameraUploadCount{};
+	std::size_t elidedChangeCount{};
+
+	std::size_t getStateChangeCount() const
+	{
+		return programChangeCount + vertexArrayChangeCount + textureChangeCount +
+			lineWidthChangeCount + depthWriteChangeCount;
+	}
+};
+
+class Renderer
+{
+public:
+	void beginFrame();
+	void endFrame();
+	void setCamera(const glm::mat4& projectionViewMatrix,
+		const glm::mat4& projectionViewMatrixInverse);
+	void submit(const DrawCommand& command);
+	void flush();
+	const RenderStats& getStats() const;
+
+private:
+	static constexpr unsigned int unknownName = ~0u;
+
+	std::vector<DrawCommand> m_commands{};
+	std::vector<std::pair<std::uint64_t, std::uint32_t>> m_order{};
+
+	unsigned int m_program = unknownName;
+	unsigned int m_VAO = unknownName;
+	unsigned int m_texture = unknownName;
+	float m_lineWidth{};
+	bool m_lineWidthKnown = false;
+	bool m_depthWrite{};
+	bool m_depthWriteKnown = false;
+
+	glm::mat4 m_projectionViewMatrix{1};
+	glm::mat4 m_projectionViewMatrixInverse{1};
+	std::uint64_t m_cameraVersion = 1;
+	std::vector<std::uint64_t> m_programCameraVersions{};
+
+	RenderStats m_frameStats{};
+	RenderStats m_stats{};
+
+	void execute(const DrawCommand& command);
+	void useProgram(const ShaderProgram& program);
+	void bindVertexArray(unsigned int VAO);
+	void bindTexture(unsigned int texture);
+	void setLineWidth(float lineWidth);
+	void setDepthWrite(bool depthWrite);
+	void uploadCamera(const ShaderProgram& program);
+	static std::uint64_t sortKey(const DrawCommand& command);
+};
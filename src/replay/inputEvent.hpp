@@ -0,0 +1,39 @@
+#pragma once
+
+#include "clock/clock.hpp"
+#include "sceneCommand.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <variant>
+
+namespace InputEvents
+{
+	struct EndFrame { Clock::Ticks ticks; };
+	struct AddPitchCamera { float pitchRad; };
+	struct AddYawCamera { float yawRad; };
+	struct MoveXCamera { float x; };
+	struct MoveYCamera { float y; };
+	struct ZoomCamera { float zoom; };
+	struct ResizeViewport { glm::ivec2 viewportSize; };
+	struct ApplyCommand { SceneCommand command; };
+}
+
+using InputEvent = std::variant
+<
+	InputEvents::EndFrame,
+	InputEvents::AddPitchCamera,
+	InputEvents::AddYawCamera,
+	InputEvents::MoveXCamera,
+	InputEvents::MoveYCamera,
+	InputEvents::ZoomCamera,
+	InputEvents::ResizeViewport,
+	InputEvents::ApplyCommand
+>;
+
+struct TimedInputEvent
+{
+	std::int64_t timeNs{};
+	InputEvent event{};
+};
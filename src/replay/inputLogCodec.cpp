@@ -0,0 +1,488 @@
+#include "replay/inputLogCodec.hpp"
+
+#include "interpolator.hpp"
+#include "poseSampler.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+template <typename T>
+static void writeValue(std::vector<char>& buffer, const T& value);
+static void writeString(std::vector<char>& buffer, const std::string& string);
+template <typename... Types>
+static void writeVariant(std::vector<char>& buffer, const std::variant<Types...>& variant);
+template <typename T>
+static void writePayload(std::vector<char>& buffer, const T& payload);
+static void writePayload(std::vector<char>& buffer, const InputEvents::ApplyCommand& payload);
+static void writePayload(std::vector<char>& buffer, const SceneCommands::LoadClip& payload);
+static void writePayload(std::vector<char>& buffer,
+	const SceneCommands::LoadSkeletons& payload);
+
+template <typename T>
+static bool readValue(const char*& data, const char* end, T& value);
+static bool readValue(const char*& data, const char* end, bool& value);
+static bool readString(const char*& data, const char* end, std::string& string);
+template <typename... Types>
+static bool readVariant(const char*& data, const char* end, std::variant<Types...>& variant);
+template <typename Variant, std::size_t... indices>
+static bool readAlternative(const char*& data, const char* end, std::size_t index,
+	Variant& variant, std::index_sequence<indices...>);
+template <typename T>
+static bool readPayload(const char*& data, const char* end, T& payload);
+static bool readPayload(const char*& data, const char* end, InputEvents::ApplyCommand& payload);
+static bool readPayload(const char*& data, const char* end, SceneCommands::LoadClip& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::LoadSkeletons& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetConstantSpeed& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetAdaptiveSampling& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetRenderIntermediateFrames& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetRenderVelocities& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetRenderMotionBlur& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetUseBakedCache& payload);
+static bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetBlendSkeletons& payload);
+
+template <typename T>
+static bool isValid(const T& payload);
+template <typename Enum>
+static bool isValidEnum(Enum value, int count);
+static bool isFinite(float value);
+static bool isFinite(const glm::vec2& vector);
+static bool isFinite(const glm::vec3& vector);
+static bool isFinite(const glm::vec4& vector);
+static bool isPositive(float value);
+static bool isValid(const InputEvents::AddPitchCamera& payload);
+static bool isValid(const InputEvents::AddYawCamera& payload);
+static bool isValid(const InputEvents::MoveXCamera& payload);
+static bool isValid(const InputEvents::MoveYCamera& payload);
+static bool isValid(const InputEvents::ZoomCamera& payload);
+static bool isValid(const SceneCommands::SetStartPos& payload);
+static bool isValid(const SceneCommands::SetStartEulerAngles& payload);
+static bool isValid(const SceneCommands::SetStartQuat& payload);
+static bool isValid(const SceneCommands::SetEndPos& payload);
+static bool isValid(const SceneCommands::SetEndEulerAngles& payload);
+static bool isValid(const SceneCommands::SetEndQuat& payload);
+static bool isValid(const SceneCommands::SetTime& payload);
+static bool isValid(const InputEvents::ResizeViewport& payload);
+static bool isValid(const SceneCommands::SetPosKey& payload);
+static bool isValid(const SceneCommands::SetAnimationTime& payload);
+static bool isValid(const SceneCommands::SetIntermediateFrameCount& payload);
+static bool isValid(const SceneCommands::SetAngularTolerance& payload);
+static bool isValid(const SceneCommands::SetPositionalTolerance& payload);
+static bool isValid(const SceneCommands::SetMotionBlurSettings& payload);
+static bool isValid(const SceneCommands::SetBlendLayer& payload);
+static bool isValid(const SceneCommands::SetInterpolationTypeLeft& payload);
+static bool isValid(const SceneCommands::SetInterpolationTypeRight& payload);
+static bool isValid(const SceneCommands::SetPositionCurveLeft& payload);
+static bool isValid(const SceneCommands::SetPositionCurveRight& payload);
+static bool isValid(const SceneCommands::SetTimeWarp& payload);
+static bool isValid(const SceneCommands::SetClockType& payload);
+static bool isValid(const SceneCommands::ReduceClip& payload);
+static bool isValid(const SceneCommands::SetClipPlayback& payload);
+static bool isValid(const SceneCommands::SetBlendMethodLeft& payload);
+static bool isValid(const SceneCommands::SetBlendMethodRight& payload);
+
+namespace InputLogCodec
+{
+	void encode(const TimedInputEvent& event, std::vector<char>& buffer)
+	{
+		writeValue(buffer, static_cast<std::uint8_t>(event.event.index()));
+		writeValue(buffer, event.timeNs);
+		std::visit([&buffer] (const auto& payload) { writePayload(buffer, payload); }, event.event);
+	}
+
+	bool decode(const char*& data, const char* end, TimedInputEvent& event)
+	{
+		std::uint8_t index{};
+		return readValue(data, end, index) && readValue(data, end, event.timeNs) &&
+			readAlternative(data, end, index, event.event,
+				std::make_index_sequence<std::variant_size_v<InputEvent>>{});
+	}
+}
+
+template <typename T>
+void writeValue(std::vector<char>& buffer, const T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	const char* bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void writeString(std::vector<char>& buffer, const std::string& string)
+{
+	writeValue(buffer, static_cast<std::uint32_t>(string.size()));
+	buffer.insert(buffer.end(), string.begin(), string.end());
+}
+
+template <typename... Types>
+void writeVariant(std::vector<char>& buffer, const std::variant<Types...>& variant)
+{
+	writeValue(buffer, static_cast<std::uint8_t>(variant.index()));
+	std::visit([&buffer] (const auto& payload) { writePayload(buffer, payload); }, variant);
+}
+
+template <typename T>
+void writePayload(std::vector<char>& buffer, const T& payload)
+{
+	writeValue(buffer, payload);
+}
+
+void writePayload(std::vector<char>& buffer, const InputEvents::ApplyCommand& payload)
+{
+	writeVariant(buffer, payload.command);
+}
+
+void writePayload(std::vector<char>& buffer, const SceneCommands::LoadClip& payload)
+{
+	writeString(buffer, payload.path);
+}
+
+void writePayload(std::vector<char>& buffer, const SceneCommands::LoadSkeletons& payload)
+{
+	writeValue(buffer, static_cast<std::uint32_t>(payload.paths.size()));
+	for (const std::string& path : payload.paths)
+	{
+		writeString(buffer, path);
+	}
+}
+
+template <typename T>
+bool readValue(const char*& data, const char* end, T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	if (static_cast<std::size_t>(end - data) < sizeof(T))
+	{
+		return false;
+	}
+
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+	return true;
+}
+
+bool readValue(const char*& data, const char* end, bool& value)
+{
+	std::uint8_t byte{};
+	if (!readValue(data, end, byte) || byte > 1)
+	{
+		return false;
+	}
+
+	value = byte != 0;
+	return true;
+}
+
+bool readString(const char*& data, const char* end, std::string& string)
+{
+	std::uint32_t size{};
+	if (!readValue(data, end, size) || static_cast<std::size_t>(end - data) < size)
+	{
+		return false;
+	}
+
+	string.assign(data, size);
+	data += size;
+	return true;
+}
+
+template <typename... Types>
+bool readVariant(const char*& data, const char* end, std::variant<Types...>& variant)
+{
+	std::uint8_t index{};
+	return readValue(data, end, index) &&
+		readAlternative(data, end, index, variant, std::index_sequence_for<Types...>{});
+}
+
+template <typename Variant, std::size_t... indices>
+bool readAlternative(const char*& data, const char* end, std::size_t index, Variant& variant,
+	std::index_sequence<indices...>)
+{
+	bool read = false;
+	((index == indices && (read = readPayload(data, end, variant.template emplace<indices>()),
+		true)) || ...);
+	return read;
+}
+
+template <typename T>
+bool readPayload(const char*& data, const char* end, T& payload)
+{
+	return readValue(data, end, payload) && isValid(payload);
+}
+
+bool readPayload(const char*& data, const char* end, InputEvents::ApplyCommand& payload)
+{
+	return readVariant(data, end, payload.command);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::LoadClip& payload)
+{
+	return readString(data, end, payload.path);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::LoadSkeletons& payload)
+{
+	std::uint32_t count{};
+	if (!readValue(data, end, count) ||
+		static_cast<std::size_t>(end - data) / sizeof(std::uint32_t) < count)
+	{
+		return false;
+	}
+
+	payload.paths.resize(count);
+	for (std::string& path : payload.paths)
+	{
+		if (!readString(data, end, path))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::SetConstantSpeed& payload)
+{
+	return readValue(data, end, payload.constantSpeed);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::SetAdaptiveSampling& payload)
+{
+	return readValue(data, end, payload.adaptive);
+}
+
+bool readPayload(const char*& data, const char* end,
+	SceneCommands::SetRenderIntermediateFrames& payload)
+{
+	return readValue(data, end, payload.render);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::SetRenderVelocities& payload)
+{
+	return readValue(data, end, payload.render);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::SetRenderMotionBlur& payload)
+{
+	return readValue(data, end, payload.render);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::SetUseBakedCache& payload)
+{
+	return readValue(data, end, payload.useBakedCache);
+}
+
+bool readPayload(const char*& data, const char* end, SceneCommands::SetBlendSkeletons& payload)
+{
+	return readValue(data, end, payload.blend);
+}
+
+template <typename T>
+bool isValid(const T&)
+{
+	return true;
+}
+
+template <typename Enum>
+bool isValidEnum(Enum value, int count)
+{
+	int index = static_cast<int>(value);
+	return index >= 0 && index < count;
+}
+
+bool isValid(const SceneCommands::SetInterpolationTypeLeft& payload)
+{
+	return isValidEnum(payload.type, interpolationTypeCount);
+}
+
+bool isValid(const SceneCommands::SetInterpolationTypeRight& payload)
+{
+	return isValidEnum(payload.type, interpolationTypeCount);
+}
+
+bool isValid(const SceneCommands::SetPositionCurveLeft& payload)
+{
+	return isValidEnum(payload.type, positionCurveTypeCount);
+}
+
+bool isValid(const SceneCommands::SetPositionCurveRight& payload)
+{
+	return isValidEnum(payload.type, positionCurveTypeCount);
+}
+
+bool isValid(const SceneCommands::SetTimeWarp& payload)
+{
+	const TimeWarpSettings& settings = payload.settings;
+	bool knotsFinite = true;
+	for (float knot : settings.knots)
+	{
+		knotsFinite = knotsFinite && isFinite(knot);
+	}
+	return isValidEnum(settings.type, timeWarpTypeCount) && isFinite(settings.bezierStart) &&
+		isFinite(settings.bezierEnd) && knotsFinite;
+}
+
+bool isValid(const SceneCommands::SetClockType& payload)
+{
+	return isValidEnum(payload.type, static_cast<int>(clockTypeLabels.size()));
+}
+
+bool isValid(const SceneCommands::ReduceClip& payload)
+{
+	return isValidEnum(payload.type, interpolationTypeCount) &&
+		isPositive(payload.tolerances.angular) && isPositive(payload.tolerances.positional);
+}
+
+bool isValid(const SceneCommands::SetClipPlayback& payload)
+{
+	return isValidEnum(payload.playback, clipPlaybackCount);
+}
+
+bool isValid(const SceneCommands::SetBlendMethodLeft& payload)
+{
+	return isValidEnum(payload.method, blendMethodCount);
+}
+
+bool isValid(const SceneCommands::SetBlendMethodRight& payload)
+{
+	return isValidEnum(payload.method, blendMethodCount);
+}
+
+bool isFinite(float value)
+{
+	return std::isfinite(value);
+}
+
+bool isFinite(const glm::vec2& vector)
+{
+	return isFinite(vector.x) && isFinite(vector.y);
+}
+
+bool isFinite(const glm::vec3& vector)
+{
+	return isFinite(vector.x) && isFinite(vector.y) && isFinite(vector.z);
+}
+
+bool isFinite(const glm::vec4& vector)
+{
+	return isFinite(vector.x) && isFinite(vector.y) && isFinite(vector.z) && isFinite(vector.w);
+}
+
+bool isPositive(float value)
+{
+	return isFinite(value) && value > 0;
+}
+
+bool isValid(const InputEvents::AddPitchCamera& payload)
+{
+	return isFinite(payload.pitchRad);
+}
+
+bool isValid(const InputEvents::AddYawCamera& payload)
+{
+	return isFinite(payload.yawRad);
+}
+
+bool isValid(const InputEvents::MoveXCamera& payload)
+{
+	return isFinite(payload.x);
+}
+
+bool isValid(const InputEvents::MoveYCamera& payload)
+{
+	return isFinite(payload.y);
+}
+
+bool isValid(const InputEvents::ZoomCamera& payload)
+{
+	return isFinite(payload.zoom);
+}
+
+bool isValid(const SceneCommands::SetStartPos& payload)
+{
+	return isFinite(payload.pos);
+}
+
+bool isValid(const SceneCommands::SetStartEulerAngles& payload)
+{
+	return isFinite(payload.eulerAngles);
+}
+
+bool isValid(const SceneCommands::SetStartQuat& payload)
+{
+	return isFinite(payload.quat);
+}
+
+bool isValid(const SceneCommands::SetEndPos& payload)
+{
+	return isFinite(payload.pos);
+}
+
+bool isValid(const SceneCommands::SetEndEulerAngles& payload)
+{
+	return isFinite(payload.eulerAngles);
+}
+
+bool isValid(const SceneCommands::SetEndQuat& payload)
+{
+	return isFinite(payload.quat);
+}
+
+bool isValid(const SceneCommands::SetTime& payload)
+{
+	return isFinite(payload.time);
+}
+
+bool isValid(const InputEvents::ResizeViewport& payload)
+{
+	return payload.viewportSize.x > 0 && payload.viewportSize.y > 0;
+}
+
+bool isValid(const SceneCommands::SetPosKey& payload)
+{
+	return isFinite(payload.key.pos) && isFinite(payload.key.tangent);
+}
+
+bool isValid(const SceneCommands::SetAnimationTime& payload)
+{
+	return payload.time >= Interpolator::minEndTime && payload.time <= Interpolator::maxEndTime;
+}
+
+bool isValid(const SceneCommands::SetIntermediateFrameCount& payload)
+{
+	return payload.count >= SamplingSettings::minBudget &&
+		payload.count <= SamplingSettings::maxBudget;
+}
+
+bool isValid(const SceneCommands::SetAngularTolerance& payload)
+{
+	return isPositive(payload.tolerance);
+}
+
+bool isValid(const SceneCommands::SetPositionalTolerance& payload)
+{
+	return isPositive(payload.tolerance);
+}
+
+bool isValid(const SceneCommands::SetMotionBlurSettings& payload)
+{
+	const MotionBlurSettings& settings = payload.settings;
+	return settings.shutter >= 0 && settings.shutter <= 1 && isPositive(settings.budgetMs) &&
+		settings.maxSubFrameCount >= MotionBlur::minSubFrameCount &&
+		settings.maxSubFrameCount <= MotionBlur::subFrameCountLimit;
+}
+
+bool isValid(const SceneCommands::SetBlendLayer& payload)
+{
+	return isFinite(payload.layer.startWeight) && payload.layer.startWeight >= 0 &&
+		isFinite(payload.layer.endWeight) && payload.layer.endWeight >= 0;
+}
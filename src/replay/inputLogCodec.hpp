@@ -0,0 +1,11 @@
+#pragma once
+
+#include "replay/inputEvent.hpp"
+
+#include <vector>
+
+namespace InputLogCodec
+{
+	void encode(const TimedInputEvent& event, std::vector<char>& buffer);
+	bool decode(const char*& data, const char* end, TimedInputEvent& event);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "replay/inputEvent.hpp"
+#include "sceneCommand.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <variant>
+
+static_assert(std::endian::native == std::endian::little,
+	"input logs are written in native byte order");
+
+namespace InputLogFormat
+{
+	inline constexpr std::array<char, 8> magic{'M', 'I', 'I', 'N', 'P', 'U', 'T', '\0'};
+	inline constexpr std::uint32_t version = 1;
+
+	struct Header
+	{
+		std::array<char, 8> magic{};
+		std::uint32_t version{};
+		std::uint16_t eventTypeCount{};
+		std::uint16_t commandTypeCount{};
+		std::int32_t viewportWidth{};
+		std::int32_t viewportHeight{};
+		std::uint64_t frameCount{};
+		std::uint64_t eventCount{};
+	};
+
+	static_assert(sizeof(Header) == 40);
+
+	constexpr Header makeHeader(const glm::ivec2& viewportSize)
+	{
+		Header header{};
+		header.magic = magic;
+		header.version = version;
+		header.eventTypeCount = std::variant_size_v<InputEvent>;
+		header.commandTypeCount = std::variant_size_v<SceneCommand>;
+		header.viewportWidth = viewportSize.x;
+		header.viewportHeight = viewportSize.y;
+		return header;
+	}
+
+	constexpr bool isCompatible(const Header& header)
+	{
+		return header.magic == magic && header.version == version &&
+			header.eventTypeCount == std::variant_size_v<InputEvent> &&
+			header.commandTypeCount == std::variant_size_v<SceneCommand>;
+	}
+}
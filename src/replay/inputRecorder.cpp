@@ -0,0 +1,65 @@
+#include "replay/inputRecorder.hpp"
+
+#include "replay/inputLogCodec.hpp"
+
+#include <variant>
+
+InputRecorder::InputRecorder(const std::filesystem::path& path, const glm::ivec2& viewportSize) :
+	m_file{path, std::ios::binary | std::ios::trunc},
+	m_header{InputLogFormat::makeHeader(viewportSize)},
+	m_startTime{std::chrono::steady_clock::now()}
+{
+	m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+	m_buffer.reserve(2 * chunkSize);
+}
+
+bool InputRecorder::isOpen() const
+{
+	return m_file.is_open() && m_file.good();
+}
+
+void InputRecorder::record(const InputEvent& event)
+{
+	std::int64_t timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - m_startTime).count();
+	InputLogCodec::encode({timeNs, event}, m_buffer);
+
+	++m_header.eventCount;
+	if (std::holds_alternative<InputEvents::EndFrame>(event))
+	{
+		++m_header.frameCount;
+	}
+	if (m_buffer.size() >= chunkSize)
+	{
+		flush();
+	}
+}
+
+bool InputRecorder::finish()
+{
+	if (!flush())
+	{
+		return false;
+	}
+	m_file.seekp(0);
+	m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+	m_file.close();
+	return !m_file.fail();
+}
+
+std::uint64_t InputRecorder::getFrameCount() const
+{
+	return m_header.frameCount;
+}
+
+std::uint64_t InputRecorder::getEventCount() const
+{
+	return m_header.eventCount;
+}
+
+bool InputRecorder::flush()
+{
+	m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+	m_buffer.clear();
+	return m_file.good();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "replay/inputEvent.hpp"
+#include "replay/inputLogFormat.hpp"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+class InputRecorder
+{
+public:
+	InputRecorder(const std::filesystem::path& path, const glm::ivec2& viewportSize);
+
+	bool isOpen() const;
+	void record(const InputEvent& event);
+	bool finish();
+	std::uint64_t getFrameCount() const;
+	std::uint64_t getEventCount() const;
+
+private:
+	static constexpr std::size_t chunkSize = 1 << 16;
+
+	std::ofstream m_file{};
+	InputLogFormat::Header m_header{};
+	std::chrono::steady_clock::time_point m_startTime{};
+	std::vector<char> m_buffer{};
+
+	bool flush();
+};
@@ -0,0 +1,203 @@
+#include "replay/inputSession.hpp"
+
+#include "replay/inputLogCodec.hpp"
+#include "replay/inputLogFormat.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+InputSession::InputSession(Window& window, Scene& scene) :
+	m_window{window},
+	m_scene{scene}
+{ }
+
+bool InputSession::startRecording(const std::filesystem::path& path)
+{
+	m_recorder = std::make_unique<InputRecorder>(path, m_window.viewportSize());
+	if (!m_recorder->isOpen())
+	{
+		m_recorder = nullptr;
+		return false;
+	}
+
+	m_scene.setInputRecorder(m_recorder.get());
+	return true;
+}
+
+bool InputSession::startReplay(const std::filesystem::path& logPath,
+	const std::filesystem::path& reportPath)
+{
+	glm::ivec2 viewportSize{};
+	if (!readLog(logPath, viewportSize))
+	{
+		return false;
+	}
+
+	m_logPath = logPath;
+	m_reportPath = reportPath;
+	m_replaying = true;
+	m_window.setVSync(false);
+	m_window.setViewportSize(viewportSize);
+	m_scene.setInputLocked(true);
+	return true;
+}
+
+bool InputSession::isReplayFinished() const
+{
+	return m_replayFinished;
+}
+
+bool InputSession::finish()
+{
+	if (m_recorder != nullptr)
+	{
+		m_scene.setInputRecorder(nullptr);
+		bool finished = m_recorder->finish();
+		m_recorder = nullptr;
+		return finished;
+	}
+	if (m_replaying)
+	{
+		m_replaying = false;
+		m_scene.setInputLocked(false);
+		return m_report.write(m_reportPath, m_logPath);
+	}
+	return true;
+}
+
+void InputSession::beginFrame()
+{
+	if (!m_replaying || m_replayFinished)
+	{
+		return;
+	}
+
+	while (m_nextEvent < m_events.size())
+	{
+		const TimedInputEvent& event = m_events[m_nextEvent++];
+		applyEvent(event);
+		if (std::holds_alternative<InputEvents::EndFrame>(event.event))
+		{
+			break;
+		}
+	}
+	m_frameStart = std::chrono::steady_clock::now();
+	m_frameStartZoneTimes = ZoneTimer::getTimes();
+}
+
+void InputSession::endFrame()
+{
+	if (!m_replaying || m_replayFinished)
+	{
+		return;
+	}
+
+	float frameMs = std::chrono::duration<float, std::milli>(
+		std::chrono::steady_clock::now() - m_frameStart).count();
+	ZoneTimes zoneTimes = ZoneTimer::getTimes();
+	for (int zone = 0; zone < allocationZoneCount; ++zone)
+	{
+		zoneTimes[zone] -= m_frameStartZoneTimes[zone];
+	}
+	m_report.addFrame(frameMs, m_recordedFrameMs, zoneTimes);
+
+	m_replayFinished = m_nextEvent >= m_events.size();
+}
+
+bool InputSession::readLog(const std::filesystem::path& path, glm::ivec2& viewportSize)
+{
+	std::ifstream file{path, std::ios::binary};
+	std::vector<char> data{std::istreambuf_iterator<char>{file},
+		std::istreambuf_iterator<char>{}};
+
+	InputLogFormat::Header header{};
+	if (data.size() < sizeof(header))
+	{
+		return false;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (!InputLogFormat::isCompatible(header))
+	{
+		return false;
+	}
+
+	static constexpr std::size_t minEventSize = sizeof(std::uint8_t) + sizeof(std::int64_t);
+	m_events.clear();
+	m_events.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(header.eventCount,
+		(data.size() - sizeof(header)) / minEventSize)));
+	const char* begin = data.data() + sizeof(header);
+	const char* end = data.data() + data.size();
+	TimedInputEvent event{};
+	while (begin < end)
+	{
+		if (!InputLogCodec::decode(begin, end, event))
+		{
+			return false;
+		}
+		m_events.push_back(std::move(event));
+	}
+	if (m_events.size() != header.eventCount)
+	{
+		return false;
+	}
+
+	while (!m_events.empty() &&
+		!std::holds_alternative<InputEvents::EndFrame>(m_events.back().event))
+	{
+		m_events.pop_back();
+	}
+	viewportSize = {header.viewportWidth, header.viewportHeight};
+	m_report.reserve(static_cast<std::size_t>(
+		std::min<std::uint64_t>(header.frameCount, m_events.size())));
+	return !m_events.empty();
+}
+
+void InputSession::applyEvent(const TimedInputEvent& event)
+{
+	std::visit([this, &event] (const auto& payload)
+		{
+			using Payload = std::decay_t<decltype(payload)>;
+
+			if constexpr (std::is_same_v<Payload, InputEvents::EndFrame>)
+			{
+				m_scene.lockClock(payload.ticks);
+				m_recordedFrameMs = static_cast<float>(event.timeNs - m_lastFrameTimeNs) * 1e-6f;
+				m_lastFrameTimeNs = event.timeNs;
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::AddPitchCamera>)
+			{
+				m_scene.addPitchCamera(payload.pitchRad);
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::AddYawCamera>)
+			{
+				m_scene.addYawCamera(payload.yawRad);
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::MoveXCamera>)
+			{
+				m_scene.moveXCamera(payload.x);
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::MoveYCamera>)
+			{
+				m_scene.moveYCamera(payload.y);
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::ZoomCamera>)
+			{
+				m_scene.zoomCamera(payload.zoom);
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::ResizeViewport>)
+			{
+				m_window.setViewportSize(payload.viewportSize);
+			}
+			else if constexpr (std::is_same_v<Payload, InputEvents::ApplyCommand>)
+			{
+				m_scene.submitCommand(payload.command);
+			}
+		}, event.event);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "profiling/zoneTimer.hpp"
+#include "replay/inputEvent.hpp"
+#include "replay/inputRecorder.hpp"
+#include "replay/replayReport.hpp"
+#include "scene.hpp"
+#include "window.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+class InputSession
+{
+public:
+	InputSession(Window& window, Scene& scene);
+
+	bool startRecording(const std::filesystem::path& path);
+	bool startReplay(const std::filesystem::path& logPath,
+		const std::filesystem::path& reportPath);
+	bool isReplayFinished() const;
+	bool finish();
+
+	void beginFrame();
+	void endFrame();
+
+private:
+	Window& m_window;
+	Scene& m_scene;
+
+	std::unique_ptr<InputRecorder> m_recorder{};
+
+	bool m_replaying = false;
+	bool m_replayFinished = false;
+	std::filesystem::path m_logPath{};
+	std::filesystem::path m_reportPath{};
+	std::vector<TimedInputEvent> m_events{};
+	std::size_t m_nextEvent{};
+	std::int64_t m_lastFrameTimeNs{};
+	float m_recordedFrameMs{};
+	std::chrono::steady_clock::time_point m_frameStart{};
+	ZoneTimes m_frameStartZoneTimes{};
+	ReplayReport m_report{};
+
+	bool readLog(const std::filesystem::path& path, glm::ivec2& viewportSize);
+	void applyEvent(const TimedInputEvent& event);
+};
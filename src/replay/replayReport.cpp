@@ -0,0 +1,131 @@
+#include "replay/replayReport.hpp"
+
+#include "memory/allocationTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+static float percentile(const std::vector<float>& sortedValues, float percent);
+
+void ReplayReport::reserve(std::size_t frameCount)
+{
+	m_frameMs.reserve(frameCount);
+	m_recordedFrameMs.reserve(frameCount);
+	for (std::vector<float>& zoneMs : m_zoneMs)
+	{
+		zoneMs.reserve(frameCount);
+	}
+}
+
+void ReplayReport::addFrame(float frameMs, float recordedFrameMs, const ZoneTimes& zoneTimes)
+{
+	m_frameMs.push_back(frameMs);
+	m_recordedFrameMs.push_back(recordedFrameMs);
+	for (int zone = 0; zone < allocationZoneCount; ++zone)
+	{
+		m_zoneMs[zone].push_back(static_cast<float>(zoneTimes[zone]) * 1e-6f);
+	}
+}
+
+std::size_t ReplayReport::getFrameCount() const
+{
+	return m_frameMs.size();
+}
+
+bool ReplayReport::write(const std::filesystem::path& path,
+	const std::filesystem::path& logPath) const
+{
+	std::ofstream file{path};
+	file << std::fixed << std::setprecision(3);
+	file << "{\n";
+	file << "\t\"log\": " << std::quoted(logPath.filename().string()) << ",\n";
+	file << "\t\"frameCount\": " << m_frameMs.size() << ",\n";
+	file << "\t\"totalMs\": " << std::accumulate(m_frameMs.begin(), m_frameMs.end(), 0.0) <<
+		",\n";
+	file << "\t\"frameMs\": ";
+	writeDistribution(file, m_frameMs);
+	file << ",\n\t\"recordedFrameMs\": ";
+	writeDistribution(file, m_recordedFrameMs);
+	file << ",\n\t\"histogram\": ";
+	writeHistogram(file, m_frameMs);
+	file << ",\n\t\"zoneMs\":\n\t{";
+	bool first = true;
+	for (int zone = 0; zone < allocationZoneCount; ++zone)
+	{
+		const std::vector<float>& zoneMs = m_zoneMs[zone];
+		if (std::all_of(zoneMs.begin(), zoneMs.end(), [] (float ms) { return ms == 0; }))
+		{
+			continue;
+		}
+
+		file << (first ? "\n" : ",\n") << "\t\t" << std::quoted(allocationZoneLabels[zone]) <<
+			": ";
+		writeDistribution(file, zoneMs);
+		first = false;
+	}
+	file << "\n\t}";
+
+	if (AllocationTracker::isEnabled())
+	{
+		const AllocationStats& stats = AllocationTracker::getStats();
+		file << ",\n\t\"steadyStateFrameCount\": " << stats.steadyStateFrameCount;
+		file << ",\n\t\"steadyStateViolationCount\": " << stats.steadyStateViolationCount;
+	}
+	file << "\n}\n";
+	file.close();
+	return !file.fail();
+}
+
+void ReplayReport::writeDistribution(std::ostream& stream, std::vector<float> values)
+{
+	std::sort(values.begin(), values.end());
+	double sum = std::accumulate(values.begin(), values.end(), 0.0);
+	double mean = values.empty() ? 0 : sum / values.size();
+	double variance = 0;
+	for (float value : values)
+	{
+		variance += (value - mean) * (value - mean);
+	}
+	variance = values.empty() ? 0 : variance / values.size();
+
+	stream << "{\"mean\": " << mean << ", \"stdDev\": " << std::sqrt(variance) <<
+		", \"min\": " << (values.empty() ? 0 : values.front()) <<
+		", \"p50\": " << percentile(values, 50) << ", \"p90\": " << percentile(values, 90) <<
+		", \"p95\": " << percentile(values, 95) << ", \"p99\": " << percentile(values, 99) <<
+		", \"max\": " << (values.empty() ? 0 : values.back()) << "}";
+}
+
+void ReplayReport::writeHistogram(std::ostream& stream, const std::vector<float>& values)
+{
+	std::array<std::size_t, histogramBucketCount> counts{};
+	for (float value : values)
+	{
+		int bucket = static_cast<int>(value / histogramBucketMs);
+		++counts[std::clamp(bucket, 0, histogramBucketCount - 1)];
+	}
+	std::size_t usedCount = static_cast<std::size_t>(std::distance(counts.begin(),
+		std::find_if(counts.rbegin(), counts.rend(),
+			[] (std::size_t count) { return count > 0; }).base()));
+
+	stream << "{\"bucketMs\": " << histogramBucketMs << ", \"counts\": [";
+	for (std::size_t i = 0; i < usedCount; ++i)
+	{
+		stream << (i == 0 ? "" : ", ") << counts[i];
+	}
+	stream << "]}";
+}
+
+float percentile(const std::vector<float>& sortedValues, float percent)
+{
+	if (sortedValues.empty())
+	{
+		return 0;
+	}
+
+	std::size_t rank = static_cast<std::size_t>(
+		std::ceil(percent / 100 * static_cast<float>(sortedValues.size())));
+	return sortedValues[std::clamp<std::size_t>(rank, 1, sortedValues.size()) - 1];
+}
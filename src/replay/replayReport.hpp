@@ -0,0 +1,30 @@
+#pragma once
+
+#include "profiling/zoneTimer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+class ReplayReport
+{
+public:
+	static constexpr float histogramBucketMs = 0.5f;
+	static constexpr int histogramBucketCount = 100;
+
+	void reserve(std::size_t frameCount);
+	void addFrame(float frameMs, float recordedFrameMs, const ZoneTimes& zoneTimes);
+	std::size_t getFrameCount() const;
+	bool write(const std::filesystem::path& path, const std::filesystem::path& logPath) const;
+
+private:
+	std::vector<float> m_frameMs{};
+	std::vector<float> m_recordedFrameMs{};
+	std::array<std::vector<float>, allocationZoneCount> m_zoneMs{};
+
+	static void writeDistribution(std::ostream& stream, std::vector<float> values);
+	static void writeHistogram(std::ostream& stream, const std::vector<float>& values);
+};
@@ -1,21 +1,28 @@
 #include "scene.hpp"
 
+#include "memory/allocationTracker.hpp"
 #include "shaderPrograms.hpp"
+#include "skeleton/bvhLoader.hpp"
 
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
 static constexpr float nearPlane = 0.1f;
 static constexpr float farPlane = 1000.0f;
 static constexpr float initFOVYDeg = 60.0f;
+static constexpr float skeletonHeight = 3.0f;
+static constexpr float skeletonJointScale = 0.5f;
 
 Scene::Scene(const glm::ivec2& viewportSize) :
 	m_viewportSize{viewportSize},
 	m_camera{glm::ivec2{m_viewportSize.x / 2, m_viewportSize.y}, nearPlane, farPlane, initFOVYDeg},
-	m_eulerFrames(m_intermediateFrameCount),
-	m_quatLinearFrames(m_intermediateFrameCount),
-	m_quatSlerpFrames(m_intermediateFrameCount),
-	m_interpolation{m_eulerFrame, m_eulerFrames, m_quatLinearFrame, m_quatLinearFrames,
-		m_quatSlerpFrame, m_quatSlerpFrames}
+	m_interpolation{m_frames, m_mainPositions}
 {
 	updateViewportSize();
 
@@ -37,36 +44,143 @@ Scene::Scene(const glm::ivec2& viewportSize) :
 
 void Scene::update()
 {
-	m_interpolation.update();
+	{
+		AllocationZoneScope zone{AllocationZone::skeletons};
+		pollSkeletonWorker();
+	}
+	{
+		AllocationZoneScope zone{AllocationZone::commands};
+		applyCommands();
+	}
+	{
+		AllocationZoneScope zone{AllocationZone::interpolation};
+		float prevTime = m_interpolation.getTime();
+		m_interpolation.update(std::exchange(m_lockedTicks, std::nullopt));
+		m_frameInterval = m_interpolation.getTime() - prevTime;
+		pollClipWorker();
+		updateClipFrame();
+	}
+	{
+		AllocationZoneScope zone{AllocationZone::skeletons};
+		updateSkeletons();
+	}
+	recordInput(InputEvents::EndFrame{m_interpolation.getTicks()});
 }
 
 void Scene::render()
 {
+	AllocationZoneScope zone{AllocationZone::rendering};
+	if (m_renderMotionBlur)
+	{
+		m_motionBlur.beginFrame();
+	}
+
+	m_renderer.beginFrame();
+
 	m_leftFramebuffer->bind();
 	clearFramebuffer();
-	m_camera.use();
-	renderFrames(m_interpolationTypeLeft);
+	m_camera.use(m_renderer);
+	renderFrames(m_interpolationTypeLeft, m_positionCurveLeft);
+	renderClipFrame();
+	renderSkeletons(m_skeletonMatricesLeft);
 	renderGrid();
+	m_renderer.flush();
 	m_leftFramebuffer->unbind();
 
 	m_rightFramebuffer->bind();
 	clearFramebuffer();
-	m_camera.use();
-	renderFrames(m_interpolationTypeRight);
+	m_camera.use(m_renderer);
+	renderFrames(m_interpolationTypeRight, m_positionCurveRight);
+	renderClipFrame();
+	renderSkeletons(m_skeletonMatricesRight);
 	renderGrid();
+	m_renderer.flush();
 	m_rightFramebuffer->unbind();
 
 	clearFramebuffer();
+	renderViewport(*m_leftFramebuffer, false);
+	renderViewport(*m_rightFramebuffer, true);
+	m_renderer.flush();
+	m_renderer.endFrame();
+
+	if (m_renderMotionBlur)
+	{
+		m_motionBlur.endFrame();
+	}
+}
+
+bool Scene::submitCommand(const SceneCommand& command)
+{
+	if (!m_commands.push({command, std::chrono::steady_clock::now()}))
+	{
+		m_rejectedCommandCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+SceneCommandStats Scene::getCommandStats() const
+{
+	SceneCommandStats stats = m_commandStats;
+	stats.rejectedCount = m_rejectedCommandCount.load(std::memory_order_relaxed);
+	return stats;
+}
+
+bool Scene::isRunning() const
+{
+	return m_interpolation.isRunning();
+}
+
+void Scene::getMemoryUsages(std::vector<MemoryUsage>& usages) const
+{
+	usages.clear();
 
-	m_leftFramebuffer->bindTexture();
-	ShaderPrograms::quad->use();
-	ShaderPrograms::quad->setUniform("right", false);
-	m_quad.render();
+	std::size_t intermediateFrameBytes = 0;
+	for (const InterpolationFrames& frames : m_frames)
+	{
+		intermediateFrameBytes += capacityBytes(frames.intermediateFrames);
+		for (const std::vector<glm::vec3>& positions : frames.intermediatePositions)
+		{
+			intermediateFrameBytes += capacityBytes(positions);
+		}
+	}
+	usages.push_back({"Intermediate frames", intermediateFrameBytes});
+	usages.push_back({"Pose cache", m_interpolation.getPoseCacheInfo().byteSize});
 
-	m_rightFramebuffer->bindTexture();
-	ShaderPrograms::quad->use();
-	ShaderPrograms::quad->setUniform("right", true);
-	m_quad.render();
+	std::size_t skeletonBytes = capacityBytes(m_skeletons) + capacityBytes(m_skeletonScales);
+	for (const SkeletalMotion& skeleton : m_skeletons)
+	{
+		skeletonBytes += SkeletalPlayback::getByteSize(skeleton);
+	}
+	usages.push_back({"Skeletal motions", skeletonBytes});
+
+	std::size_t hierarchyBytes = m_blendHierarchy.getByteSize() +
+		capacityBytes(m_skeletonHierarchiesLeft) + capacityBytes(m_skeletonHierarchiesRight);
+	for (const TransformHierarchy& hierarchy : m_skeletonHierarchiesLeft)
+	{
+		hierarchyBytes += hierarchy.getByteSize();
+	}
+	for (const TransformHierarchy& hierarchy : m_skeletonHierarchiesRight)
+	{
+		hierarchyBytes += hierarchy.getByteSize();
+	}
+	usages.push_back({"Skeleton hierarchies", hierarchyBytes});
+	usages.push_back({"Skeleton matrices",
+		capacityBytes(m_skeletonMatricesLeft) + capacityBytes(m_skeletonMatricesRight)});
+	usages.push_back({"Skeleton pose buffers",
+		SkeletalPlayback::getByteSize(m_skeletonPoseBuffers)});
+	usages.push_back({"Blend buffers", capacityBytes(m_blendLayers) +
+		capacityBytes(m_blendInputPositions) + capacityBytes(m_blendInputQuats) +
+		capacityBytes(m_blendWeights) + capacityBytes(m_blendPositions) +
+		capacityBytes(m_blendQuats)});
+	usages.push_back({"Motion blur",
+		capacityBytes(m_subFrameMatrices) + m_motionBlur.getByteSize()});
+	usages.push_back({"Command queue", sizeof(m_commands)});
+}
+
+const RenderStats& Scene::getRenderStats() const
+{
+	return m_renderer.getStats();
 }
 
 void Scene::updateViewportSize()
@@ -75,31 +189,57 @@ void Scene::updateViewportSize()
 	m_camera.setViewportSize(halfViewportSize);
 	m_leftFramebuffer = std::make_unique<Framebuffer>(halfViewportSize);
 	m_rightFramebuffer = std::make_unique<Framebuffer>(halfViewportSize);
+	recordInput(InputEvents::ResizeViewport{m_viewportSize});
+}
+
+void Scene::setInputRecorder(InputRecorder* recorder)
+{
+	m_inputRecorder = recorder;
+}
+
+bool Scene::isInputLocked() const
+{
+	return m_inputLocked;
+}
+
+void Scene::setInputLocked(bool locked)
+{
+	m_inputLocked = locked;
+}
+
+void Scene::lockClock(Clock::Ticks ticks)
+{
+	m_lockedTicks = ticks;
 }
 
 void Scene::addPitchCamera(float pitchRad)
 {
 	m_camera.addPitch(pitchRad);
+	recordInput(InputEvents::AddPitchCamera{pitchRad});
 }
 
 void Scene::addYawCamera(float yawRad)
 {
 	m_camera.addYaw(yawRad);
+	recordInput(InputEvents::AddYawCamera{yawRad});
 }
 
 void Scene::moveXCamera(float x)
 {
 	m_camera.moveX(x);
+	recordInput(InputEvents::MoveXCamera{x});
 }
 
 void Scene::moveYCamera(float y)
 {
 	m_camera.moveY(y);
+	recordInput(InputEvents::MoveYCamera{y});
 }
 
 void Scene::zoomCamera(float zoom)
 {
 	m_camera.zoom(zoom);
+	recordInput(InputEvents::ZoomCamera{zoom});
 }
 
 void Scene::updateCameraGUI()
@@ -142,6 +282,26 @@ void Scene::setInterpolationTypeRight(InterpolationType type)
 	m_interpolationTypeRight = type;
 }
 
+PositionCurveType Scene::getPositionCurveLeft() const
+{
+	return m_positionCurveLeft;
+}
+
+void Scene::setPositionCurveLeft(PositionCurveType type)
+{
+	m_positionCurveLeft = type;
+}
+
+PositionCurveType Scene::getPositionCurveRight() const
+{
+	return m_positionCurveRight;
+}
+
+void Scene::setPositionCurveRight(PositionCurveType type)
+{
+	m_positionCurveRight = type;
+}
+
 glm::vec3 Scene::getStartPos() const
 {
 	return m_interpolation.getStartPos();
@@ -212,6 +372,41 @@ void Scene::normalizeEndQuat()
 	m_interpolation.normalizeEndQuat();
 }
 
+int Scene::getPosKeyCount() const
+{
+	return m_interpolation.getPosKeyCount();
+}
+
+PositionKey Scene::getPosKey(int index) const
+{
+	return m_interpolation.getPosKey(index);
+}
+
+void Scene::setPosKey(int index, const PositionKey& key)
+{
+	m_interpolation.setPosKey(index, key);
+}
+
+void Scene::insertPosKey(int index)
+{
+	m_interpolation.insertPosKey(index);
+}
+
+void Scene::removePosKey(int index)
+{
+	m_interpolation.removePosKey(index);
+}
+
+bool Scene::getConstantSpeed() const
+{
+	return m_interpolation.getConstantSpeed();
+}
+
+void Scene::setConstantSpeed(bool constantSpeed)
+{
+	m_interpolation.setConstantSpeed(constantSpeed);
+}
+
 float Scene::getAnimationTime() const
 {
 	return m_interpolation.getEndTime();
@@ -219,21 +414,76 @@ float Scene::getAnimationTime() const
 
 void Scene::setAnimationTime(float time)
 {
-	m_interpolation.setEndTime(time);
+	if (std::isnan(time))
+	{
+		return;
+	}
+	m_interpolation.setEndTime(
+		std::clamp(time, Interpolator::minEndTime, Interpolator::maxEndTime));
+}
+
+TimeWarpSettings Scene::getTimeWarp() const
+{
+	return m_interpolation.getTimeWarp();
+}
+
+void Scene::setTimeWarp(const TimeWarpSettings& settings)
+{
+	m_interpolation.setTimeWarp(settings);
 }
 
 int Scene::getIntermediateFrameCount() const
 {
-	return m_intermediateFrameCount;
+	return m_interpolation.getSamplingSettings().budget;
 }
 
 void Scene::setIntermediateFrameCount(int count)
 {
-	m_intermediateFrameCount = count;
-	m_eulerFrames.resize(count);
-	m_quatLinearFrames.resize(count);
-	m_quatSlerpFrames.resize(count);
-	m_interpolation.updateFrames();
+	SamplingSettings settings = m_interpolation.getSamplingSettings();
+	settings.budget =
+		std::clamp(count, SamplingSettings::minBudget, SamplingSettings::maxBudget);
+	m_interpolation.setSamplingSettings(settings);
+}
+
+int Scene::getSampleCount(InterpolationType type) const
+{
+	return static_cast<int>(m_frames[static_cast<int>(type)].intermediateFrames.size());
+}
+
+bool Scene::getAdaptiveSampling() const
+{
+	return m_interpolation.getSamplingSettings().adaptive;
+}
+
+void Scene::setAdaptiveSampling(bool adaptive)
+{
+	SamplingSettings settings = m_interpolation.getSamplingSettings();
+	settings.adaptive = adaptive;
+	m_interpolation.setSamplingSettings(settings);
+}
+
+float Scene::getAngularTolerance() const
+{
+	return m_interpolation.getSamplingSettings().angularTolerance;
+}
+
+void Scene::setAngularTolerance(float tolerance)
+{
+	SamplingSettings settings = m_interpolation.getSamplingSettings();
+	settings.angularTolerance = tolerance;
+	m_interpolation.setSamplingSettings(settings);
+}
+
+float Scene::getPositionalTolerance() const
+{
+	return m_interpolation.getSamplingSettings().positionalTolerance;
+}
+
+void Scene::setPositionalTolerance(float tolerance)
+{
+	SamplingSettings settings = m_interpolation.getSamplingSettings();
+	settings.positionalTolerance = tolerance;
+	m_interpolation.setSamplingSettings(settings);
 }
 
 bool Scene::getRenderIntermediateFrames() const
@@ -246,11 +496,507 @@ void Scene::setRenderIntermediateFrames(bool render)
 	m_renderIntermediateFrames = render;
 }
 
+bool Scene::getRenderVelocities() const
+{
+	return m_renderVelocities;
+}
+
+void Scene::setRenderVelocities(bool render)
+{
+	m_renderVelocities = render;
+}
+
+PoseVelocity Scene::getMainVelocity(InterpolationType type, PositionCurveType curve) const
+{
+	return m_interpolation.getMainVelocity(type, curve);
+}
+
+bool Scene::getRenderMotionBlur() const
+{
+	return m_renderMotionBlur;
+}
+
+void Scene::setRenderMotionBlur(bool render)
+{
+	m_renderMotionBlur = render;
+}
+
+MotionBlurSettings Scene::getMotionBlurSettings() const
+{
+	return m_motionBlur.getSettings();
+}
+
+void Scene::setMotionBlurSettings(const MotionBlurSettings& settings)
+{
+	m_motionBlur.setSettings(settings);
+}
+
+int Scene::getMotionBlurSubFrameCount() const
+{
+	return m_motionBlur.getSubFrameCount();
+}
+
+float Scene::getMotionBlurFrameMs() const
+{
+	return m_motionBlur.getFrameMs();
+}
+
+ClockType Scene::getClockType() const
+{
+	return m_interpolation.getClockType();
+}
+
+void Scene::setClockType(ClockType type)
+{
+	m_interpolation.setClockType(type);
+}
+
 float Scene::getTime() const
 {
 	return m_interpolation.getTime();
 }
 
+void Scene::setTime(float time)
+{
+	m_interpolation.setTime(time);
+}
+
+bool Scene::getUseBakedCache() const
+{
+	return m_interpolation.getUseBakedCache();
+}
+
+void Scene::setUseBakedCache(bool useBakedCache)
+{
+	m_interpolation.setUseBakedCache(useBakedCache);
+}
+
+PoseCacheInfo Scene::getPoseCacheInfo() const
+{
+	return m_interpolation.getPoseCacheInfo();
+}
+
+const DivergenceMetrics& Scene::getDivergenceMetrics() const
+{
+	return m_interpolation.getDivergenceMetrics();
+}
+
+bool Scene::loadClip(const std::string& path)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	closeClip();
+	bool open = m_clip->open(path);
+	m_clipOpenMs = std::chrono::duration<float, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+	updateClipFrame();
+	return open;
+}
+
+void Scene::closeClip()
+{
+	m_compressionVersion = 0;
+	m_clipDecoder.setTrack(nullptr);
+	m_compressedClip.reset();
+	m_reductionVersion = 0;
+	m_reducedClipSampler.setTrack(nullptr, InterpolationType::quatSlerp);
+	m_reducedClip.reset();
+	m_clip = std::make_shared<MotionClip>();
+}
+
+void Scene::applyClipEndpoints()
+{
+	if (!m_clip->isOpen())
+	{
+		return;
+	}
+
+	ClipSample start = sampleClip(0);
+	ClipSample end = sampleClip(m_clip->getDuration());
+	setStartPos(start.pos);
+	setStartQuat(start.quat);
+	setEndPos(end.pos);
+	setEndQuat(end.quat);
+	if (m_clip->getDuration() > 0)
+	{
+		setAnimationTime(m_clip->getDuration());
+	}
+}
+
+MotionClipInfo Scene::getClipInfo() const
+{
+	if (!m_clip->isOpen())
+	{
+		return {};
+	}
+
+	return {true, m_clip->getSampleCount(), m_clip->getDuration(), m_clip->hasEulerAngles(),
+		m_clip->getByteSize(), m_clipOpenMs};
+}
+
+void Scene::compressClip(const CompressionSettings& settings)
+{
+	if (!m_clip->isOpen())
+	{
+		return;
+	}
+
+	m_compressionVersion = m_clipWorker.submitCompression(m_clip, settings);
+}
+
+const CompressionStats* Scene::getClipCompressionStats() const
+{
+	return m_compressedClip == nullptr ? nullptr : &m_compressedClip->getStats();
+}
+
+void Scene::reduceClip(InterpolationType type, const ReductionTolerances& tolerances)
+{
+	if (!m_clip->isOpen())
+	{
+		return;
+	}
+
+	m_reductionVersion = m_clipWorker.submitReduction(m_clip, type, tolerances);
+}
+
+const ReductionStats* Scene::getClipReductionStats() const
+{
+	return m_reducedClip == nullptr ? nullptr : &m_reductionStats;
+}
+
+ClipPlayback Scene::getClipPlayback() const
+{
+	return m_clipPlayback;
+}
+
+void Scene::setClipPlayback(ClipPlayback playback)
+{
+	m_clipPlayback = playback;
+	updateClipFrame();
+}
+
+void Scene::loadSkeletons(const std::vector<std::string>& paths)
+{
+	if (m_inputLocked)
+	{
+		addSkeletons(BvhLoader::loadAll({paths.begin(), paths.end()}));
+		return;
+	}
+
+	m_pendingSkeletonPaths.insert(m_pendingSkeletonPaths.end(), paths.begin(), paths.end());
+	m_skeletonLoadVersion = m_skeletonWorker.submit(m_pendingSkeletonPaths);
+}
+
+void Scene::clearSkeletons()
+{
+	m_pendingSkeletonPaths.clear();
+	m_skeletonLoadVersion = 0;
+	m_skeletons.clear();
+	m_skeletonInfos.clear();
+	m_skeletonScales.clear();
+	m_skeletonHierarchiesLeft.clear();
+	m_skeletonHierarchiesRight.clear();
+	m_skeletonMatricesLeft.clear();
+	m_skeletonMatricesRight.clear();
+	m_blendLayers.clear();
+	m_blendHierarchy = TransformHierarchy{};
+}
+
+bool Scene::isLoadingSkeletons() const
+{
+	return !m_pendingSkeletonPaths.empty();
+}
+
+const std::vector<SkeletalMotionInfo>& Scene::getSkeletonInfos() const
+{
+	return m_skeletonInfos;
+}
+
+bool Scene::getBlendSkeletons() const
+{
+	return m_blendSkeletons;
+}
+
+void Scene::setBlendSkeletons(bool blend)
+{
+	m_blendSkeletons = blend;
+	updateSkeletons();
+}
+
+bool Scene::canBlendSkeletons() const
+{
+	if (m_skeletons.size() < 2)
+	{
+		return false;
+	}
+	const std::vector<SkeletonJoint>& joints = m_skeletons.front().joints;
+	return joints.size() == m_blendHierarchy.getJointCount() &&
+		std::all_of(m_skeletons.begin() + 1, m_skeletons.end(),
+			[&joints] (const SkeletalMotion& skeleton)
+			{
+				return std::equal(skeleton.joints.begin(), skeleton.joints.end(),
+					joints.begin(), joints.end(),
+					[] (const SkeletonJoint& joint, const SkeletonJoint& reference)
+					{
+						return joint.parent == reference.parent;
+					});
+			});
+}
+
+BlendLayer Scene::getBlendLayer(int index) const
+{
+	return m_blendLayers[static_cast<std::size_t>(index)];
+}
+
+void Scene::setBlendLayer(int index, const BlendLayer& layer)
+{
+	if (index < 0 || static_cast<std::size_t>(index) >= m_blendLayers.size())
+	{
+		return;
+	}
+	m_blendLayers[static_cast<std::size_t>(index)] = layer;
+	updateSkeletons();
+}
+
+BlendMethod Scene::getBlendMethodLeft() const
+{
+	return m_blendMethodLeft;
+}
+
+void Scene::setBlendMethodLeft(BlendMethod method)
+{
+	m_blendMethodLeft = method;
+	updateSkeletons();
+}
+
+BlendMethod Scene::getBlendMethodRight() const
+{
+	return m_blendMethodRight;
+}
+
+void Scene::setBlendMethodRight(BlendMethod method)
+{
+	m_blendMethodRight = method;
+	updateSkeletons();
+}
+
+void Scene::recordInput(const InputEvent& event)
+{
+	if (m_inputRecorder != nullptr)
+	{
+		m_inputRecorder->record(event);
+	}
+}
+
+void Scene::applyCommands()
+{
+	std::size_t depth = m_commands.size();
+	m_commandStats.lastBatchSize = 0;
+	m_commandStats.lastMaxLatencyMs = 0;
+	m_commandStats.maxDepth = std::max(m_commandStats.maxDepth, depth);
+
+	QueuedCommand queuedCommand{};
+	for (std::size_t i = 0; i < depth && m_commands.pop(queuedCommand); ++i)
+	{
+		applyCommand(queuedCommand.command);
+		recordInput(InputEvents::ApplyCommand{std::move(queuedCommand.command)});
+
+		float latencyMs = std::chrono::duration<float, std::milli>(
+			std::chrono::steady_clock::now() - queuedCommand.submitTime).count();
+		++m_commandStats.lastBatchSize;
+		++m_commandStats.appliedCount;
+		m_commandLatencySumMs += latencyMs;
+		m_commandStats.lastMaxLatencyMs = std::max(m_commandStats.lastMaxLatencyMs, latencyMs);
+		m_commandStats.maxLatencyMs = std::max(m_commandStats.maxLatencyMs, latencyMs);
+		m_commandStats.averageLatencyMs =
+			static_cast<float>(m_commandLatencySumMs / m_commandStats.appliedCount);
+	}
+}
+
+void Scene::applyCommand(const SceneCommand& command)
+{
+	std::visit([this] (const auto& command)
+		{
+			using Command = std::decay_t<decltype(command)>;
+
+			if constexpr (std::is_same_v<Command, SceneCommands::SetInterpolationTypeLeft>)
+			{
+				setInterpolationTypeLeft(command.type);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetInterpolationTypeRight>)
+			{
+				setInterpolationTypeRight(command.type);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetPositionCurveLeft>)
+			{
+				setPositionCurveLeft(command.type);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetPositionCurveRight>)
+			{
+				setPositionCurveRight(command.type);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetStartPos>)
+			{
+				setStartPos(command.pos);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetStartEulerAngles>)
+			{
+				setStartEulerAngles(command.eulerAngles);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetStartQuat>)
+			{
+				setStartQuat(command.quat);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::NormalizeStartQuat>)
+			{
+				normalizeStartQuat();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetEndPos>)
+			{
+				setEndPos(command.pos);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetEndEulerAngles>)
+			{
+				setEndEulerAngles(command.eulerAngles);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetEndQuat>)
+			{
+				setEndQuat(command.quat);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::NormalizeEndQuat>)
+			{
+				normalizeEndQuat();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetPosKey>)
+			{
+				setPosKey(command.index, command.key);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::InsertPosKey>)
+			{
+				insertPosKey(command.index);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::RemovePosKey>)
+			{
+				removePosKey(command.index);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetConstantSpeed>)
+			{
+				setConstantSpeed(command.constantSpeed);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetAnimationTime>)
+			{
+				setAnimationTime(command.time);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetTimeWarp>)
+			{
+				setTimeWarp(command.settings);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetIntermediateFrameCount>)
+			{
+				setIntermediateFrameCount(command.count);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetAdaptiveSampling>)
+			{
+				setAdaptiveSampling(command.adaptive);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetAngularTolerance>)
+			{
+				setAngularTolerance(command.tolerance);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetPositionalTolerance>)
+			{
+				setPositionalTolerance(command.tolerance);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetRenderIntermediateFrames>)
+			{
+				setRenderIntermediateFrames(command.render);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetRenderVelocities>)
+			{
+				setRenderVelocities(command.render);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetRenderMotionBlur>)
+			{
+				setRenderMotionBlur(command.render);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetMotionBlurSettings>)
+			{
+				setMotionBlurSettings(command.settings);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetClockType>)
+			{
+				setClockType(command.type);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetTime>)
+			{
+				setTime(command.time);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetUseBakedCache>)
+			{
+				setUseBakedCache(command.useBakedCache);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::LoadClip>)
+			{
+				loadClip(command.path);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::CloseClip>)
+			{
+				closeClip();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::ApplyClipEndpoints>)
+			{
+				applyClipEndpoints();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::CompressClip>)
+			{
+				compressClip(command.settings);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::ReduceClip>)
+			{
+				reduceClip(command.type, command.tolerances);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetClipPlayback>)
+			{
+				setClipPlayback(command.playback);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::LoadSkeletons>)
+			{
+				loadSkeletons(command.paths);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::ClearSkeletons>)
+			{
+				clearSkeletons();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetBlendSkeletons>)
+			{
+				setBlendSkeletons(command.blend);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetBlendLayer>)
+			{
+				setBlendLayer(command.index, command.layer);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetBlendMethodLeft>)
+			{
+				setBlendMethodLeft(command.method);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::SetBlendMethodRight>)
+			{
+				setBlendMethodRight(command.method);
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::StartInterpolation>)
+			{
+				startInterpolation();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::StopInterpolation>)
+			{
+				stopInterpolation();
+			}
+			else if constexpr (std::is_same_v<Command, SceneCommands::ResetInterpolation>)
+			{
+				resetInterpolation();
+			}
+		}, command);
+}
+
 void Scene::setUpFramebuffer() const
 {
 	glEnable(GL_DEPTH_TEST);
@@ -267,37 +1013,250 @@ void Scene::clearFramebuffer() const
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void Scene::renderGrid() const
+void Scene::renderGrid()
+{
+	m_plane.render(m_renderer);
+}
+
+void Scene::renderViewport(const Framebuffer& framebuffer, bool right)
 {
-	m_plane.render();
+	DrawCommand command{};
+	command.pass = RenderPass::composite;
+	command.program = ShaderPrograms::quad.get();
+	command.texture = framebuffer.getTexture();
+	command.setUniform("right", right);
+	m_quad.render(m_renderer, command);
 }
 
-void Scene::renderFrames(InterpolationType type)
+void Scene::renderFrames(InterpolationType type, PositionCurveType curve)
 {
-	switch (type)
+	InterpolationFrames& frames = m_frames[static_cast<int>(type)];
+	const std::vector<glm::vec3>& positions =
+		frames.intermediatePositions[static_cast<int>(curve)];
+	if (!interpolatesPos(type) && positions.size() == frames.intermediateFrames.size())
+	{
+		frames.mainFrame.setPos(m_mainPositions[static_cast<int>(curve)]);
+		for (std::size_t i = 0; i < frames.intermediateFrames.size(); ++i)
+		{
+			frames.intermediateFrames[i].setPos(positions[i]);
+		}
+	}
+	if (m_renderMotionBlur)
+	{
+		renderMotionBlur(type, curve);
+	}
+	renderFrames(frames);
+	if (m_renderVelocities)
 	{
-		case InterpolationType::euler:
-			renderFrames(m_eulerFrame, m_eulerFrames);
-			break;
+		m_velocityVectors.render(m_renderer, frames.mainFrame.getPos(),
+			m_interpolation.getMainVelocity(type, curve));
+	}
+}
 
-		case InterpolationType::quatLinear:
-			renderFrames(m_quatLinearFrame, m_quatLinearFrames);
-			break;
+void Scene::renderFrames(const InterpolationFrames& frames)
+{
+	if (!m_renderMotionBlur)
+	{
+		frames.mainFrame.render(m_renderer);
+	}
+	if (m_renderIntermediateFrames)
+	{
+		for (const Frame& frame : frames.intermediateFrames)
+		{
+			frame.render(m_renderer);
+		}
+	}
+}
 
-		case InterpolationType::quatSlerp:
-			renderFrames(m_quatSlerpFrame, m_quatSlerpFrames);
-			break;
+void Scene::renderMotionBlur(InterpolationType type, PositionCurveType curve)
+{
+	const std::vector<float>& times =
+		m_motionBlur.getSubFrameTimes(m_interpolation.getTime(), m_frameInterval);
+	m_subFrameMatrices.resize(times.size());
+	m_interpolation.interpolateModelMatrices(type, curve, times.data(),
+		m_subFrameMatrices.data(), times.size());
+	m_motionBlur.render(m_renderer, m_subFrameMatrices.data(), m_subFrameMatrices.size());
+}
+
+void Scene::pollClipWorker()
+{
+	CompressionResult* compression = m_clipWorker.pollCompression();
+	if (compression != nullptr && compression->version == m_compressionVersion)
+	{
+		m_compressedClip = std::move(compression->track);
+		m_clipDecoder.setTrack(m_compressedClip.get());
+	}
+
+	ReductionResult* reduction = m_clipWorker.pollReduction();
+	if (reduction != nullptr && reduction->version == m_reductionVersion)
+	{
+		m_reducedClip = std::move(reduction->track);
+		m_reductionStats = reduction->stats;
+		m_reducedClipSampler.setTrack(m_reducedClip.get(), reduction->type);
 	}
 }
 
-void Scene::renderFrames(const Frame& mainFrame, const std::vector<Frame>& intermediateFrames) const
+void Scene::pollSkeletonWorker()
 {
-	mainFrame.render();
-	if (m_renderIntermediateFrames)
+	SkeletonLoadResult* result = m_skeletonWorker.poll();
+	if (result == nullptr || result->version != m_skeletonLoadVersion)
+	{
+		return;
+	}
+
+	m_pendingSkeletonPaths.clear();
+	float duration = addSkeletons(std::move(result->skeletons));
+	if (duration > 0)
+	{
+		setAnimationTime(duration);
+		recordInput(InputEvents::ApplyCommand{SceneCommands::SetAnimationTime{getAnimationTime()}});
+	}
+}
+
+float Scene::addSkeletons(std::vector<SkeletalMotion>&& skeletons)
+{
+	float duration = 0;
+	for (SkeletalMotion& skeleton : skeletons)
 	{
-		for (const Frame& frame : intermediateFrames)
+		TransformHierarchy hierarchy = SkeletalPlayback::createHierarchy(skeleton);
+		if (hierarchy.getJointCount() != skeleton.joints.size())
 		{
-			frame.render();
+			std::cerr << "Skeleton has a parent cycle:\n" << skeleton.name << '\n';
+			continue;
 		}
+
+		float extent = SkeletalPlayback::getRestExtent(skeleton);
+		m_skeletonScales.push_back(extent > 0 ? skeletonHeight / extent : 1);
+		duration = std::max(duration, SkeletalPlayback::getDuration(skeleton));
+		m_skeletonHierarchiesLeft.push_back(hierarchy);
+		m_skeletonHierarchiesRight.push_back(std::move(hierarchy));
+		m_skeletonInfos.push_back(SkeletalPlayback::getInfo(skeleton));
+		m_skeletons.push_back(std::move(skeleton));
+	}
+	m_blendLayers.resize(m_skeletons.size());
+	if (!m_skeletons.empty())
+	{
+		m_blendHierarchy = SkeletalPlayback::createHierarchy(m_skeletons.front());
+	}
+	updateSkeletons();
+	return duration;
+}
+
+void Scene::updateClipFrame()
+{
+	if (!m_clip->isOpen())
+	{
+		return;
+	}
+
+	ClipSample sample = sampleClip(getTime());
+	m_clipFrame.setModelMatrix(Frame::modelMatrix(sample.pos,
+		Frame::quatToRotationMatrix(sample.quat)));
+}
+
+ClipSample Scene::sampleClip(float time)
+{
+	if (m_clipPlayback == ClipPlayback::compressed && m_compressedClip != nullptr)
+	{
+		return m_clipDecoder.sample(time);
+	}
+	if (m_clipPlayback == ClipPlayback::reducedKeys && m_reducedClip != nullptr)
+	{
+		return m_reducedClipSampler.sample(time);
+	}
+
+	m_clip->prefetch(time);
+	return m_clip->sample(time);
+}
+
+void Scene::renderClipFrame()
+{
+	if (m_clip->isOpen())
+	{
+		m_clipFrame.render(m_renderer);
+	}
+}
+
+void Scene::updateSkeletons()
+{
+	updateSkeletonMatrices(m_interpolationTypeLeft, m_blendMethodLeft, m_skeletonHierarchiesLeft,
+		m_skeletonMatricesLeft);
+	updateSkeletonMatrices(m_interpolationTypeRight, m_blendMethodRight,
+		m_skeletonHierarchiesRight, m_skeletonMatricesRight);
+}
+
+void Scene::updateSkeletonMatrices(InterpolationType type, BlendMethod blendMethod,
+	std::vector<TransformHierarchy>& hierarchies, std::vector<glm::mat4>& matrices)
+{
+	matrices.clear();
+	float time = getTime();
+	for (std::size_t i = 0; i < m_skeletons.size(); ++i)
+	{
+		SkeletalPlayback::sample(m_skeletons[i], type, time, hierarchies[i],
+			m_skeletonPoseBuffers);
+	}
+
+	if (m_blendSkeletons && canBlendSkeletons())
+	{
+		blendSkeletons(blendMethod, hierarchies);
+		appendSkeletonMatrices(m_blendHierarchy, m_skeletonScales.front(), matrices);
+		return;
+	}
+	for (std::size_t i = 0; i < m_skeletons.size(); ++i)
+	{
+		appendSkeletonMatrices(hierarchies[i], m_skeletonScales[i], matrices);
+	}
+}
+
+void Scene::blendSkeletons(BlendMethod method, const std::vector<TransformHierarchy>& hierarchies)
+{
+	std::size_t inputCount = hierarchies.size();
+	std::size_t jointCount = m_blendHierarchy.getJointCount();
+	m_blendInputPositions.resize(inputCount * jointCount);
+	m_blendInputQuats.resize(inputCount * jointCount);
+	m_blendWeights.resize(inputCount * jointCount);
+	m_blendPositions.resize(jointCount);
+	m_blendQuats.resize(jointCount);
+
+	float animationTime = getAnimationTime();
+	float progress = animationTime > 0 ? std::clamp(getTime() / animationTime, 0.0f, 1.0f) : 0;
+	for (std::size_t input = 0; input < inputCount; ++input)
+	{
+		std::size_t offset = input * jointCount;
+		hierarchies[input].getLocalTransforms(m_blendInputPositions.data() + offset,
+			m_blendInputQuats.data() + offset);
+		const BlendLayer& layer = m_blendLayers[input];
+		float weight = std::max(layer.startWeight +
+			(layer.endWeight - layer.startWeight) * progress, 0.0f);
+		std::fill_n(m_blendWeights.begin() + static_cast<std::ptrdiff_t>(offset), jointCount,
+			weight);
+	}
+
+	m_blender.blend(method, inputCount, jointCount, m_blendInputPositions.data(),
+		m_blendInputQuats.data(), m_blendWeights.data(), m_blendPositions.data(),
+		m_blendQuats.data());
+	m_blendHierarchy.setLocalTransforms(m_blendPositions.data(), m_blendQuats.data());
+	m_blendHierarchy.updateWorldMatrices();
+}
+
+void Scene::appendSkeletonMatrices(const TransformHierarchy& hierarchy, float scale,
+	std::vector<glm::mat4>& matrices) const
+{
+	for (glm::mat4 matrix : hierarchy.getSortedWorldMatrices())
+	{
+		matrix[0] *= skeletonJointScale;
+		matrix[1] *= skeletonJointScale;
+		matrix[2] *= skeletonJointScale;
+		matrix[3] = glm::vec4{scale * glm::vec3{matrix[3]}, 1};
+		matrices.push_back(matrix);
+	}
+}
+
+void Scene::renderSkeletons(const std::vector<glm::mat4>& matrices)
+{
+	for (const glm::mat4& matrix : matrices)
+	{
+		m_skeletonFrame.setModelMatrix(matrix);
+		m_skeletonFrame.render(m_renderer);
 	}
 }
@@ -1,16 +1,47 @@
 #pragma once
 
+#include "blend/blendMethod.hpp"
+#include "blend/motionBlender.hpp"
 #include "camera/perspectiveCamera.hpp"
+#include "clip/clipPlayback.hpp"
+#include "clip/clipWorker.hpp"
+#include "clip/compressedTrack.hpp"
+#include "clip/keyframeReduction.hpp"
+#include "clip/motionClip.hpp"
+#include "clock/clockType.hpp"
+#include "concurrency/spscQueue.hpp"
+#include "divergenceMetrics.hpp"
 #include "framebuffer.hpp"
 #include "frame.hpp"
 #include "interpolation.hpp"
+#include "interpolationFrames.hpp"
 #include "interpolationType.hpp"
+#include "math/positionSpline.hpp"
+#include "math/timeWarp.hpp"
+#include "memory/memoryUsage.hpp"
+#include "motionBlur.hpp"
 #include "plane/plane.hpp"
+#include "poseCache.hpp"
+#include "positionCurveType.hpp"
 #include "quad.hpp"
+#include "render/renderer.hpp"
+#include "replay/inputEvent.hpp"
+#include "replay/inputRecorder.hpp"
+#include "sceneCommand.hpp"
+#include "skeleton/skeletalMotion.hpp"
+#include "skeleton/skeletonWorker.hpp"
+#include "skeleton/transformHierarchy.hpp"
+#include "velocityVectors.hpp"
 
 #include <glm/glm.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 class Scene
@@ -19,8 +50,18 @@ public:
 	Scene(const glm::ivec2& viewportSize);
 	void update();
 	void render();
+	bool submitCommand(const SceneCommand& command);
+	SceneCommandStats getCommandStats() const;
+	bool isRunning() const;
+	void getMemoryUsages(std::vector<MemoryUsage>& usages) const;
+	const RenderStats& getRenderStats() const;
 	void updateViewportSize();
 
+	void setInputRecorder(InputRecorder* recorder);
+	bool isInputLocked() const;
+	void setInputLocked(bool locked);
+	void lockClock(Clock::Ticks ticks);
+
 	void addPitchCamera(float pitchRad);
 	void addYawCamera(float yawRad);
 	void moveXCamera(float x);
@@ -37,6 +78,10 @@ public:
 	void setInterpolationTypeLeft(InterpolationType type);
 	InterpolationType getInterpolationTypeRight() const;
 	void setInterpolationTypeRight(InterpolationType type);
+	PositionCurveType getPositionCurveLeft() const;
+	void setPositionCurveLeft(PositionCurveType type);
+	PositionCurveType getPositionCurveRight() const;
+	void setPositionCurveRight(PositionCurveType type);
 
 	glm::vec3 getStartPos() const;
 	void setStartPos(const glm::vec3& pos);
@@ -54,43 +99,175 @@ public:
 	void setEndQuat(const glm::vec4& quat);
 	void normalizeEndQuat();
 
+	int getPosKeyCount() const;
+	PositionKey getPosKey(int index) const;
+	void setPosKey(int index, const PositionKey& key);
+	void insertPosKey(int index);
+	void removePosKey(int index);
+	bool getConstantSpeed() const;
+	void setConstantSpeed(bool constantSpeed);
+
 	float getAnimationTime() const;
 	void setAnimationTime(float time);
+	TimeWarpSettings getTimeWarp() const;
+	void setTimeWarp(const TimeWarpSettings& settings);
 	int getIntermediateFrameCount() const;
 	void setIntermediateFrameCount(int count);
+	int getSampleCount(InterpolationType type) const;
+	bool getAdaptiveSampling() const;
+	void setAdaptiveSampling(bool adaptive);
+	float getAngularTolerance() const;
+	void setAngularTolerance(float tolerance);
+	float getPositionalTolerance() const;
+	void setPositionalTolerance(float tolerance);
 	bool getRenderIntermediateFrames() const;
 	void setRenderIntermediateFrames(bool render);
+	bool getRenderVelocities() const;
+	void setRenderVelocities(bool render);
+	PoseVelocity getMainVelocity(InterpolationType type, PositionCurveType curve) const;
+	bool getRenderMotionBlur() const;
+	void setRenderMotionBlur(bool render);
+	MotionBlurSettings getMotionBlurSettings() const;
+	void setMotionBlurSettings(const MotionBlurSettings& settings);
+	int getMotionBlurSubFrameCount() const;
+	float getMotionBlurFrameMs() const;
+	ClockType getClockType() const;
+	void setClockType(ClockType type);
 	float getTime() const;
+	void setTime(float time);
+	bool getUseBakedCache() const;
+	void setUseBakedCache(bool useBakedCache);
+	PoseCacheInfo getPoseCacheInfo() const;
+	const DivergenceMetrics& getDivergenceMetrics() const;
+	bool loadClip(const std::string& path);
+	void closeClip();
+	void applyClipEndpoints();
+	MotionClipInfo getClipInfo() const;
+	void compressClip(const CompressionSettings& settings);
+	const CompressionStats* getClipCompressionStats() const;
+	void reduceClip(InterpolationType type, const ReductionTolerances& tolerances);
+	const ReductionStats* getClipReductionStats() const;
+	ClipPlayback getClipPlayback() const;
+	void setClipPlayback(ClipPlayback playback);
+	void loadSkeletons(const std::vector<std::string>& paths);
+	void clearSkeletons();
+	bool isLoadingSkeletons() const;
+	const std::vector<SkeletalMotionInfo>& getSkeletonInfos() const;
+	bool getBlendSkeletons() const;
+	void setBlendSkeletons(bool blend);
+	bool canBlendSkeletons() const;
+	BlendLayer getBlendLayer(int index) const;
+	void setBlendLayer(int index, const BlendLayer& layer);
+	BlendMethod getBlendMethodLeft() const;
+	void setBlendMethodLeft(BlendMethod method);
+	BlendMethod getBlendMethodRight() const;
+	void setBlendMethodRight(BlendMethod method);
 
 private:
+	struct QueuedCommand
+	{
+		SceneCommand command{};
+		std::chrono::steady_clock::time_point submitTime{};
+	};
+
 	const glm::ivec2& m_viewportSize{};
 	PerspectiveCamera m_camera;
 
 	std::unique_ptr<Framebuffer> m_leftFramebuffer;
 	std::unique_ptr<Framebuffer> m_rightFramebuffer;
 	Quad m_quad{};
+	Renderer m_renderer{};
 
 	static constexpr float m_gridScale = 5.0f;
 	Plane m_plane{m_gridScale};
 
-	int m_intermediateFrameCount = 30;
-
-	Frame m_eulerFrame{false};
-	std::vector<Frame> m_eulerFrames;
-	Frame m_quatLinearFrame{false};
-	std::vector<Frame> m_quatLinearFrames;
-	Frame m_quatSlerpFrame{false};
-	std::vector<Frame> m_quatSlerpFrames;
+	InterpolationFramesArray m_frames{};
+	MainPositionsArray m_mainPositions{};
 
 	Interpolation m_interpolation;
 	InterpolationType m_interpolationTypeLeft = InterpolationType::euler;
 	InterpolationType m_interpolationTypeRight = InterpolationType::quatSlerp;
+	PositionCurveType m_positionCurveLeft = PositionCurveType::linear;
+	PositionCurveType m_positionCurveRight = PositionCurveType::linear;
 	bool m_renderIntermediateFrames = false;
+	bool m_renderVelocities = false;
+	VelocityVectors m_velocityVectors{};
+	bool m_renderMotionBlur = false;
+	MotionBlur m_motionBlur{};
+	float m_frameInterval{};
+	std::vector<glm::mat4> m_subFrameMatrices{};
+
+	std::shared_ptr<MotionClip> m_clip = std::make_shared<MotionClip>();
+	Frame m_clipFrame{false};
+	float m_clipOpenMs{};
+	std::shared_ptr<const CompressedTrack> m_compressedClip{};
+	CompressedTrackDecoder m_clipDecoder{};
+	std::uint64_t m_compressionVersion = 0;
+	std::shared_ptr<const KeyframeTrack> m_reducedClip{};
+	KeyframeTrackSampler m_reducedClipSampler{};
+	ReductionStats m_reductionStats{};
+	std::uint64_t m_reductionVersion = 0;
+	ClipPlayback m_clipPlayback = ClipPlayback::mapped;
+	ClipWorker m_clipWorker{};
+	SkeletonWorker m_skeletonWorker{};
+	std::vector<std::string> m_pendingSkeletonPaths{};
+	std::uint64_t m_skeletonLoadVersion = 0;
+
+	std::vector<SkeletalMotion> m_skeletons{};
+	std::vector<SkeletalMotionInfo> m_skeletonInfos{};
+	std::vector<float> m_skeletonScales{};
+	std::vector<TransformHierarchy> m_skeletonHierarchiesLeft{};
+	std::vector<TransformHierarchy> m_skeletonHierarchiesRight{};
+	std::vector<glm::mat4> m_skeletonMatricesLeft{};
+	std::vector<glm::mat4> m_skeletonMatricesRight{};
+	SkeletalPoseBuffers m_skeletonPoseBuffers{};
+	Frame m_skeletonFrame{true};
+
+	bool m_blendSkeletons = false;
+	std::vector<BlendLayer> m_blendLayers{};
+	BlendMethod m_blendMethodLeft = BlendMethod::nlerp;
+	BlendMethod m_blendMethodRight = BlendMethod::markley;
+	MotionBlender m_blender{};
+	TransformHierarchy m_blendHierarchy{};
+	std::vector<glm::vec3> m_blendInputPositions{};
+	std::vector<glm::vec4> m_blendInputQuats{};
+	std::vector<float> m_blendWeights{};
+	std::vector<glm::vec3> m_blendPositions{};
+	std::vector<glm::vec4> m_blendQuats{};
+
+	static constexpr std::size_t m_commandQueueCapacity = 1024;
+	SpscQueue<QueuedCommand, m_commandQueueCapacity> m_commands{};
+	std::atomic<std::uint64_t> m_rejectedCommandCount = 0;
+	SceneCommandStats m_commandStats{};
+	double m_commandLatencySumMs = 0;
+
+	InputRecorder* m_inputRecorder{};
+	bool m_inputLocked = false;
+	std::optional<Clock::Ticks> m_lockedTicks{};
+
+	void recordInput(const InputEvent& event);
+	void applyCommands();
+	void applyCommand(const SceneCommand& command);
 
 	void setUpFramebuffer() const;
 	void clearFramebuffer() const;
 
-	void renderGrid() const;
-	void renderFrames(InterpolationType type);
-	void renderFrames(const Frame& mainFrame, const std::vector<Frame>& intermediateFrames) const;
+	void renderGrid();
+	void renderViewport(const Framebuffer& framebuffer, bool right);
+	void renderFrames(InterpolationType type, PositionCurveType curve);
+	void renderFrames(const InterpolationFrames& frames);
+	void renderMotionBlur(InterpolationType type, PositionCurveType curve);
+	void pollClipWorker();
+	void pollSkeletonWorker();
+	float addSkeletons(std::vector<SkeletalMotion>&& skeletons);
+	void updateClipFrame();
+	ClipSample sampleClip(float time);
+	void renderClipFrame();
+	void updateSkeletons();
+	void updateSkeletonMatrices(InterpolationType type, BlendMethod blendMethod,
+		std::vector<TransformHierarchy>& hierarchies, std::vector<glm::mat4>& matrices);
+	void blendSkeletons(BlendMethod method, const std::vector<TransformHierarchy>& hierarchies);
+	void appendSkeletonMatrices(const TransformHierarchy& hierarchy, float scale,
+		std::vector<glm::mat4>& matrices) const;
+	void renderSkeletons(const std::vector<glm::mat4>& matrices);
 };
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "blend/blendMethod.hpp"
+#include "blend/motionBlender.hpp"
+#include "clip/clipPlayback.hpp"
+#include "clip/compressedTrack.hpp"
+#include "clip/keyframeReduction.hpp"
+#include "clock/clockType.hpp"
+#include "interpolationType.hpp"
+#include "math/positionSpline.hpp"
+#include "math/timeWarp.hpp"
+#include "motionBlur.hpp"
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace SceneCommands
+{
+	struct SetInterpolationTypeLeft { InterpolationType type; };
+	struct SetInterpolationTypeRight { InterpolationType type; };
+	struct SetPositionCurveLeft { PositionCurveType type; };
+	struct SetPositionCurveRight { PositionCurveType type; };
+
+	struct SetStartPos { glm::vec3 pos; };
+	struct SetStartEulerAngles { glm::vec3 eulerAngles; };
+	struct SetStartQuat { glm::vec4 quat; };
+	struct NormalizeStartQuat { };
+
+	struct SetEndPos { glm::vec3 pos; };
+	struct SetEndEulerAngles { glm::vec3 eulerAngles; };
+	struct SetEndQuat { glm::vec4 quat; };
+	struct NormalizeEndQuat { };
+
+	struct SetPosKey { int index; PositionKey key; };
+	struct InsertPosKey { int index; };
+	struct RemovePosKey { int index; };
+	struct SetConstantSpeed { bool constantSpeed; };
+
+	struct SetAnimationTime { float time; };
+	struct SetTimeWarp { TimeWarpSettings settings; };
+	struct SetIntermediateFrameCount { int count; };
+	struct SetAdaptiveSampling { bool adaptive; };
+	struct SetAngularTolerance { float tolerance; };
+	struct SetPositionalTolerance { float tolerance; };
+	struct SetRenderIntermediateFrames { bool render; };
+	struct SetRenderVelocities { bool render; };
+	struct SetRenderMotionBlur { bool render; };
+	struct SetMotionBlurSettings { MotionBlurSettings settings; };
+	struct SetClockType { ClockType type; };
+	struct SetTime { float time; };
+	struct SetUseBakedCache { bool useBakedCache; };
+
+	struct LoadClip { std::string path; };
+	struct CloseClip { };
+	struct ApplyClipEndpoints { };
+	struct CompressClip { CompressionSettings settings; };
+	struct ReduceClip { InterpolationType type; ReductionTolerances tolerances; };
+	struct SetClipPlayback { ClipPlayback playback; };
+
+	struct LoadSkeletons { std::vector<std::string> paths; };
+	struct ClearSkeletons { };
+	struct SetBlendSkeletons { bool blend; };
+	struct SetBlendLayer { int index; BlendLayer layer; };
+	struct SetBlendMethodLeft { BlendMethod method; };
+	struct SetBlendMethodRight { BlendMethod method; };
+
+	struct StartInterpolation { };
+	struct StopInterpolation { };
+	struct ResetInterpolation { };
+}
+
+using SceneCommand = std::variant
+<
+	SceneCommands::SetInterpolationTypeLeft,
+	SceneCommands::SetInterpolationTypeRight,
+	SceneCommands::SetPositionCurveLeft,
+	SceneCommands::SetPositionCurveRight,
+	SceneCommands::SetStartPos,
+	SceneCommands::SetStartEulerAngles,
+	SceneCommands::SetStartQuat,
+	SceneCommands::NormalizeStartQuat,
+	SceneCommands::SetEndPos,
+	SceneCommands::SetEndEulerAngles,
+	SceneCommands::SetEndQuat,
+	SceneCommands::NormalizeEndQuat,
+	SceneCommands::SetPosKey,
+	SceneCommands::InsertPosKey,
+	SceneCommands::RemovePosKey,
+	SceneCommands::SetConstantSpeed,
+	SceneCommands::SetAnimationTime,
+	SceneCommands::SetTimeWarp,
+	SceneCommands::SetIntermediateFrameCount,
+	SceneCommands::SetAdaptiveSampling,
+	SceneCommands::SetAngularTolerance,
+	SceneCommands::SetPositionalTolerance,
+	SceneCommands::SetRenderIntermediateFrames,
+	SceneCommands::SetRenderVelocities,
+	SceneCommands::SetRenderMotionBlur,
+	SceneCommands::SetMotionBlurSettings,
+	SceneCommands::SetClockType,
+	SceneCommands::SetTime,
+	SceneCommands::SetUseBakedCache,
+	SceneCommands::LoadClip,
+	SceneCommands::CloseClip,
+	SceneCommands::ApplyClipEndpoints,
+	SceneCommands::CompressClip,
+	SceneCommands::ReduceClip,
+	SceneCommands::SetClipPlayback,
+	SceneCommands::LoadSkeletons,
+	SceneCommands::ClearSkeletons,
+	SceneCommands::SetBlendSkeletons,
+	SceneCommands::SetBlendLayer,
+	SceneCommands::SetBlendMethodLeft,
+	SceneCommands::SetBlendMethodRight,
+	SceneCommands::StartInterpolation,
+	SceneCommands::StopInterpolation,
+	SceneCommands::ResetInterpolation
+>;
+
+struct SceneCommandStats
+{
+	std::size_t lastBatchSize{};
+	std::size_t maxDepth{};
+	std::uint64_t appliedCount{};
+	std::uint64_t rejectedCount{};
+	float lastMaxLatencyMs{};
+	float maxLatencyMs{};
+	float averageLatencyMs{};
+};
@@ -1,5 +1,7 @@
 #include "shaderProgram.hpp"
 
+#include "memory/glResourceTracker.hpp"
+
 #include <glm/gtc/type_ptr.hpp>
 
 #include <array>
@@ -41,6 +43,7 @@ ShaderProgram::ShaderProgram(const std::string& vertexShaderPath,
 ShaderProgram::~ShaderProgram()
 {
 	glDeleteProgram(m_id);
+	GLResourceTracker::remove(GLResourceType::program);
 }
 
 void ShaderProgram::use() const
@@ -48,50 +51,55 @@ void ShaderProgram::use() const
 	glUseProgram(m_id);
 }
 
-void ShaderProgram::setUniform(const std::string& name, bool value) const
+unsigned int ShaderProgram::getId() const
+{
+	return m_id;
+}
+
+void ShaderProgram::setUniform(const char* name, bool value) const
 {
-	glUniform1i(glGetUniformLocation(m_id, name.c_str()), static_cast<int>(value));
+	glUniform1i(glGetUniformLocation(m_id, name), static_cast<int>(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, int value) const
+void ShaderProgram::setUniform(const char* name, int value) const
 {
-	glUniform1i(glGetUniformLocation(m_id, name.c_str()), value);
+	glUniform1i(glGetUniformLocation(m_id, name), value);
 }
 
-void ShaderProgram::setUniform(const std::string& name, float value) const
+void ShaderProgram::setUniform(const char* name, float value) const
 {
-	glUniform1f(glGetUniformLocation(m_id, name.c_str()), value);
+	glUniform1f(glGetUniformLocation(m_id, name), value);
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::ivec2& value) const
+void ShaderProgram::setUniform(const char* name, const glm::ivec2& value) const
 {
-	glUniform2iv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform2iv(glGetUniformLocation(m_id, name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::vec2& value) const
+void ShaderProgram::setUniform(const char* name, const glm::vec2& value) const
 {
-	glUniform2fv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform2fv(glGetUniformLocation(m_id, name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::vec3& value) const
+void ShaderProgram::setUniform(const char* name, const glm::vec3& value) const
 {
-	glUniform3fv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform3fv(glGetUniformLocation(m_id, name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::vec4& value) const
+void ShaderProgram::setUniform(const char* name, const glm::vec4& value) const
 {
-	glUniform4fv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform4fv(glGetUniformLocation(m_id, name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::mat3& value) const
+void ShaderProgram::setUniform(const char* name, const glm::mat3& value) const
 {
-	glUniformMatrix3fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE,
+	glUniformMatrix3fv(glGetUniformLocation(m_id, name), 1, GL_FALSE,
 		glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::mat4& value) const
+void ShaderProgram::setUniform(const char* name, const glm::mat4& value) const
 {
-	glUniformMatrix4fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE,
+	glUniformMatrix4fv(glGetUniformLocation(m_id, name), 1, GL_FALSE,
 		glm::value_ptr(value));
 }
 
@@ -105,6 +113,7 @@ ShaderProgram::ShaderProgram(const std::vector<std::string>& shaderPaths,
 	}
 	m_id = createShaderProgram(shaders);
 	deleteShaders(shaders);
+	GLResourceTracker::add(GLResourceType::program);
 }
 
 unsigned int ShaderProgram::createShader(const std::string& shaderPath, GLenum shaderType)
@@ -22,16 +22,17 @@ public:
 	ShaderProgram& operator=(ShaderProgram&&) = delete;
 
 	void use() const;
-
-	void setUniform(const std::string& name, bool value) const;
-	void setUniform(const std::string& name, int value) const;
-	void setUniform(const std::string& name, float value) const;
-	void setUniform(const std::string& name, const glm::ivec2& value) const;
-	void setUniform(const std::string& name, const glm::vec2& value) const;
-	void setUniform(const std::string& name, const glm::vec3& value) const;
-	void setUniform(const std::string& name, const glm::vec4& value) const;
-	void setUniform(const std::string& name, const glm::mat3& value) const;
-	void setUniform(const std::string& name, const glm::mat4& value) const;
+	unsigned int getId() const;
+
+	void setUniform(const char* name, bool value) const;
+	void setUniform(const char* name, int value) const;
+	void setUniform(const char* name, float value) const;
+	void setUniform(const char* name, const glm::ivec2& value) const;
+	void setUniform(const char* name, const glm::vec2& value) const;
+	void setUniform(const char* name, const glm::vec3& value) const;
+	void setUniform(const char* name, const glm::vec4& value) const;
+	void setUniform(const char* name, const glm::mat3& value) const;
+	void setUniform(const char* name, const glm::mat4& value) const;
 
 private:
 	unsigned int m_id{};
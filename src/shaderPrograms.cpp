@@ -7,15 +7,21 @@ namespace ShaderPrograms
 	std::string path(const std::string& shaderName);
 
 	std::unique_ptr<const ShaderProgram> frame{};
+	std::unique_ptr<const ShaderProgram> motionBlur{};
 	std::unique_ptr<const ShaderProgram> plane{};
 	std::unique_ptr<const ShaderProgram> quad{};
+	std::unique_ptr<const ShaderProgram> velocity{};
 
 	void init()
 	{
 		frame = std::make_unique<const ShaderProgram>(path("frameVS"), path("frameGS"),
 			path("frameFS"));
+		motionBlur = std::make_unique<const ShaderProgram>(path("motionBlurVS"),
+			path("motionBlurGS"), path("motionBlurFS"));
 		plane = std::make_unique<const ShaderProgram>(path("planeVS"), path("planeFS"));
 		quad = std::make_unique<const ShaderProgram>(path("quadVS"), path("quadFS"));
+		velocity = std::make_unique<const ShaderProgram>(path("velocityVS"), path("velocityGS"),
+			path("frameFS"));
 	}
 
 	std::string path(const std::string& shaderName)
@@ -9,6 +9,8 @@ namespace ShaderPrograms
 	void init();
 
 	extern std::unique_ptr<const ShaderProgram> frame;
+	extern std::unique_ptr<const ShaderProgram> motionBlur;
 	extern std::unique_ptr<const ShaderProgram> plane;
 	extern std::unique_ptr<const ShaderProgram> quad;
+	extern std::unique_ptr<const ShaderProgram> velocity;
 }
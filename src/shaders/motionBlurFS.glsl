@@ -0,0 +1,11 @@
+#version 420 core
+
+in vec3 color;
+in float alpha;
+
+out vec4 outColor;
+
+void main()
+{
+	outColor = vec4(color, alpha);
+}
@@ -0,0 +1,16 @@
+#version 420 core
+
+layout (location = 0) in mat4 inModelMatrix;
+layout (location = 4) in float inAlpha;
+
+uniform mat4 projectionViewMatrix;
+
+out mat4 modelMatrix;
+out float instanceAlpha;
+
+void main()
+{
+	modelMatrix = inModelMatrix;
+	instanceAlpha = inAlpha;
+	gl_Position = projectionViewMatrix * inModelMatrix * vec4(0, 0, 0, 1);
+}
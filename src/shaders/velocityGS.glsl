@@ -0,0 +1,28 @@
+#version 420 core
+
+layout (points) in;
+
+uniform vec3 linearVelocity;
+uniform vec3 angularVelocity;
+uniform mat4 projectionViewMatrix;
+
+layout (line_strip, max_vertices = 4) out;
+out vec3 color;
+
+void emitVector(vec3 vectorWorld, vec3 vectorColor);
+
+void main()
+{
+	emitVector(linearVelocity, vec3(1, 1, 0));
+	emitVector(angularVelocity, vec3(1, 0, 1));
+}
+
+void emitVector(vec3 vectorWorld, vec3 vectorColor)
+{
+	color = vectorColor;
+	gl_Position = gl_in[0].gl_Position;
+	EmitVertex();
+	gl_Position = gl_in[0].gl_Position + projectionViewMatrix * vec4(vectorWorld, 0);
+	EmitVertex();
+	EndPrimitive();
+}
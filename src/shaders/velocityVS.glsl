@@ -0,0 +1,9 @@
+#version 420 core
+
+uniform vec3 pos;
+uniform mat4 projectionViewMatrix;
+
+void main()
+{
+	gl_Position = projectionViewMatrix * vec4(pos, 1);
+}
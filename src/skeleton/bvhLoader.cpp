@@ -0,0 +1,481 @@
+#include "skeleton/bvhLoader.hpp"
+
+#include "clip/mappedFile.hpp"
+#include "concurrency/parallelFor.hpp"
+#include "math/eulerOrder.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+static constexpr std::size_t frameGrainSize = 1024;
+static constexpr int maxFastDigitCount = 19;
+static constexpr float degreesToRadians = glm::pi<float>() / 180;
+
+static constexpr std::array<double, maxFastDigitCount + 1> powersOfTen
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+};
+
+struct ChannelTarget
+{
+	bool rotation{};
+	std::uint32_t offset{};
+};
+
+static const char* scanFloat(const char* begin, const char* end, float& value)
+{
+	const char* current = begin;
+	bool negative = current != end && *current == '-';
+	if (current != end && (*current == '-' || *current == '+'))
+	{
+		++current;
+	}
+
+	std::uint64_t mantissa = 0;
+	const char* integerBegin = current;
+	for (; current != end && static_cast<unsigned>(*current - '0') <= 9; ++current)
+	{
+		mantissa = 10 * mantissa + static_cast<unsigned>(*current - '0');
+	}
+	std::ptrdiff_t digitCount = current - integerBegin;
+	std::ptrdiff_t fractionDigitCount = 0;
+	if (current != end && *current == '.')
+	{
+		const char* fractionBegin = ++current;
+		for (; current != end && static_cast<unsigned>(*current - '0') <= 9; ++current)
+		{
+			mantissa = 10 * mantissa + static_cast<unsigned>(*current - '0');
+		}
+		fractionDigitCount = current - fractionBegin;
+		digitCount += fractionDigitCount;
+	}
+
+	if (digitCount == 0 || digitCount > maxFastDigitCount ||
+		(current != end && (*current == 'e' || *current == 'E')))
+	{
+		begin += begin != end && *begin == '+' ? 1 : 0;
+		std::from_chars_result result = std::from_chars(begin, end, value);
+		return result.ec == std::errc{} ? result.ptr : nullptr;
+	}
+
+	double magnitude = static_cast<double>(mantissa) / powersOfTen[fractionDigitCount];
+	value = static_cast<float>(negative ? -magnitude : magnitude);
+	return current;
+}
+
+static bool parseFloat(std::string_view token, float& value)
+{
+	const char* end = token.data() + token.size();
+	return scanFloat(token.data(), end, value) == end;
+}
+
+static bool isSpace(char character)
+{
+	return static_cast<unsigned char>(character) <= ' ';
+}
+
+static const char* skipSpace(const char* current, const char* end)
+{
+	while (current != end && isSpace(*current))
+	{
+		++current;
+	}
+	return current;
+}
+
+static bool nextFloat(const char*& current, const char* end, float& value)
+{
+	current = skipSpace(current, end);
+	const char* numberEnd = scanFloat(current, end, value);
+	if (numberEnd == nullptr || (numberEnd != end && !isSpace(*numberEnd)))
+	{
+		return false;
+	}
+	current = numberEnd;
+	return true;
+}
+
+class BvhTokenizer
+{
+public:
+	BvhTokenizer(const std::filesystem::path& path)
+	{
+		if (m_file.open(path))
+		{
+			m_file.adviseSequential();
+			m_current = reinterpret_cast<const char*>(m_file.getData());
+			m_end = m_current + m_file.getSize();
+		}
+	}
+
+	bool isOpen() const
+	{
+		return m_file.isOpen();
+	}
+
+	std::string_view next()
+	{
+		m_current = skipSpace(m_current, m_end);
+		const char* begin = m_current;
+		while (m_current != m_end && !isSpace(*m_current))
+		{
+			++m_current;
+		}
+		return {begin, static_cast<std::size_t>(m_current - begin)};
+	}
+
+	std::string_view getRemaining() const
+	{
+		return {m_current, static_cast<std::size_t>(m_end - m_current)};
+	}
+
+private:
+	MappedFile m_file{};
+	const char* m_current = nullptr;
+	const char* m_end = nullptr;
+};
+
+static bool parseInt(std::string_view token, std::size_t& value)
+{
+	const char* end = token.data() + token.size();
+	std::from_chars_result result = std::from_chars(token.data(), end, value);
+	return result.ec == std::errc{} && result.ptr == end;
+}
+
+static bool parseVec3(BvhTokenizer& tokenizer, glm::vec3& vec)
+{
+	return parseFloat(tokenizer.next(), vec.x) && parseFloat(tokenizer.next(), vec.y) &&
+		parseFloat(tokenizer.next(), vec.z);
+}
+
+static bool parseEndSite(BvhTokenizer& tokenizer)
+{
+	glm::vec3 offset{};
+	return tokenizer.next() == "Site" && tokenizer.next() == "{" &&
+		tokenizer.next() == "OFFSET" && parseVec3(tokenizer, offset) && tokenizer.next() == "}";
+}
+
+static int channelAxis(std::string_view channel, std::string_view suffix)
+{
+	if (channel.size() != suffix.size() + 1 || channel.substr(1) != suffix)
+	{
+		return -1;
+	}
+	switch (channel.front())
+	{
+		case 'X': case 'x': return 0;
+		case 'Y': case 'y': return 1;
+		case 'Z': case 'z': return 2;
+		default: return -1;
+	}
+}
+
+static bool parseChannels(BvhTokenizer& tokenizer, SkeletalMotion& motion, std::size_t joint,
+	std::vector<ChannelTarget>& targets)
+{
+	std::size_t channelCount = 0;
+	if (!parseInt(tokenizer.next(), channelCount) || channelCount > 6)
+	{
+		return false;
+	}
+
+	std::array<int, 3> rotationAxes{};
+	std::size_t rotationCount = 0;
+	std::array<std::size_t, 3> rotationTargets{};
+	std::size_t firstTarget = targets.size();
+	bool hasTranslation = false;
+	for (std::size_t i = 0; i < channelCount; ++i)
+	{
+		std::string_view channel = tokenizer.next();
+		int positionAxis = channelAxis(channel, "position");
+		int rotationAxis = channelAxis(channel, "rotation");
+		if (positionAxis >= 0)
+		{
+			hasTranslation = true;
+			targets.push_back({false, static_cast<std::uint32_t>(positionAxis)});
+		}
+		else if (rotationAxis >= 0 && rotationCount < rotationAxes.size() &&
+			std::find(rotationAxes.begin(), rotationAxes.begin() + rotationCount, rotationAxis) ==
+				rotationAxes.begin() + rotationCount)
+		{
+			rotationAxes[rotationCount] = rotationAxis;
+			rotationTargets[rotationCount] = targets.size();
+			++rotationCount;
+			targets.push_back({true, 0});
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	SkeletonJoint& skeletonJoint = motion.joints[joint];
+	if (hasTranslation)
+	{
+		skeletonJoint.translationIndex = static_cast<int>(motion.translationCount++);
+		for (std::size_t i = firstTarget; i < targets.size(); ++i)
+		{
+			if (!targets[i].rotation)
+			{
+				targets[i].offset += 3 * static_cast<std::uint32_t>(skeletonJoint.translationIndex);
+			}
+		}
+	}
+
+	std::size_t listedCount = rotationCount;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (std::find(rotationAxes.begin(), rotationAxes.begin() + rotationCount, axis) ==
+			rotationAxes.begin() + rotationCount)
+		{
+			rotationAxes[rotationCount++] = axis;
+		}
+	}
+
+	std::string label{};
+	for (std::size_t i = rotationAxes.size(); i-- > 0;)
+	{
+		label += static_cast<char>('X' + rotationAxes[i]);
+	}
+	skeletonJoint.eulerOrder = static_cast<EulerOrder>(std::find(eulerOrderLabels.begin(),
+		eulerOrderLabels.end(), label) - eulerOrderLabels.begin());
+
+	for (std::size_t i = 0; i < listedCount; ++i)
+	{
+		targets[rotationTargets[i]].offset =
+			3 * static_cast<std::uint32_t>(joint) + static_cast<std::uint32_t>(2 - i);
+	}
+	return true;
+}
+
+static bool parseHierarchy(BvhTokenizer& tokenizer, SkeletalMotion& motion,
+	std::vector<ChannelTarget>& targets)
+{
+	if (tokenizer.next() != "HIERARCHY")
+	{
+		return false;
+	}
+
+	std::vector<std::size_t> stack{};
+	while (true)
+	{
+		std::string_view token = tokenizer.next();
+		if (token == "ROOT" || token == "JOINT")
+		{
+			if ((token == "ROOT") != stack.empty())
+			{
+				return false;
+			}
+			SkeletonJoint joint{};
+			joint.name = tokenizer.next();
+			joint.parent = stack.empty() ? -1 : static_cast<int>(stack.back());
+			if (joint.name.empty() || tokenizer.next() != "{")
+			{
+				return false;
+			}
+			stack.push_back(motion.joints.size());
+			motion.joints.push_back(std::move(joint));
+		}
+		else if (token == "OFFSET")
+		{
+			if (stack.empty() || !parseVec3(tokenizer, motion.joints[stack.back()].offset))
+			{
+				return false;
+			}
+		}
+		else if (token == "CHANNELS")
+		{
+			if (stack.empty() || !parseChannels(tokenizer, motion, stack.back(), targets))
+			{
+				return false;
+			}
+		}
+		else if (token == "End")
+		{
+			if (stack.empty() || !parseEndSite(tokenizer))
+			{
+				return false;
+			}
+		}
+		else if (token == "}")
+		{
+			if (stack.empty())
+			{
+				return false;
+			}
+			stack.pop_back();
+		}
+		else
+		{
+			return token == "MOTION" && stack.empty() && !motion.joints.empty();
+		}
+	}
+}
+
+static bool findFrameLines(std::string_view data, std::size_t frameCount,
+	std::vector<const char*>& lines)
+{
+	const char* current = data.data();
+	const char* end = data.data() + data.size();
+	lines.reserve(std::min(frameCount, data.size()) + 1);
+	while (current != end)
+	{
+		const char* lineEnd = static_cast<const char*>(
+			std::memchr(current, '\n', static_cast<std::size_t>(end - current)));
+		lineEnd = lineEnd == nullptr ? end : lineEnd + 1;
+		if (skipSpace(current, lineEnd) != lineEnd)
+		{
+			if (lines.size() == frameCount)
+			{
+				return false;
+			}
+			lines.push_back(current);
+		}
+		current = lineEnd;
+	}
+	lines.push_back(end);
+	return lines.size() == frameCount + 1;
+}
+
+static bool parseFrame(const char*& current, const char* end,
+	const std::vector<ChannelTarget>& targets, const std::array<float*, 2>& frameData)
+{
+	for (const ChannelTarget& target : targets)
+	{
+		float value{};
+		if (!nextFloat(current, end, value))
+		{
+			return false;
+		}
+		frameData[target.rotation][target.offset] =
+			target.rotation ? value * degreesToRadians : value;
+	}
+	return true;
+}
+
+static bool parseMotion(BvhTokenizer& tokenizer, SkeletalMotion& motion,
+	const std::vector<ChannelTarget>& targets)
+{
+	if (tokenizer.next() != "Frames:" || !parseInt(tokenizer.next(), motion.frameCount) ||
+		tokenizer.next() != "Frame" || tokenizer.next() != "Time:" ||
+		!parseFloat(tokenizer.next(), motion.frameTime) || motion.frameTime < 0)
+	{
+		return false;
+	}
+
+	std::string_view data = tokenizer.getRemaining();
+	if (!targets.empty() && motion.frameCount > (data.size() + 1) / 2 / targets.size())
+	{
+		return false;
+	}
+
+	std::size_t jointCount = motion.joints.size();
+	motion.translations.resize(motion.frameCount * motion.translationCount);
+	motion.eulerAngles.resize(motion.frameCount * jointCount);
+	float* translations = reinterpret_cast<float*>(motion.translations.data());
+	float* eulerAngles = reinterpret_cast<float*>(motion.eulerAngles.data());
+	auto getFrameData = [&] (std::size_t frame) -> std::array<float*, 2>
+	{
+		return {translations + 3 * frame * motion.translationCount,
+			eulerAngles + 3 * frame * jointCount};
+	};
+
+	std::vector<const char*> lines{};
+	if (findFrameLines(data, motion.frameCount, lines))
+	{
+		std::atomic<bool> parsed = true;
+		parallelFor(motion.frameCount, frameGrainSize,
+			[&] (std::size_t begin, std::size_t end)
+			{
+				for (std::size_t frame = begin; frame < end; ++frame)
+				{
+					const char* current = lines[frame];
+					const char* lineEnd = lines[frame + 1];
+					if (!parseFrame(current, lineEnd, targets, getFrameData(frame)) ||
+						skipSpace(current, lineEnd) != lineEnd)
+					{
+						parsed.store(false, std::memory_order_relaxed);
+						return;
+					}
+				}
+			});
+		return parsed.load(std::memory_order_relaxed);
+	}
+
+	const char* current = data.data();
+	const char* end = data.data() + data.size();
+	for (std::size_t frame = 0; frame < motion.frameCount; ++frame)
+	{
+		if (!parseFrame(current, end, targets, getFrameData(frame)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+namespace BvhLoader
+{
+	bool load(const std::filesystem::path& path, SkeletalMotion& motion)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		motion = {};
+		BvhTokenizer tokenizer{path};
+		if (!tokenizer.isOpen())
+		{
+			std::cerr << "Error reading file:\n" << path.string() << '\n';
+			return false;
+		}
+
+		std::vector<ChannelTarget> targets{};
+		if (!parseHierarchy(tokenizer, motion, targets) ||
+			!parseMotion(tokenizer, motion, targets))
+		{
+			std::cerr << "Error parsing BVH file:\n" << path.string() << '\n';
+			motion = {};
+			return false;
+		}
+
+		motion.name = path.stem().string();
+		motion.loadMs = std::chrono::duration<float, std::milli>(
+			std::chrono::steady_clock::now() - start).count();
+		return true;
+	}
+
+	std::vector<SkeletalMotion> loadAll(const std::vector<std::filesystem::path>& paths)
+	{
+		std::vector<SkeletalMotion> motions(paths.size());
+		std::vector<std::uint8_t> loaded(paths.size());
+		parallelFor(paths.size(), 1,
+			[&] (std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					loaded[i] = load(paths[i], motions[i]);
+				}
+			});
+
+		std::vector<SkeletalMotion> result{};
+		for (std::size_t i = 0; i < paths.size(); ++i)
+		{
+			if (loaded[i] != 0)
+			{
+				result.push_back(std::move(motions[i]));
+			}
+		}
+		return result;
+	}
+}
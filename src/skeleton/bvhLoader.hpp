@@ -0,0 +1,12 @@
+#pragma once
+
+#include "skeleton/skeletalMotion.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace BvhLoader
+{
+	bool load(const std::filesystem::path& path, SkeletalMotion& motion);
+	std::vector<SkeletalMotion> loadAll(const std::vector<std::filesystem::path>& paths);
+}
@@ -0,0 +1,143 @@
+#include "skeleton/skeletalMotion.hpp"
+
+#include "math/eulerAngles.hpp"
+#include "memory/memoryUsage.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static glm::vec3 localTranslation(const SkeletalMotion& motion, std::size_t frame,
+	std::size_t joint)
+{
+	const SkeletonJoint& skeletonJoint = motion.joints[joint];
+	if (skeletonJoint.translationIndex < 0)
+	{
+		return skeletonJoint.offset;
+	}
+	return skeletonJoint.offset + motion.translations[frame * motion.translationCount +
+		static_cast<std::size_t>(skeletonJoint.translationIndex)];
+}
+
+namespace SkeletalPlayback
+{
+	float getDuration(const SkeletalMotion& motion)
+	{
+		if (motion.frameCount < 2)
+		{
+			return 0;
+		}
+		return static_cast<float>(motion.frameCount - 1) * motion.frameTime;
+	}
+
+	float getRestExtent(const SkeletalMotion& motion)
+	{
+		std::vector<glm::vec3> positions(motion.joints.size());
+		glm::vec3 min{};
+		glm::vec3 max{};
+		for (std::size_t i = 0; i < motion.joints.size(); ++i)
+		{
+			const SkeletonJoint& joint = motion.joints[i];
+			positions[i] = joint.parent < 0 ? glm::vec3{} :
+				positions[static_cast<std::size_t>(joint.parent)] + joint.offset;
+			min = glm::min(min, positions[i]);
+			max = glm::max(max, positions[i]);
+		}
+		glm::vec3 size = max - min;
+		return std::max({size.x, size.y, size.z});
+	}
+
+	SkeletalMotionInfo getInfo(const SkeletalMotion& motion)
+	{
+		return {motion.name, motion.joints.size(), motion.frameCount, getDuration(motion),
+			motion.loadMs};
+	}
+
+	std::size_t getByteSize(const SkeletalMotion& motion)
+	{
+		std::size_t byteSize = capacityBytes(motion.joints) + capacityBytes(motion.translations) +
+			capacityBytes(motion.eulerAngles);
+		for (const SkeletonJoint& joint : motion.joints)
+		{
+			byteSize += joint.name.capacity();
+		}
+		return byteSize;
+	}
+
+	std::size_t getByteSize(const SkeletalPoseBuffers& buffers)
+	{
+		return capacityBytes(buffers.startPositions) + capacityBytes(buffers.endPositions) +
+			capacityBytes(buffers.startQuats) + capacityBytes(buffers.endQuats);
+	}
+
+	TransformHierarchy createHierarchy(const SkeletalMotion& motion)
+	{
+		std::vector<int> parents(motion.joints.size());
+		std::vector<EulerOrder> eulerOrders(motion.joints.size());
+		for (std::size_t i = 0; i < motion.joints.size(); ++i)
+		{
+			parents[i] = motion.joints[i].parent;
+			eulerOrders[i] = motion.joints[i].eulerOrder;
+		}
+		return TransformHierarchy{parents, eulerOrders};
+	}
+
+	void sample(const SkeletalMotion& motion, InterpolationType type, float time,
+		TransformHierarchy& hierarchy, SkeletalPoseBuffers& buffers)
+	{
+		std::size_t jointCount = motion.joints.size();
+		if (motion.frameCount == 0 || hierarchy.getJointCount() != jointCount)
+		{
+			return;
+		}
+
+		float framePosition = motion.frameTime > 0 ?
+			std::clamp(time, 0.0f, getDuration(motion)) / motion.frameTime : 0;
+		std::size_t first = std::min(static_cast<std::size_t>(framePosition),
+			motion.frameCount - 1);
+		std::size_t second = std::min(first + 1, motion.frameCount - 1);
+		float t = std::clamp(framePosition - static_cast<float>(first), 0.0f, 1.0f);
+
+		buffers.startPositions.resize(jointCount);
+		buffers.endPositions.resize(jointCount);
+		buffers.startQuats.resize(jointCount);
+		buffers.endQuats.resize(jointCount);
+		glm::vec3* startPositions = buffers.startPositions.data();
+		glm::vec3* endPositions = buffers.endPositions.data();
+		glm::vec4* startQuats = buffers.startQuats.data();
+		glm::vec4* endQuats = buffers.endQuats.data();
+		for (std::size_t joint = 0; joint < jointCount; ++joint)
+		{
+			startPositions[joint] = localTranslation(motion, first, joint);
+			endPositions[joint] = localTranslation(motion, second, joint);
+		}
+
+		const glm::vec3* firstAngles = motion.eulerAngles.data() + first * jointCount;
+		const glm::vec3* secondAngles = motion.eulerAngles.data() + second * jointCount;
+		if (type == InterpolationType::euler)
+		{
+			for (std::size_t joint = 0; joint < jointCount; ++joint)
+			{
+				startPositions[joint] += (endPositions[joint] - startPositions[joint]) * t;
+				startQuats[joint] = EulerAngles::toQuat(motion.joints[joint].eulerOrder,
+					firstAngles[joint] + (secondAngles[joint] - firstAngles[joint]) * t);
+			}
+			hierarchy.setLocalTransforms(startPositions, startQuats);
+		}
+		else
+		{
+			for (std::size_t joint = 0; joint < jointCount; ++joint)
+			{
+				EulerOrder order = motion.joints[joint].eulerOrder;
+				startQuats[joint] = EulerAngles::toQuat(order, firstAngles[joint]);
+				endQuats[joint] = EulerAngles::toQuat(order, secondAngles[joint]);
+				if (glm::dot(startQuats[joint], endQuats[joint]) < 0)
+				{
+					endQuats[joint] = -endQuats[joint];
+				}
+			}
+			hierarchy.interpolateLocalTransforms(type, startPositions, startQuats, endPositions,
+				endQuats, t);
+		}
+		hierarchy.updateWorldMatrices();
+	}
+}
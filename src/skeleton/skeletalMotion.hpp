@@ -0,0 +1,62 @@
+#pragma once
+
+#include "interpolationType.hpp"
+#include "math/eulerOrder.hpp"
+#include "skeleton/transformHierarchy.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct SkeletonJoint
+{
+	std::string name{};
+	int parent = -1;
+	glm::vec3 offset{};
+	EulerOrder eulerOrder = EulerOrder::xyz;
+	int translationIndex = -1;
+};
+
+struct SkeletalMotion
+{
+	std::string name{};
+	std::vector<SkeletonJoint> joints{};
+	std::size_t translationCount{};
+	std::size_t frameCount{};
+	float frameTime{};
+	std::vector<glm::vec3> translations{};
+	std::vector<glm::vec3> eulerAngles{};
+	float loadMs{};
+};
+
+struct SkeletalMotionInfo
+{
+	std::string name{};
+	std::size_t jointCount{};
+	std::size_t frameCount{};
+	float duration{};
+	float loadMs{};
+};
+
+struct SkeletalPoseBuffers
+{
+	std::vector<glm::vec3> startPositions{};
+	std::vector<glm::vec3> endPositions{};
+	std::vector<glm::vec4> startQuats{};
+	std::vector<glm::vec4> endQuats{};
+};
+
+namespace SkeletalPlayback
+{
+	float getDuration(const SkeletalMotion& motion);
+	float getRestExtent(const SkeletalMotion& motion);
+	SkeletalMotionInfo getInfo(const SkeletalMotion& motion);
+	std::size_t getByteSize(const SkeletalMotion& motion);
+	std::size_t getByteSize(const SkeletalPoseBuffers& buffers);
+
+	TransformHierarchy createHierarchy(const SkeletalMotion& motion);
+	void sample(const SkeletalMotion& motion, InterpolationType type, float time,
+		TransformHierarchy& hierarchy, SkeletalPoseBuffers& buffers);
+}
@@ -0,0 +1,62 @@
+#include "skeleton/skeletonWorker.hpp"
+
+#include "memory/allocationTracker.hpp"
+#include "skeleton/bvhLoader.hpp"
+
+#include <filesystem>
+
+SkeletonWorker::SkeletonWorker() :
+	m_thread{&SkeletonWorker::run, this}
+{ }
+
+SkeletonWorker::~SkeletonWorker()
+{
+	m_stopRequested.store(true, std::memory_order_release);
+	m_submittedVersion.fetch_add(1, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	m_thread.join();
+}
+
+std::uint64_t SkeletonWorker::submit(const std::vector<std::string>& paths)
+{
+	Job& job = m_jobs.back();
+	job.version = ++m_lastVersion;
+	job.paths = paths;
+	m_jobs.publish();
+
+	m_submittedVersion.store(m_lastVersion, std::memory_order_release);
+	m_submittedVersion.notify_one();
+	return m_lastVersion;
+}
+
+SkeletonLoadResult* SkeletonWorker::poll()
+{
+	return m_results.update() ? &m_results.front() : nullptr;
+}
+
+void SkeletonWorker::run()
+{
+	AllocationTracker::setZone(AllocationZone::skeletons);
+	std::uint64_t seenVersion = 0;
+	while (true)
+	{
+		m_submittedVersion.wait(seenVersion, std::memory_order_acquire);
+		seenVersion = m_submittedVersion.load(std::memory_order_acquire);
+		if (m_stopRequested.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if (m_jobs.update())
+		{
+			load(m_jobs.front(), m_results.back());
+			m_results.publish();
+		}
+	}
+}
+
+void SkeletonWorker::load(const Job& job, SkeletonLoadResult& result)
+{
+	result.version = job.version;
+	result.skeletons = BvhLoader::loadAll({job.paths.begin(), job.paths.end()});
+}
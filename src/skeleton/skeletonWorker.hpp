@@ -0,0 +1,48 @@
+#pragma once
+
+#include "concurrency/tripleBuffer.hpp"
+#include "skeleton/skeletalMotion.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SkeletonLoadResult
+{
+	std::uint64_t version{};
+	std::vector<SkeletalMotion> skeletons{};
+};
+
+class SkeletonWorker
+{
+public:
+	SkeletonWorker();
+	SkeletonWorker(const SkeletonWorker&) = delete;
+	SkeletonWorker(SkeletonWorker&&) = delete;
+	~SkeletonWorker();
+
+	SkeletonWorker& operator=(const SkeletonWorker&) = delete;
+	SkeletonWorker& operator=(SkeletonWorker&&) = delete;
+
+	std::uint64_t submit(const std::vector<std::string>& paths);
+	SkeletonLoadResult* poll();
+
+private:
+	struct Job
+	{
+		std::uint64_t version{};
+		std::vector<std::string> paths{};
+	};
+
+	TripleBuffer<Job> m_jobs{};
+	TripleBuffer<SkeletonLoadResult> m_results{};
+	std::uint64_t m_lastVersion = 0;
+	std::atomic<std::uint64_t> m_submittedVersion = 0;
+	std::atomic<bool> m_stopRequested = false;
+	std::thread m_thread;
+
+	void run();
+	void load(const Job& job, SkeletonLoadResult& result);
+};
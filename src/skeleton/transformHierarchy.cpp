@@ -0,0 +1,354 @@
+#include "skeleton/transformHierarchy.hpp"
+
+#include "concurrency/parallelFor.hpp"
+#include "interpolator.hpp"
+#include "math/dualQuat.hpp"
+#include "math/dualQuatScLerp.hpp"
+#include "math/eulerAngles.hpp"
+#include "math/fastSlerp.hpp"
+#include "memory/memoryUsage.hpp"
+
+#include <cmath>
+
+static constexpr std::size_t interpolationGrainSize = 4096;
+
+static glm::vec4 slerp(const glm::vec4& start, const glm::vec4& end, float t)
+{
+	glm::vec4 startInv{-glm::vec3{start}, start.w};
+	glm::vec4 product = Interpolator::quatProduct(startInv, end);
+	glm::vec3 productV = product;
+	float angle = 2 * std::atan2(glm::length(productV), product.w) * t;
+	glm::vec3 axis = productV == glm::vec3{0, 0, 0} ? glm::vec3{0, 0, 0} : glm::normalize(productV);
+	return Interpolator::quatProduct(start,
+		glm::vec4{std::sin(angle / 2.0f) * axis, std::cos(angle / 2.0f)});
+}
+
+TransformHierarchy::TransformHierarchy(const std::vector<int>& parents,
+	const std::vector<EulerOrder>& eulerOrders)
+{
+	std::size_t jointCount = parents.size();
+	std::vector<std::size_t> childOffsets(jointCount + 1);
+	std::vector<std::uint32_t> roots{};
+	for (std::size_t joint = 0; joint < jointCount; ++joint)
+	{
+		int parent = parents[joint];
+		if (parent < 0 || static_cast<std::size_t>(parent) >= jointCount)
+		{
+			roots.push_back(static_cast<std::uint32_t>(joint));
+		}
+		else
+		{
+			++childOffsets[static_cast<std::size_t>(parent) + 1];
+		}
+	}
+	for (std::size_t joint = 0; joint < jointCount; ++joint)
+	{
+		childOffsets[joint + 1] += childOffsets[joint];
+	}
+	std::vector<std::uint32_t> children(childOffsets.back());
+	std::vector<std::size_t> childCounts(jointCount);
+	for (std::size_t joint = 0; joint < jointCount; ++joint)
+	{
+		int parent = parents[joint];
+		if (parent >= 0 && static_cast<std::size_t>(parent) < jointCount)
+		{
+			std::size_t index = static_cast<std::size_t>(parent);
+			children[childOffsets[index] + childCounts[index]++] =
+				static_cast<std::uint32_t>(joint);
+		}
+	}
+
+	std::vector<std::uint32_t> preorder{};
+	std::vector<std::uint32_t> stack{roots.rbegin(), roots.rend()};
+	while (!stack.empty())
+	{
+		std::uint32_t joint = stack.back();
+		stack.pop_back();
+		preorder.push_back(joint);
+		for (std::size_t i = childOffsets[joint + 1]; i-- > childOffsets[joint];)
+		{
+			stack.push_back(children[i]);
+		}
+	}
+	if (preorder.size() != jointCount)
+	{
+		return;
+	}
+
+	std::vector<std::size_t> subtreeSizes(jointCount, 1);
+	for (std::size_t i = preorder.size(); i-- > 0;)
+	{
+		int parent = parents[preorder[i]];
+		if (parent >= 0 && static_cast<std::size_t>(parent) < jointCount)
+		{
+			subtreeSizes[static_cast<std::size_t>(parent)] += subtreeSizes[preorder[i]];
+		}
+	}
+
+	std::vector<std::uint32_t> subtreeRoots{};
+	stack.assign(roots.rbegin(), roots.rend());
+	while (!stack.empty())
+	{
+		std::uint32_t joint = stack.back();
+		stack.pop_back();
+		if (subtreeSizes[joint] <= subtreeGrainSize)
+		{
+			subtreeRoots.push_back(joint);
+			continue;
+		}
+		m_joints.push_back(joint);
+		for (std::size_t i = childOffsets[joint + 1]; i-- > childOffsets[joint];)
+		{
+			stack.push_back(children[i]);
+		}
+	}
+	m_trunkSize = m_joints.size();
+
+	for (std::uint32_t subtreeRoot : subtreeRoots)
+	{
+		std::size_t begin = m_joints.size();
+		stack.assign(1, subtreeRoot);
+		while (!stack.empty())
+		{
+			std::uint32_t joint = stack.back();
+			stack.pop_back();
+			m_joints.push_back(joint);
+			for (std::size_t i = childOffsets[joint + 1]; i-- > childOffsets[joint];)
+			{
+				stack.push_back(children[i]);
+			}
+		}
+		m_subtrees.push_back({begin, m_joints.size()});
+	}
+
+	std::size_t sortedCount = m_joints.size();
+	m_sortedIndices.resize(jointCount);
+	for (std::size_t i = 0; i < sortedCount; ++i)
+	{
+		m_sortedIndices[m_joints[i]] = static_cast<std::uint32_t>(i);
+	}
+	m_sortedParents.resize(sortedCount);
+	for (std::size_t i = 0; i < sortedCount; ++i)
+	{
+		int parent = parents[m_joints[i]];
+		m_sortedParents[i] = parent < 0 || static_cast<std::size_t>(parent) >= jointCount ? -1 :
+			static_cast<std::int32_t>(m_sortedIndices[static_cast<std::size_t>(parent)]);
+	}
+
+	for (std::vector<float>& component : m_localPositions)
+	{
+		component.resize(sortedCount);
+	}
+	for (std::vector<float>& component : m_localQuats)
+	{
+		component.resize(sortedCount);
+	}
+	m_localQuats[3].assign(sortedCount, 1);
+	m_localMatrices.resize(sortedCount);
+	m_worldMatrices.resize(sortedCount, glm::mat4{1});
+	m_eulerOrders = eulerOrders;
+	m_eulerOrders.resize(jointCount, EulerOrder::xyz);
+}
+
+std::size_t TransformHierarchy::getJointCount() const
+{
+	return m_joints.size();
+}
+
+std::size_t TransformHierarchy::getSortedIndex(std::size_t joint) const
+{
+	return m_sortedIndices[joint];
+}
+
+std::size_t TransformHierarchy::getJoint(std::size_t sortedIndex) const
+{
+	return m_joints[sortedIndex];
+}
+
+std::size_t TransformHierarchy::getSubtreeCount() const
+{
+	return m_subtrees.size();
+}
+
+std::size_t TransformHierarchy::getByteSize() const
+{
+	std::size_t byteSize = capacityBytes(m_joints) + capacityBytes(m_sortedIndices) +
+		capacityBytes(m_sortedParents) + capacityBytes(m_eulerOrders) + capacityBytes(m_subtrees) +
+		capacityBytes(m_localMatrices) + capacityBytes(m_worldMatrices);
+	for (const std::vector<float>& positions : m_localPositions)
+	{
+		byteSize += capacityBytes(positions);
+	}
+	for (const std::vector<float>& quats : m_localQuats)
+	{
+		byteSize += capacityBytes(quats);
+	}
+	return byteSize;
+}
+
+int TransformHierarchy::getParent(std::size_t joint) const
+{
+	std::int32_t parent = m_sortedParents[m_sortedIndices[joint]];
+	return parent < 0 ? -1 : static_cast<int>(m_joints[static_cast<std::size_t>(parent)]);
+}
+
+glm::vec3 TransformHierarchy::getLocalPosition(std::size_t joint) const
+{
+	std::size_t index = m_sortedIndices[joint];
+	return {m_localPositions[0][index], m_localPositions[1][index], m_localPositions[2][index]};
+}
+
+glm::vec4 TransformHierarchy::getLocalQuat(std::size_t joint) const
+{
+	std::size_t index = m_sortedIndices[joint];
+	return {m_localQuats[0][index], m_localQuats[1][index], m_localQuats[2][index],
+		m_localQuats[3][index]};
+}
+
+void TransformHierarchy::getLocalTransforms(glm::vec3* positions, glm::vec4* quats) const
+{
+	for (std::size_t joint = 0; joint < m_joints.size(); ++joint)
+	{
+		positions[joint] = getLocalPosition(joint);
+		quats[joint] = getLocalQuat(joint);
+	}
+}
+
+void TransformHierarchy::setLocalTransform(std::size_t joint, const glm::vec3& pos,
+	const glm::vec4& quat)
+{
+	std::size_t index = m_sortedIndices[joint];
+	for (int i = 0; i < 3; ++i)
+	{
+		m_localPositions[i][index] = pos[i];
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		m_localQuats[i][index] = quat[i];
+	}
+}
+
+void TransformHierarchy::setLocalTransforms(const glm::vec3* positions, const glm::vec4* quats)
+{
+	for (std::size_t joint = 0; joint < m_joints.size(); ++joint)
+	{
+		setLocalTransform(joint, positions[joint], quats[joint]);
+	}
+}
+
+void TransformHierarchy::interpolateLocalTransforms(InterpolationType type,
+	const glm::vec3* startPositions, const glm::vec4* startQuats, const glm::vec3* endPositions,
+	const glm::vec4* endQuats, float t)
+{
+	parallelFor(m_joints.size(), interpolationGrainSize,
+		[&] (std::size_t begin, std::size_t end)
+		{
+			for (std::size_t joint = begin; joint < end; ++joint)
+			{
+				glm::vec3 pos = startPositions[joint] +
+					(endPositions[joint] - startPositions[joint]) * t;
+				glm::vec4 start = glm::normalize(startQuats[joint]);
+				glm::vec4 stop = glm::normalize(endQuats[joint]);
+				glm::vec4 quat{};
+				switch (type)
+				{
+					case InterpolationType::euler:
+					{
+						EulerOrder order = m_eulerOrders[joint];
+						glm::vec3 startAngles = EulerAngles::fromQuat(order, start);
+						glm::vec3 endAngles = EulerAngles::fromQuat(order, stop);
+						quat = EulerAngles::toQuat(order,
+							startAngles + (endAngles - startAngles) * t);
+						break;
+					}
+
+					case InterpolationType::quatLinear:
+						quat = glm::normalize(start + (stop - start) * t);
+						break;
+
+					case InterpolationType::quatSlerp:
+						quat = slerp(start, stop, t);
+						break;
+
+					case InterpolationType::quatSlerpFast:
+						quat = FastSlerp{start, stop}.interpolate(t);
+						break;
+
+					case InterpolationType::dualQuatScLerp:
+					{
+						DualQuat dualQuat = DualQuatScLerp
+						{
+							DualQuat::fromRigid(start, startPositions[joint]),
+							DualQuat::fromRigid(stop, endPositions[joint])
+						}.interpolate(t);
+						quat = dualQuat.real;
+						pos = dualQuat.translation();
+						break;
+					}
+				}
+				setLocalTransform(joint, pos, quat);
+			}
+		});
+}
+
+void TransformHierarchy::updateWorldMatrices()
+{
+	updateRange(0, m_trunkSize);
+	parallelFor(m_subtrees.size(), subtreesPerThread,
+		[this] (std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				updateRange(m_subtrees[i].first, m_subtrees[i].second);
+			}
+		});
+}
+
+std::span<const glm::mat4> TransformHierarchy::getSortedWorldMatrices() const
+{
+	return m_worldMatrices;
+}
+
+const glm::mat4& TransformHierarchy::getWorldMatrix(std::size_t joint) const
+{
+	return m_worldMatrices[m_sortedIndices[joint]];
+}
+
+void TransformHierarchy::updateRange(std::size_t begin, std::size_t end)
+{
+	const float* px = m_localPositions[0].data();
+	const float* py = m_localPositions[1].data();
+	const float* pz = m_localPositions[2].data();
+	const float* qx = m_localQuats[0].data();
+	const float* qy = m_localQuats[1].data();
+	const float* qz = m_localQuats[2].data();
+	const float* qw = m_localQuats[3].data();
+	glm::mat4* localMatrices = m_localMatrices.data();
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		float xx = qx[i] * qx[i];
+		float yy = qy[i] * qy[i];
+		float zz = qz[i] * qz[i];
+		float xy = qx[i] * qy[i];
+		float xz = qx[i] * qz[i];
+		float xw = qx[i] * qw[i];
+		float yz = qy[i] * qz[i];
+		float yw = qy[i] * qw[i];
+		float zw = qz[i] * qw[i];
+
+		localMatrices[i] =
+			{
+				1 - 2 * (yy + zz), 2 * (xy + zw), 2 * (xz - yw), 0,
+				2 * (xy - zw), 1 - 2 * (xx + zz), 2 * (yz + xw), 0,
+				2 * (xz + yw), 2 * (yz - xw), 1 - 2 * (xx + yy), 0,
+				px[i], py[i], pz[i], 1
+			};
+	}
+
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		std::int32_t parent = m_sortedParents[i];
+		m_worldMatrices[i] = parent < 0 ? m_localMatrices[i] :
+			m_worldMatrices[static_cast<std::size_t>(parent)] * m_localMatrices[i];
+	}
+}
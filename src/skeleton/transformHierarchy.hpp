@@ -0,0 +1,59 @@
+#pragma once
+
+#include "interpolationType.hpp"
+#include "math/eulerOrder.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+class TransformHierarchy
+{
+public:
+	static constexpr std::size_t subtreeGrainSize = 512;
+	static constexpr std::size_t subtreesPerThread = 8;
+
+	TransformHierarchy() = default;
+	TransformHierarchy(const std::vector<int>& parents,
+		const std::vector<EulerOrder>& eulerOrders);
+
+	std::size_t getJointCount() const;
+	std::size_t getSortedIndex(std::size_t joint) const;
+	std::size_t getJoint(std::size_t sortedIndex) const;
+	std::size_t getSubtreeCount() const;
+	std::size_t getByteSize() const;
+	int getParent(std::size_t joint) const;
+	glm::vec3 getLocalPosition(std::size_t joint) const;
+	glm::vec4 getLocalQuat(std::size_t joint) const;
+	void getLocalTransforms(glm::vec3* positions, glm::vec4* quats) const;
+
+	void setLocalTransform(std::size_t joint, const glm::vec3& pos, const glm::vec4& quat);
+	void setLocalTransforms(const glm::vec3* positions, const glm::vec4* quats);
+	void interpolateLocalTransforms(InterpolationType type, const glm::vec3* startPositions,
+		const glm::vec4* startQuats, const glm::vec3* endPositions, const glm::vec4* endQuats,
+		float t);
+
+	void updateWorldMatrices();
+	std::span<const glm::mat4> getSortedWorldMatrices() const;
+	const glm::mat4& getWorldMatrix(std::size_t joint) const;
+
+private:
+	std::vector<std::uint32_t> m_joints{};
+	std::vector<std::uint32_t> m_sortedIndices{};
+	std::vector<std::int32_t> m_sortedParents{};
+	std::vector<EulerOrder> m_eulerOrders{};
+	std::size_t m_trunkSize{};
+	std::vector<std::pair<std::size_t, std::size_t>> m_subtrees{};
+
+	std::array<std::vector<float>, 3> m_localPositions{};
+	std::array<std::vector<float>, 4> m_localQuats{};
+	std::vector<glm::mat4> m_localMatrices{};
+	std::vector<glm::mat4> m_worldMatrices{};
+
+	void updateRange(std::size_t begin, std::size_t end);
+};
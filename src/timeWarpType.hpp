@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+enum class TimeWarpType
+{
+	linear,
+	easeIn,
+	easeOut,
+	easeInOut,
+	cubicBezier,
+	piecewise
+};
+
+inline constexpr int timeWarpTypeCount = 6;
+
+inline const std::array<std::string, timeWarpTypeCount> timeWarpTypeLabels
+{
+	"Linear",
+	"Ease in",
+	"Ease out",
+	"Ease in-out",
+	"Cubic Bezier",
+	"Piecewise"
+};
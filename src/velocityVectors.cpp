@@ -0,0 +1,33 @@
+#include "velocityVectors.hpp"
+
+#include "memory/glResourceTracker.hpp"
+#include "shaderPrograms.hpp"
+
+#include <glad/glad.h>
+
+VelocityVectors::VelocityVectors()
+{
+	glGenVertexArrays(1, &m_VAO);
+	GLResourceTracker::add(GLResourceType::vertexArray);
+}
+
+VelocityVectors::~VelocityVectors()
+{
+	glDeleteVertexArrays(1, &m_VAO);
+	GLResourceTracker::remove(GLResourceType::vertexArray);
+}
+
+void VelocityVectors::render(Renderer& renderer, const glm::vec3& pos,
+	const PoseVelocity& velocity) const
+{
+	DrawCommand command{};
+	command.program = ShaderPrograms::velocity.get();
+	command.VAO = m_VAO;
+	command.lineWidth = 3.0f;
+	command.mode = GL_POINTS;
+	command.count = 1;
+	command.setUniform("pos", pos);
+	command.setUniform("linearVelocity", velocity.linear);
+	command.setUniform("angularVelocity", velocity.angular);
+	renderer.submit(command);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "interpolator.hpp"
+#include "render/renderer.hpp"
+
+#include <glm/glm.hpp>
+
+class VelocityVectors
+{
+public:
+	VelocityVectors();
+	~VelocityVectors();
+	void render(Renderer& renderer, const glm::vec3& pos,
+		const PoseVelocity& velocity) const;
+
+private:
+	unsigned int m_VAO{};
+};
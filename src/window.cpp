@@ -54,11 +54,23 @@ void Window::pollEvents() const
 	glfwPollEvents();
 }
 
+void Window::setVSync(bool vSync) const
+{
+	glfwSwapInterval(vSync ? 1 : 0);
+}
+
 const glm::ivec2& Window::viewportSize() const
 {
 	return m_viewportSize;
 }
 
+void Window::setViewportSize(const glm::ivec2& viewportSize)
+{
+	m_viewportSize = viewportSize;
+	m_scene->updateViewportSize();
+	updateViewport();
+}
+
 GLFWwindow* Window::getPtr()
 {
 	return m_windowPtr;
@@ -66,14 +78,12 @@ GLFWwindow* Window::getPtr()
 
 void Window::resizeCallback(int width, int height)
 {
-	if (width == 0 || height == 0)
+	if (width == 0 || height == 0 || m_scene->isInputLocked())
 	{
 		return;
 	}
 
-	m_viewportSize = {width - LeftPanel::width, height};
-	m_scene->updateViewportSize();
-	updateViewport();
+	setViewportSize({width - LeftPanel::width, height});
 }
 
 void Window::cursorMovementCallback(double x, double y)
@@ -81,6 +91,10 @@ void Window::cursorMovementCallback(double x, double y)
 	glm::vec2 currPos{static_cast<float>(x), static_cast<float>(y)};
 	glm::vec2 offset = currPos - m_lastCursorPos;
 	m_lastCursorPos = currPos;
+	if (m_scene->isInputLocked())
+	{
+		return;
+	}
 
 	if ((!isKeyPressed(GLFW_KEY_LEFT_SHIFT) &&
 		isButtonPressed(GLFW_MOUSE_BUTTON_MIDDLE))
@@ -114,7 +128,7 @@ void Window::cursorMovementCallback(double x, double y)
 
 void Window::scrollCallback(double, double yOffset)
 {
-	if (isCursorInGUI())
+	if (isCursorInGUI() || m_scene->isInputLocked())
 	{
 		return;
 	}
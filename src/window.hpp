@@ -18,8 +18,10 @@ public:
 	bool shouldClose() const;
 	void swapBuffers() const;
 	void pollEvents() const;
+	void setVSync(bool vSync) const;
 
 	const glm::ivec2& viewportSize() const;
+	void setViewportSize(const glm::ivec2& viewportSize);
 	GLFWwindow* getPtr();
 
 private:
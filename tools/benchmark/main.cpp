@@ -0,0 +1,288 @@
+#include "frame.hpp"
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+#include "math/eulerAngles.hpp"
+#include "positionCurveType.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr std::array<float, 6> angleMagnitudes{0.01f, 0.1f, 0.5f, 1.0f, 2.0f, 3.0f};
+static constexpr std::array<std::size_t, 4> batchSizes{1, 16, 256, 4096};
+static constexpr int innerPosKeyCount = 4;
+static constexpr int repetitions = 7;
+static constexpr std::size_t calibrationSamples = 1 << 14;
+static constexpr double targetRunSeconds = 0.01;
+
+struct Result
+{
+	std::string function{};
+	float angle{};
+	std::size_t batchSize{};
+	std::size_t samples{};
+	double minNsPerSample{};
+	double medianNsPerSample{};
+};
+
+struct Inputs
+{
+	Interpolator interpolator{};
+	std::vector<float> times{};
+	std::vector<glm::vec3> eulerAngles{};
+	std::vector<glm::vec4> quats{};
+	std::vector<glm::vec4> otherQuats{};
+};
+
+template <typename T>
+void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "m"(value) : "memory");
+#else
+	static const volatile void* sink{};
+	sink = &value;
+	_ReadWriteBarrier();
+#endif
+}
+
+glm::vec4 axisAngleQuat(const glm::vec3& axis, float angle)
+{
+	return {std::sin(angle / 2) * axis, std::cos(angle / 2)};
+}
+
+glm::vec3 randomAxis(std::mt19937& generator)
+{
+	std::normal_distribution<float> distribution{};
+	glm::vec3 axis{};
+	do
+	{
+		axis = {distribution(generator), distribution(generator), distribution(generator)};
+	}
+	while (glm::length(axis) < 1e-3f);
+	return glm::normalize(axis);
+}
+
+Inputs makeInputs(float angle, std::size_t batchSize, std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> unitDistribution{0, 1};
+	std::uniform_real_distribution<float> angleDistribution{-glm::pi<float>(),
+		glm::pi<float>()};
+
+	Inputs inputs{};
+	glm::vec4 startQuat = axisAngleQuat(randomAxis(generator), angleDistribution(generator));
+	glm::vec4 endQuat = Interpolator::quatProduct(startQuat,
+		axisAngleQuat(randomAxis(generator), angle));
+	inputs.interpolator.setStartPos({-1, 0, 0});
+	inputs.interpolator.setEndPos({1, 0, 0});
+	for (int i = 1; i <= innerPosKeyCount; ++i)
+	{
+		inputs.interpolator.insertPosKey(i);
+		inputs.interpolator.setPosKey(i, {{angleDistribution(generator),
+			angleDistribution(generator), angleDistribution(generator)}, {1, 0, 0}});
+	}
+	inputs.interpolator.setStartQuat(startQuat);
+	inputs.interpolator.setEndQuat(endQuat);
+
+	for (std::size_t i = 0; i < batchSize; ++i)
+	{
+		float t = unitDistribution(generator);
+		inputs.times.push_back(t * inputs.interpolator.getEndTime());
+
+		glm::vec4 quat = Interpolator::quatProduct(startQuat,
+			axisAngleQuat(randomAxis(generator), t * angle));
+		inputs.quats.push_back(quat);
+		inputs.eulerAngles.push_back(Interpolator::quatToEulerAngles(quat));
+		inputs.otherQuats.push_back(axisAngleQuat(randomAxis(generator), angle));
+	}
+	return inputs;
+}
+
+template <typename Pass>
+double measurePass(const Pass& pass, std::size_t passes)
+{
+	Clock::time_point start = Clock::now();
+	for (std::size_t i = 0; i < passes; ++i)
+	{
+		pass();
+	}
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename Pass>
+Result measure(const std::string& function, float angle, std::size_t batchSize,
+	const Pass& pass)
+{
+	std::size_t passes = std::max<std::size_t>(calibrationSamples / batchSize, 1);
+	double seconds = measurePass(pass, passes);
+	while (seconds < targetRunSeconds / 4)
+	{
+		passes *= 2;
+		seconds = measurePass(pass, passes);
+	}
+	passes = std::max<std::size_t>(
+		static_cast<std::size_t>(static_cast<double>(passes) * targetRunSeconds / seconds), 1);
+
+	std::array<double, repetitions> nsPerSample{};
+	for (double& value : nsPerSample)
+	{
+		value = measurePass(pass, passes) * 1e9 / static_cast<double>(passes * batchSize);
+	}
+	std::sort(nsPerSample.begin(), nsPerSample.end());
+
+	return {function, angle, batchSize, passes * batchSize * repetitions, nsPerSample.front(),
+		nsPerSample[repetitions / 2]};
+}
+
+void runCase(std::vector<Result>& results, float angle, std::size_t batchSize,
+	std::mt19937& generator)
+{
+	Inputs inputs = makeInputs(angle, batchSize, generator);
+	const Interpolator& interpolator = inputs.interpolator;
+	const std::vector<float>& times = inputs.times;
+	std::vector<glm::vec4> quats(batchSize);
+	std::vector<glm::mat4> modelMatrices(batchSize);
+	Frame frame{};
+
+	auto addPerSample = [&] (const std::string& function, const auto& sample)
+	{
+		results.push_back(measure(function, angle, batchSize,
+			[&] ()
+			{
+				for (std::size_t i = 0; i < batchSize; ++i)
+				{
+					doNotOptimize(sample(i));
+				}
+			}));
+	};
+
+	addPerSample("interpolatePos",
+		[&] (std::size_t i)
+		{
+			return interpolator.interpolatePos(PositionCurveType::linear, times[i]);
+		});
+	addPerSample("interpolateEulerAngles",
+		[&] (std::size_t i) { return interpolator.interpolateEulerAngles(times[i]); });
+	addPerSample("interpolateQuatLinear",
+		[&] (std::size_t i) { return interpolator.interpolateQuatLinear(times[i]); });
+	addPerSample("interpolateQuatSlerp",
+		[&] (std::size_t i) { return interpolator.interpolateQuatSlerp(times[i]); });
+	addPerSample("interpolateQuatSlerpFast",
+		[&] (std::size_t i) { return interpolator.interpolateQuatSlerpFast(times[i]); });
+	addPerSample("interpolateDualQuatScLerp",
+		[&] (std::size_t i) { return interpolator.interpolateDualQuatScLerp(times[i]); });
+	addPerSample("eulerAnglesToQuat",
+		[&] (std::size_t i) { return Interpolator::eulerAnglesToQuat(inputs.eulerAngles[i]); });
+	addPerSample("quatToEulerAngles",
+		[&] (std::size_t i) { return Interpolator::quatToEulerAngles(inputs.quats[i]); });
+	addPerSample("quatProduct",
+		[&] (std::size_t i)
+		{
+			return Interpolator::quatProduct(inputs.quats[i], inputs.otherQuats[i]);
+		});
+	addPerSample("Frame::setQuat",
+		[&] (std::size_t i)
+		{
+			frame.setQuat(inputs.quats[i]);
+			return 0;
+		});
+	addPerSample("Frame::setEulerAngles",
+		[&] (std::size_t i)
+		{
+			frame.setEulerAngles(inputs.eulerAngles[i]);
+			return 0;
+		});
+
+	results.push_back(measure("EulerAngles::toQuats", angle, batchSize,
+		[&] ()
+		{
+			EulerAngles::toQuats<EulerOrder::xyz>(inputs.eulerAngles.data(), quats.data(),
+				batchSize);
+			doNotOptimize(quats.front());
+		}));
+
+	std::vector<glm::vec3> positions(batchSize);
+	for (int type = 0; type < positionCurveTypeCount; ++type)
+	{
+		results.push_back(measure("interpolatePositions[" +
+			positionCurveTypeLabels[type] + "]", angle, batchSize,
+			[&] ()
+			{
+				interpolator.interpolatePositions(static_cast<PositionCurveType>(type),
+					times.data(), positions.data(), batchSize);
+				doNotOptimize(positions.front());
+			}));
+	}
+
+	for (int type = 0; type < interpolationTypeCount; ++type)
+	{
+		results.push_back(measure("interpolateModelMatrices[" +
+			interpolationTypeLabels[type] + "]", angle, batchSize,
+			[&] ()
+			{
+				interpolator.interpolateModelMatrices(static_cast<InterpolationType>(type),
+					PositionCurveType::linear, times.data(), modelMatrices.data(), batchSize);
+				doNotOptimize(modelMatrices.front());
+			}));
+	}
+}
+
+std::string escape(const std::string& text)
+{
+	std::string escaped{};
+	for (char character : text)
+	{
+		if (character == '"' || character == '\\')
+		{
+			escaped += '\\';
+		}
+		escaped += character;
+	}
+	return escaped;
+}
+
+int main()
+{
+	std::mt19937 generator{2024};
+	std::vector<Result> results{};
+	for (float angle : angleMagnitudes)
+	{
+		for (std::size_t batchSize : batchSizes)
+		{
+			runCase(results, angle, batchSize, generator);
+		}
+	}
+
+	std::printf("{\n");
+	std::printf("  \"unit\": \"ns/sample\",\n");
+	std::printf("  \"repetitions\": %d,\n", repetitions);
+	std::printf("  \"results\": [");
+	bool first = true;
+	for (const Result& result : results)
+	{
+		std::printf("%s\n    {\"function\": \"%s\", \"angleRad\": %.9g, \"batchSize\": %zu, "
+			"\"samples\": %zu, \"minNsPerSample\": %.4f, \"medianNsPerSample\": %.4f}",
+			first ? "" : ",", escape(result.function).c_str(), result.angle, result.batchSize,
+			result.samples, result.minNsPerSample, result.medianNsPerSample);
+		first = false;
+	}
+	std::printf("\n  ]\n");
+	std::printf("}\n");
+
+	return 0;
+}
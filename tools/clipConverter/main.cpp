@@ -0,0 +1,215 @@
+#include "clip/compressedTrack.hpp"
+#include "clip/motionClip.hpp"
+#include "clip/motionClipWriter.hpp"
+#include "interpolator.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr std::size_t maxColumnCount = 11;
+static constexpr std::size_t eulerOnlyColumnCount = 7;
+static constexpr std::size_t quatColumnCount = 8;
+static constexpr std::size_t quatAndEulerColumnCount = 11;
+static constexpr std::size_t segmentSampleCount = std::size_t{1} << 20;
+
+std::size_t parseLine(std::string_view line, std::array<float, maxColumnCount>& values)
+{
+	std::size_t count = 0;
+	while (!line.empty())
+	{
+		std::size_t separator = line.find(',');
+		std::string_view field = line.substr(0, separator);
+		while (!field.empty() && (field.front() == ' ' || field.front() == '\t'))
+		{
+			field.remove_prefix(1);
+		}
+		while (!field.empty() &&
+			(field.back() == ' ' || field.back() == '\t' || field.back() == '\r'))
+		{
+			field.remove_suffix(1);
+		}
+
+		if (count == maxColumnCount ||
+			std::from_chars(field.data(), field.data() + field.size(), values[count]).ec !=
+				std::errc{})
+		{
+			return 0;
+		}
+		++count;
+
+		if (separator == std::string_view::npos)
+		{
+			break;
+		}
+		line.remove_prefix(separator + 1);
+	}
+	return count;
+}
+
+bool isHeaderLine(std::string_view line)
+{
+	std::array<float, maxColumnCount> values{};
+	return !line.empty() && parseLine(line, values) == 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		std::fprintf(stderr,
+			"usage: clip-converter input.csv output.clip\n"
+			"columns: time,px,py,pz,qx,qy,qz,qw[,ex,ey,ez] or time,px,py,pz,ex,ey,ez\n");
+		return 2;
+	}
+
+	Clock::time_point start = Clock::now();
+
+	std::ifstream input{argv[1]};
+	if (!input)
+	{
+		std::fprintf(stderr, "cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	std::array<float, maxColumnCount> values{};
+	std::string line{};
+	std::uint64_t sampleCount = 0;
+	std::size_t columnCount = 0;
+	std::uint64_t lineNumber = 0;
+	while (std::getline(input, line))
+	{
+		++lineNumber;
+		if (line.empty() || line == "\r" || (lineNumber == 1 && isHeaderLine(line)))
+		{
+			continue;
+		}
+
+		std::size_t count = parseLine(line, values);
+		if (columnCount == 0)
+		{
+			columnCount = count;
+		}
+		if (count != columnCount || (count != eulerOnlyColumnCount &&
+			count != quatColumnCount && count != quatAndEulerColumnCount))
+		{
+			std::fprintf(stderr, "%s:%llu: expected 7, 8 or 11 numeric columns\n", argv[1],
+				static_cast<unsigned long long>(lineNumber));
+			return 1;
+		}
+		++sampleCount;
+	}
+	if (sampleCount == 0)
+	{
+		std::fprintf(stderr, "%s: no samples\n", argv[1]);
+		return 1;
+	}
+
+	bool hasEulerAngles = columnCount != quatColumnCount;
+	MotionClipWriter writer{argv[2], sampleCount, hasEulerAngles};
+	if (!writer.isOpen())
+	{
+		std::fprintf(stderr, "cannot create %s\n", argv[2]);
+		return 1;
+	}
+
+	input.clear();
+	input.seekg(0);
+	lineNumber = 0;
+	while (std::getline(input, line))
+	{
+		++lineNumber;
+		if (line.empty() || line == "\r" || (lineNumber == 1 && isHeaderLine(line)))
+		{
+			continue;
+		}
+
+		parseLine(line, values);
+		glm::vec3 pos{values[1], values[2], values[3]};
+		glm::vec4 quat{};
+		glm::vec3 eulerAngles{};
+		if (columnCount == eulerOnlyColumnCount)
+		{
+			eulerAngles = {values[4], values[5], values[6]};
+			quat = Interpolator::eulerAnglesToQuat(eulerAngles);
+		}
+		else
+		{
+			quat = {values[4], values[5], values[6], values[7]};
+			if (hasEulerAngles)
+			{
+				eulerAngles = {values[8], values[9], values[10]};
+			}
+		}
+
+		if (!writer.append(values[0], pos, quat, eulerAngles))
+		{
+			std::fprintf(stderr, "%s:%llu: times must be non-decreasing\n", argv[1],
+				static_cast<unsigned long long>(lineNumber));
+			return 1;
+		}
+	}
+	if (!writer.finish())
+	{
+		std::fprintf(stderr, "error writing %s\n", argv[2]);
+		return 1;
+	}
+	double convertSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	Clock::time_point openStart = Clock::now();
+	MotionClip clip{};
+	if (!clip.open(argv[2]))
+	{
+		return 1;
+	}
+	double openMs = std::chrono::duration<double, std::milli>(Clock::now() - openStart).count();
+
+	CompressionStats stats{};
+	double decodeSeconds = 0;
+	std::size_t first = 0;
+	do
+	{
+		CompressedTrack segment = CompressedTrack::encode(clip, first, segmentSampleCount + 1);
+		const CompressionStats& segmentStats = segment.getStats();
+		stats.sampleCount += segmentStats.sampleCount;
+		stats.rawByteSize += segmentStats.rawByteSize;
+		stats.compressedByteSize += segmentStats.compressedByteSize;
+		stats.maxAngularError = std::max(stats.maxAngularError, segmentStats.maxAngularError);
+		stats.maxPositionError = std::max(stats.maxPositionError, segmentStats.maxPositionError);
+		decodeSeconds += segmentStats.decodeSamplesPerSecond > 0 ?
+			static_cast<double>(segmentStats.sampleCount) / segmentStats.decodeSamplesPerSecond :
+			0;
+		first += segmentSampleCount;
+	}
+	while (first + 1 < clip.getSampleCount());
+	stats.ratio = static_cast<float>(stats.rawByteSize) /
+		static_cast<float>(std::max<std::size_t>(stats.compressedByteSize, 1));
+	stats.decodeSamplesPerSecond = decodeSeconds > 0 ?
+		static_cast<double>(stats.sampleCount) / decodeSeconds : 0;
+
+	std::printf("{\n");
+	std::printf("  \"samples\": %zu,\n", clip.getSampleCount());
+	std::printf("  \"durationSeconds\": %.6g,\n", clip.getDuration());
+	std::printf("  \"eulerAngles\": %s,\n", clip.hasEulerAngles() ? "true" : "false");
+	std::printf("  \"bytes\": %zu,\n", clip.getByteSize());
+	std::printf("  \"convertSeconds\": %.3f,\n", convertSeconds);
+	std::printf("  \"openMs\": %.3f,\n", openMs);
+	std::printf("  \"compression\": {\"rawBytes\": %zu, \"compressedBytes\": %zu, "
+		"\"ratio\": %.3f, \"maxAngularErrorRad\": %.6g, \"maxPositionError\": %.6g, "
+		"\"decodeSamplesPerSecond\": %.0f}\n", stats.rawByteSize, stats.compressedByteSize,
+		stats.ratio, stats.maxAngularError, stats.maxPositionError, stats.decodeSamplesPerSecond);
+	std::printf("}\n");
+
+	return 0;
+}
@@ -0,0 +1,25 @@
+#include "math/fastSlerp.hpp"
+
+#include <cstdio>
+
+int main()
+{
+	static constexpr int angleSteps = 2048;
+	static constexpr int tSteps = 256;
+	static constexpr int axisCount = 16;
+
+	FastSlerpAccuracy accuracy = FastSlerp::measureAccuracy(angleSteps, tSteps, axisCount);
+
+	std::printf("{\n");
+	std::printf("  \"samples\": %zu,\n", accuracy.sampleCount);
+	std::printf("  \"maxAngularErrorRad\": %.9g,\n", accuracy.maxAngularError);
+	std::printf("  \"maxNormError\": %.9g,\n", accuracy.maxNormError);
+	std::printf("  \"worstRotationAngleRad\": %.9g,\n", accuracy.worstAngle);
+	std::printf("  \"worstT\": %.9g,\n", accuracy.worstT);
+	std::printf("  \"boundRad\": %.9g,\n", static_cast<double>(FastSlerp::maxAngularError));
+	std::printf("  \"withinBound\": %s\n",
+		accuracy.maxAngularError <= FastSlerp::maxAngularError ? "true" : "false");
+	std::printf("}\n");
+
+	return accuracy.maxAngularError <= FastSlerp::maxAngularError ? 0 : 1;
+}
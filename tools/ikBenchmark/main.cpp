@@ -0,0 +1,148 @@
+#include "ik/ikMethod.hpp"
+#include "ik/ikSolver.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static constexpr std::size_t defaultChainCount = 10000;
+static constexpr std::size_t defaultChainLength = 8;
+static constexpr int repetitions = 5;
+static constexpr float unreachableFraction = 0.1f;
+
+glm::vec3 randomDirection(std::mt19937& generator)
+{
+	std::normal_distribution<float> distribution{};
+	glm::vec3 direction{};
+	do
+	{
+		direction = {distribution(generator), distribution(generator), distribution(generator)};
+	}
+	while (glm::length(direction) < 1e-3f);
+	return glm::normalize(direction);
+}
+
+glm::vec4 randomSmallQuat(std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> angleDistribution{-0.5f, 0.5f};
+	float angle = angleDistribution(generator);
+	return {std::sin(angle / 2) * randomDirection(generator), std::cos(angle / 2)};
+}
+
+IkChainBatch createBatch(std::size_t chainCount, std::size_t chainLength)
+{
+	std::mt19937 generator{1};
+	std::uniform_real_distribution<float> lengthDistribution{0.1f, 0.3f};
+	std::uniform_real_distribution<float> unitDistribution{0, 1};
+
+	IkChainBatch batch{};
+	std::vector<glm::vec3> bones(chainLength);
+	std::vector<glm::vec4> quats(chainLength);
+	for (std::size_t chain = 0; chain < chainCount; ++chain)
+	{
+		float reach = 0;
+		for (std::size_t i = 0; i < chainLength; ++i)
+		{
+			bones[i] = lengthDistribution(generator) * glm::vec3{0, 1, 0};
+			quats[i] = randomSmallQuat(generator);
+			reach += glm::length(bones[i]);
+		}
+		float distance = unitDistribution(generator) < unreachableFraction ?
+			reach * (1.1f + unitDistribution(generator)) :
+			reach * (0.1f + 0.8f * unitDistribution(generator));
+		glm::vec3 rootPos = randomDirection(generator);
+		batch.addChain(rootPos, {0, 0, 0, 1}, bones, quats,
+			rootPos + distance * randomDirection(generator));
+	}
+	return batch;
+}
+
+bool sameQuats(const IkChainBatch& first, const IkChainBatch& second)
+{
+	return first.quats.size() == second.quats.size() && std::memcmp(first.quats.data(),
+		second.quats.data(), first.quats.size() * sizeof(glm::vec4)) == 0;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t chainCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : defaultChainCount;
+	std::size_t chainLength = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : defaultChainLength;
+	IkBudget budget{};
+	if (argc > 3)
+	{
+		budget.maxIterations = std::atoi(argv[3]);
+	}
+	if (argc > 4)
+	{
+		budget.tolerance = std::strtof(argv[4], nullptr);
+	}
+	if (chainCount == 0 || chainLength == 0 || budget.maxIterations <= 0)
+	{
+		std::fprintf(stderr,
+			"usage: ik-benchmark [chains] [chainLength] [maxIterations] [tolerance]\n");
+		return 2;
+	}
+
+	IkChainBatch source = createBatch(chainCount, chainLength);
+
+	std::printf("{\n");
+	std::printf("  \"chains\": %zu,\n", chainCount);
+	std::printf("  \"chainLength\": %zu,\n", chainLength);
+	std::printf("  \"maxIterations\": %d,\n", budget.maxIterations);
+	std::printf("  \"tolerance\": %.6g,\n", budget.tolerance);
+	std::printf("  \"results\": [");
+	for (int method = 0; method < ikMethodCount; ++method)
+	{
+		IkMethod ikMethod = static_cast<IkMethod>(method);
+
+		IkChainBatch solved{};
+		IkStats stats{};
+		double minMicrosecondsPerChain = 0;
+		for (int repetition = 0; repetition < repetitions; ++repetition)
+		{
+			IkChainBatch batch = source;
+			IkStats repetitionStats = IkSolver::solve(ikMethod, batch, budget);
+			if (repetition == 0 || repetitionStats.microsecondsPerChain < minMicrosecondsPerChain)
+			{
+				minMicrosecondsPerChain = repetitionStats.microsecondsPerChain;
+			}
+			if (repetition == 0)
+			{
+				solved = std::move(batch);
+				stats = repetitionStats;
+			}
+			else if (!sameQuats(solved, batch))
+			{
+				stats.convergedCount = 0;
+				solved.quats.clear();
+			}
+		}
+
+		IkChainBatch serial = source;
+		for (std::size_t chain = 0; chain < chainCount; ++chain)
+		{
+			std::size_t offset = serial.chainOffsets[chain];
+			IkSolver::solveChain(ikMethod, serial.rootPositions[chain],
+				serial.rootParentQuats[chain], serial.bones.data() + offset,
+				serial.quats.data() + offset, serial.chainOffsets[chain + 1] - offset,
+				serial.targets[chain], budget);
+		}
+
+		std::printf("%s\n    {\"method\": \"%s\", \"usPerChain\": %.3f, \"converged\": %zu, "
+			"\"meanIterations\": %.3f, \"maxError\": %.6g, \"deterministic\": %s}",
+			method == 0 ? "" : ",", ikMethodLabels[method].c_str(), minMicrosecondsPerChain,
+			stats.convergedCount, static_cast<double>(stats.iterationCount) / chainCount,
+			stats.maxError, sameQuats(solved, serial) ? "true" : "false");
+	}
+	std::printf("\n  ]\n");
+	std::printf("}\n");
+
+	return 0;
+}
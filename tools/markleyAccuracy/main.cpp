@@ -0,0 +1,209 @@
+#include "blend/blendMethod.hpp"
+#include "blend/motionBlender.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr std::size_t elementCount = 20000;
+static constexpr std::size_t inputCount = 8;
+static constexpr std::array<float, 4> spreads{0.25f, 1.0f, 2.0f, 3.0f};
+static constexpr double minRelativeEigengap = 0.01;
+static constexpr double maxAngularError = 2e-3;
+
+using Matrix4 = std::array<std::array<double, 4>, 4>;
+
+struct EigenResult
+{
+	std::array<double, 4> vector{};
+	double relativeGap{};
+};
+
+glm::vec4 randomQuat(std::mt19937& generator, float maxAngle)
+{
+	std::normal_distribution<float> normal{};
+	std::uniform_real_distribution<float> unit{0, 1};
+	glm::vec3 axis{};
+	do
+	{
+		axis = {normal(generator), normal(generator), normal(generator)};
+	}
+	while (glm::length(axis) < 1e-3f);
+	float angle = maxAngle * unit(generator);
+	return {std::sin(angle / 2) * glm::normalize(axis), std::cos(angle / 2)};
+}
+
+glm::vec4 multiply(const glm::vec4& first, const glm::vec4& second)
+{
+	glm::vec3 firstVector{first};
+	glm::vec3 secondVector{second};
+	return {first.w * secondVector + second.w * firstVector +
+		glm::cross(firstVector, secondVector),
+		first.w * second.w - glm::dot(firstVector, secondVector)};
+}
+
+EigenResult dominantEigenvector(Matrix4 matrix)
+{
+	Matrix4 vectors{};
+	for (int i = 0; i < 4; ++i)
+	{
+		vectors[i][i] = 1;
+	}
+
+	for (int sweep = 0; sweep < 64; ++sweep)
+	{
+		double offDiagonal = 0;
+		for (int p = 0; p < 4; ++p)
+		{
+			for (int q = p + 1; q < 4; ++q)
+			{
+				offDiagonal += matrix[p][q] * matrix[p][q];
+			}
+		}
+		if (offDiagonal < 1e-30)
+		{
+			break;
+		}
+
+		for (int p = 0; p < 4; ++p)
+		{
+			for (int q = p + 1; q < 4; ++q)
+			{
+				if (std::abs(matrix[p][q]) < 1e-300)
+				{
+					continue;
+				}
+
+				double theta = (matrix[q][q] - matrix[p][p]) / (2 * matrix[p][q]);
+				double t = (theta >= 0 ? 1 : -1) /
+					(std::abs(theta) + std::sqrt(theta * theta + 1));
+				double c = 1 / std::sqrt(t * t + 1);
+				double s = t * c;
+				for (int k = 0; k < 4; ++k)
+				{
+					double kp = matrix[k][p];
+					double kq = matrix[k][q];
+					matrix[k][p] = c * kp - s * kq;
+					matrix[k][q] = s * kp + c * kq;
+				}
+				for (int k = 0; k < 4; ++k)
+				{
+					double pk = matrix[p][k];
+					double qk = matrix[q][k];
+					matrix[p][k] = c * pk - s * qk;
+					matrix[q][k] = s * pk + c * qk;
+				}
+				for (int k = 0; k < 4; ++k)
+				{
+					double kp = vectors[k][p];
+					double kq = vectors[k][q];
+					vectors[k][p] = c * kp - s * kq;
+					vectors[k][q] = s * kp + c * kq;
+				}
+			}
+		}
+	}
+
+	std::array<int, 4> order{0, 1, 2, 3};
+	std::sort(order.begin(), order.end(),
+		[&matrix] (int first, int second)
+		{
+			return matrix[first][first] > matrix[second][second];
+		});
+	EigenResult result{};
+	for (int k = 0; k < 4; ++k)
+	{
+		result.vector[k] = vectors[k][order[0]];
+	}
+	double largest = matrix[order[0]][order[0]];
+	result.relativeGap = largest > 0 ? (largest - matrix[order[1]][order[1]]) / largest : 0;
+	return result;
+}
+
+int main()
+{
+	std::mt19937 generator{1};
+	std::uniform_real_distribution<float> weightDistribution{0, 1};
+
+	std::vector<glm::vec3> positions(inputCount * elementCount);
+	std::vector<glm::vec4> quats(inputCount * elementCount);
+	std::vector<float> weights(inputCount * elementCount);
+	std::vector<glm::vec3> resultPositions(elementCount);
+	std::vector<glm::vec4> resultQuats(elementCount);
+	MotionBlender blender{};
+
+	bool withinBound = true;
+	std::printf("{\n  \"elements\": %zu,\n  \"inputs\": %zu,\n  \"spreads\":\n  [\n",
+		elementCount, inputCount);
+	for (std::size_t spreadIndex = 0; spreadIndex < spreads.size(); ++spreadIndex)
+	{
+		float spread = spreads[spreadIndex];
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			glm::vec4 base = randomQuat(generator, glm::pi<float>());
+			for (std::size_t input = 0; input < inputCount; ++input)
+			{
+				glm::vec4 quat = multiply(base, randomQuat(generator, spread));
+				quats[input * elementCount + i] = weightDistribution(generator) < 0.5f ?
+					quat : -quat;
+				weights[input * elementCount + i] = weightDistribution(generator);
+			}
+		}
+
+		blender.blend(BlendMethod::markley, inputCount, elementCount, positions.data(),
+			quats.data(), weights.data(), resultPositions.data(), resultQuats.data());
+
+		std::size_t checkedCount = 0;
+		std::size_t failedCount = 0;
+		double maxError = 0;
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			Matrix4 moment{};
+			for (std::size_t input = 0; input < inputCount; ++input)
+			{
+				const glm::vec4& quat = quats[input * elementCount + i];
+				double weight = weights[input * elementCount + i];
+				for (int row = 0; row < 4; ++row)
+				{
+					for (int column = 0; column < 4; ++column)
+					{
+						moment[row][column] += weight * quat[row] * quat[column];
+					}
+				}
+			}
+
+			EigenResult exact = dominantEigenvector(moment);
+			if (exact.relativeGap < minRelativeEigengap)
+			{
+				continue;
+			}
+
+			double dot = 0;
+			for (int k = 0; k < 4; ++k)
+			{
+				dot += exact.vector[k] * resultQuats[i][k];
+			}
+			double error = 2 * std::acos(std::min(std::abs(dot), 1.0));
+			maxError = std::max(maxError, error);
+			++checkedCount;
+			failedCount += error > maxAngularError ? 1 : 0;
+		}
+
+		withinBound = withinBound && failedCount == 0;
+		std::printf("    {\"spreadRad\": %.3g, \"checked\": %zu, \"failed\": %zu, "
+			"\"maxAngularErrorRad\": %.9g}%s\n", spread, checkedCount, failedCount, maxError,
+			spreadIndex + 1 < spreads.size() ? "," : "");
+	}
+	std::printf("  ],\n  \"minRelativeEigengap\": %.9g,\n  \"boundRad\": %.9g,\n",
+		minRelativeEigengap, maxAngularError);
+	std::printf("  \"withinBound\": %s\n}\n", withinBound ? "true" : "false");
+
+	return withinBound ? 0 : 1;
+}
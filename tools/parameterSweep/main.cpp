@@ -0,0 +1,548 @@
+#include "concurrency/parallelFor.hpp"
+#include "interpolationType.hpp"
+#include "interpolator.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static_assert(std::endian::native == std::endian::little,
+	"binary outputs are written in native byte order");
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int methodCount = 3;
+static constexpr std::array<InterpolationType, methodCount> methods
+{
+	InterpolationType::euler,
+	InterpolationType::quatLinear,
+	InterpolationType::quatSlerpFast
+};
+static constexpr std::array<const char*, methodCount> methodNames
+{
+	"euler",
+	"quatLinear",
+	"quatSlerpFast"
+};
+
+static constexpr int dimensionCount = 6;
+static constexpr std::array<std::uint64_t, dimensionCount> haltonBases{2, 3, 5, 7, 11, 13};
+static constexpr std::size_t pairGrainSize = 4096;
+static constexpr int histogramBinCount = 512;
+static constexpr double histogramMinLog = -8;
+static constexpr double histogramMaxLog = 0.5;
+
+enum class Sampling
+{
+	grid,
+	halton
+};
+
+struct Options
+{
+	std::size_t pairCount = 10'000'000;
+	Sampling sampling = Sampling::halton;
+	int timeSampleCount = 33;
+	int width = 256;
+	int height = 128;
+	std::filesystem::path outputDir = "sweep";
+	bool perPair = false;
+};
+
+struct Pair
+{
+	glm::vec4 startQuat{};
+	glm::vec4 endQuat{};
+	float angle{};
+};
+
+struct MethodStats
+{
+	std::vector<double> errorSums{};
+	std::vector<float> maxErrors{};
+	std::array<std::uint64_t, histogramBinCount> histogram{};
+	double errorSum{};
+	float maxError{};
+	std::size_t worstPair{};
+};
+
+struct Heatmaps
+{
+	std::vector<std::uint32_t> counts{};
+	std::array<MethodStats, methodCount> methods{};
+};
+
+struct PairErrors
+{
+	std::array<float, methodCount> meanErrors{};
+	std::array<float, methodCount> maxErrors{};
+};
+
+void printUsage()
+{
+	std::fprintf(stderr,
+		"usage: parameter-sweep [--pairs N] [--sampling grid|halton] [--time-samples N]\n"
+		"                       [--width N] [--height N] [--output DIR] [--per-pair]\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+		if (argument == "--per-pair")
+		{
+			options.perPair = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+		{
+			return false;
+		}
+
+		std::string value = argv[++i];
+		if (argument == "--pairs")
+		{
+			options.pairCount = std::stoull(value);
+		}
+		else if (argument == "--sampling" && (value == "grid" || value == "halton"))
+		{
+			options.sampling = value == "grid" ? Sampling::grid : Sampling::halton;
+		}
+		else if (argument == "--time-samples")
+		{
+			options.timeSampleCount = std::max(std::stoi(value), 2);
+		}
+		else if (argument == "--width")
+		{
+			options.width = std::max(std::stoi(value), 1);
+		}
+		else if (argument == "--height")
+		{
+			options.height = std::max(std::stoi(value), 1);
+		}
+		else if (argument == "--output")
+		{
+			options.outputDir = value;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return options.pairCount > 0;
+}
+
+double radicalInverse(std::uint64_t index, std::uint64_t base)
+{
+	double inverseBase = 1.0 / static_cast<double>(base);
+	double digitWeight = inverseBase;
+	double result = 0;
+	while (index > 0)
+	{
+		result += static_cast<double>(index % base) * digitWeight;
+		index /= base;
+		digitWeight *= inverseBase;
+	}
+	return result;
+}
+
+std::array<double, dimensionCount> samplePoint(Sampling sampling, std::size_t index,
+	std::size_t gridResolution)
+{
+	std::array<double, dimensionCount> point{};
+	for (int dimension = 0; dimension < dimensionCount; ++dimension)
+	{
+		if (sampling == Sampling::halton)
+		{
+			point[dimension] = radicalInverse(index + 1, haltonBases[dimension]);
+		}
+		else
+		{
+			point[dimension] = (static_cast<double>(index % gridResolution) + 0.5) /
+				static_cast<double>(gridResolution);
+			index /= gridResolution;
+		}
+	}
+	return point;
+}
+
+Pair makePair(const std::array<double, dimensionCount>& point)
+{
+	static constexpr double twoPi = glm::two_pi<double>();
+
+	double lowRadius = std::sqrt(1 - point[0]);
+	double highRadius = std::sqrt(point[0]);
+	glm::dvec4 startQuat
+	{
+		lowRadius * std::sin(twoPi * point[1]),
+		lowRadius * std::cos(twoPi * point[1]),
+		highRadius * std::sin(twoPi * point[2]),
+		highRadius * std::cos(twoPi * point[2])
+	};
+
+	double z = 1 - 2 * point[3];
+	double azimuth = twoPi * point[4];
+	double radius = std::sqrt(std::max(1 - z * z, 0.0));
+	glm::dvec3 axis{radius * std::cos(azimuth), radius * std::sin(azimuth), z};
+	double angle = glm::pi<double>() * point[5];
+
+	Pair pair{};
+	pair.startQuat = glm::vec4{startQuat};
+	pair.endQuat = Interpolator::quatProduct(pair.startQuat,
+		glm::vec4{glm::dvec4{std::sin(angle / 2) * axis, std::cos(angle / 2)}});
+	pair.angle = static_cast<float>(angle);
+	return pair;
+}
+
+float angularError(const glm::vec4& reference, const glm::vec4& quat)
+{
+	glm::vec4 unit = glm::normalize(quat);
+	float dot = glm::dot(reference, unit);
+	return 2 * std::atan2(glm::length(unit - dot * reference), std::abs(dot));
+}
+
+int histogramBin(float error)
+{
+	if (error <= 0)
+	{
+		return 0;
+	}
+	double position = (std::log10(error) - histogramMinLog) /
+		(histogramMaxLog - histogramMinLog) * histogramBinCount;
+	return std::clamp(static_cast<int>(position), 0, histogramBinCount - 1);
+}
+
+double histogramPercentile(const std::array<std::uint64_t, histogramBinCount>& histogram,
+	std::size_t total, double percentile)
+{
+	std::uint64_t threshold = static_cast<std::uint64_t>(std::ceil(percentile * total));
+	std::uint64_t cumulative = 0;
+	for (int bin = 0; bin < histogramBinCount; ++bin)
+	{
+		cumulative += histogram[bin];
+		if (cumulative >= threshold)
+		{
+			return std::pow(10.0, histogramMinLog +
+				(bin + 1) * (histogramMaxLog - histogramMinLog) / histogramBinCount);
+		}
+	}
+	return std::pow(10.0, histogramMaxLog);
+}
+
+Heatmaps makeHeatmaps(std::size_t cellCount)
+{
+	Heatmaps heatmaps{};
+	heatmaps.counts.resize(cellCount);
+	for (MethodStats& stats : heatmaps.methods)
+	{
+		stats.errorSums.resize(cellCount);
+		stats.maxErrors.resize(cellCount);
+	}
+	return heatmaps;
+}
+
+void mergeHeatmaps(Heatmaps& target, const Heatmaps& source)
+{
+	for (std::size_t cell = 0; cell < target.counts.size(); ++cell)
+	{
+		target.counts[cell] += source.counts[cell];
+	}
+	for (int method = 0; method < methodCount; ++method)
+	{
+		MethodStats& targetStats = target.methods[method];
+		const MethodStats& sourceStats = source.methods[method];
+		for (std::size_t cell = 0; cell < target.counts.size(); ++cell)
+		{
+			targetStats.errorSums[cell] += sourceStats.errorSums[cell];
+			targetStats.maxErrors[cell] =
+				std::max(targetStats.maxErrors[cell], sourceStats.maxErrors[cell]);
+		}
+		for (int bin = 0; bin < histogramBinCount; ++bin)
+		{
+			targetStats.histogram[bin] += sourceStats.histogram[bin];
+		}
+		targetStats.errorSum += sourceStats.errorSum;
+		if (sourceStats.maxError > targetStats.maxError)
+		{
+			targetStats.maxError = sourceStats.maxError;
+			targetStats.worstPair = sourceStats.worstPair;
+		}
+	}
+}
+
+void sweepRange(const Options& options, std::size_t gridResolution, std::size_t begin,
+	std::size_t end, Heatmaps& heatmaps, std::vector<float>& pairOutput)
+{
+	static constexpr float halfPi = glm::half_pi<float>();
+
+	std::size_t timeSampleCount = static_cast<std::size_t>(options.timeSampleCount);
+	std::vector<float> times(timeSampleCount);
+	for (std::size_t i = 0; i < timeSampleCount; ++i)
+	{
+		times[i] = static_cast<float>(i) / static_cast<float>(timeSampleCount - 1);
+	}
+	std::vector<glm::vec4> reference(timeSampleCount);
+	std::vector<glm::vec4> quats(timeSampleCount);
+
+	Interpolator interpolator{};
+	interpolator.setEndTime(1);
+
+	for (std::size_t index = begin; index < end; ++index)
+	{
+		Pair pair = makePair(samplePoint(options.sampling, index, gridResolution));
+		interpolator.setStartQuat(pair.startQuat);
+		interpolator.setEndQuat(pair.endQuat);
+		interpolator.interpolateQuats(InterpolationType::quatSlerp, times.data(),
+			reference.data(), timeSampleCount);
+
+		float gimbalProximity = std::max(std::abs(interpolator.getStartEulerAngles().y),
+			std::abs(interpolator.getEndEulerAngles().y)) / halfPi;
+		int column = std::min(static_cast<int>(pair.angle / glm::pi<float>() * options.width),
+			options.width - 1);
+		int row = std::min(static_cast<int>(gimbalProximity * options.height),
+			options.height - 1);
+		std::size_t cell = static_cast<std::size_t>(row) * options.width + column;
+		++heatmaps.counts[cell];
+
+		PairErrors errors{};
+		for (int method = 0; method < methodCount; ++method)
+		{
+			interpolator.interpolateQuats(methods[method], times.data(), quats.data(),
+				timeSampleCount);
+
+			float errorSum = 0;
+			float maxError = 0;
+			for (std::size_t i = 0; i < timeSampleCount; ++i)
+			{
+				float error = angularError(reference[i], quats[i]);
+				errorSum += error;
+				maxError = std::max(maxError, error);
+			}
+			errors.meanErrors[method] = errorSum / static_cast<float>(timeSampleCount);
+			errors.maxErrors[method] = maxError;
+
+			MethodStats& stats = heatmaps.methods[method];
+			stats.errorSums[cell] += errors.meanErrors[method];
+			stats.maxErrors[cell] = std::max(stats.maxErrors[cell], maxError);
+			++stats.histogram[histogramBin(maxError)];
+			stats.errorSum += errors.meanErrors[method];
+			if (maxError > stats.maxError)
+			{
+				stats.maxError = maxError;
+				stats.worstPair = index;
+			}
+		}
+
+		if (options.perPair)
+		{
+			float* output = pairOutput.data() + index * (2 + 2 * methodCount);
+			output[0] = pair.angle;
+			output[1] = gimbalProximity;
+			for (int method = 0; method < methodCount; ++method)
+			{
+				output[2 + 2 * method] = errors.meanErrors[method];
+				output[3 + 2 * method] = errors.maxErrors[method];
+			}
+		}
+	}
+}
+
+void writeNpy(const std::filesystem::path& path, const std::string& descr,
+	const std::vector<std::size_t>& shape, const void* data, std::size_t byteSize)
+{
+	std::string shapeText = "(";
+	for (std::size_t dimension : shape)
+	{
+		shapeText += std::to_string(dimension) + ", ";
+	}
+	if (shape.size() > 1)
+	{
+		shapeText.resize(shapeText.size() - 2);
+	}
+	else
+	{
+		shapeText.resize(shapeText.size() - 1);
+	}
+	shapeText += ")";
+
+	std::string header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " +
+		shapeText + ", }";
+	static constexpr std::size_t preambleSize = 10;
+	std::size_t paddedSize = (preambleSize + header.size() + 1 + 63) / 64 * 64;
+	header.append(paddedSize - preambleSize - header.size() - 1, ' ');
+	header += '\n';
+
+	std::ofstream file{path, std::ios::binary};
+	std::uint16_t headerSize = static_cast<std::uint16_t>(header.size());
+	file.write("\x93NUMPY\x01\x00", 8);
+	file.write(reinterpret_cast<const char*>(&headerSize), sizeof(headerSize));
+	file.write(header.data(), static_cast<std::streamsize>(header.size()));
+	file.write(static_cast<const char*>(data), static_cast<std::streamsize>(byteSize));
+}
+
+glm::vec3 colormap(float value)
+{
+	static constexpr std::array<glm::vec3, 5> stops
+	{{
+		{0, 0, 4},
+		{87, 16, 110},
+		{188, 55, 84},
+		{249, 142, 9},
+		{252, 255, 164}
+	}};
+
+	float position = std::clamp(value, 0.0f, 1.0f) * (stops.size() - 1);
+	std::size_t index = std::min(static_cast<std::size_t>(position), stops.size() - 2);
+	return glm::mix(stops[index], stops[index + 1], position - static_cast<float>(index));
+}
+
+void writePpm(const std::filesystem::path& path, const std::vector<float>& values, int width,
+	int height, float scale)
+{
+	std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 3);
+	for (int row = 0; row < height; ++row)
+	{
+		for (int column = 0; column < width; ++column)
+		{
+			float value = values[static_cast<std::size_t>(height - 1 - row) * width + column];
+			glm::vec3 color = colormap(scale > 0 ? value / scale : 0);
+			std::size_t pixel = (static_cast<std::size_t>(row) * width + column) * 3;
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				pixels[pixel + channel] = static_cast<unsigned char>(color[channel]);
+			}
+		}
+	}
+
+	std::ofstream file{path, std::ios::binary};
+	std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) +
+		"\n255\n";
+	file.write(header.data(), static_cast<std::streamsize>(header.size()));
+	file.write(reinterpret_cast<const char*>(pixels.data()),
+		static_cast<std::streamsize>(pixels.size()));
+}
+
+void writeHeatmap(const Options& options, const std::string& name,
+	const std::vector<float>& values)
+{
+	std::vector<std::size_t> shape{static_cast<std::size_t>(options.height),
+		static_cast<std::size_t>(options.width)};
+	writeNpy(options.outputDir / (name + ".npy"), "<f4", shape, values.data(),
+		values.size() * sizeof(float));
+	float scale = *std::max_element(values.begin(), values.end());
+	writePpm(options.outputDir / (name + ".ppm"), values, options.width, options.height, scale);
+}
+
+int main(int argc, char** argv)
+{
+	Options options{};
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 2;
+	}
+
+	std::size_t gridResolution = 1;
+	if (options.sampling == Sampling::grid)
+	{
+		gridResolution = std::max<std::size_t>(static_cast<std::size_t>(std::lround(
+			std::pow(static_cast<double>(options.pairCount), 1.0 / dimensionCount))), 1);
+		options.pairCount = 1;
+		for (int dimension = 0; dimension < dimensionCount; ++dimension)
+		{
+			options.pairCount *= gridResolution;
+		}
+	}
+
+	std::size_t cellCount = static_cast<std::size_t>(options.width) * options.height;
+	Heatmaps heatmaps = makeHeatmaps(cellCount);
+	std::vector<float> pairOutput{};
+	if (options.perPair)
+	{
+		pairOutput.resize(options.pairCount * (2 + 2 * methodCount));
+	}
+
+	std::mutex mergeMutex{};
+	Clock::time_point start = Clock::now();
+	parallelFor(options.pairCount, pairGrainSize,
+		[&] (std::size_t begin, std::size_t end)
+		{
+			Heatmaps local = makeHeatmaps(cellCount);
+			sweepRange(options, gridResolution, begin, end, local, pairOutput);
+			std::lock_guard<std::mutex> lock{mergeMutex};
+			mergeHeatmaps(heatmaps, local);
+		});
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::filesystem::create_directories(options.outputDir);
+	std::vector<float> means(cellCount);
+	for (int method = 0; method < methodCount; ++method)
+	{
+		const MethodStats& stats = heatmaps.methods[method];
+		for (std::size_t cell = 0; cell < cellCount; ++cell)
+		{
+			means[cell] = heatmaps.counts[cell] == 0 ? 0 :
+				static_cast<float>(stats.errorSums[cell] / heatmaps.counts[cell]);
+		}
+		writeHeatmap(options, std::string{methodNames[method]} + "_mean", means);
+		writeHeatmap(options, std::string{methodNames[method]} + "_max", stats.maxErrors);
+	}
+	writeNpy(options.outputDir / "count.npy", "<u4",
+		{static_cast<std::size_t>(options.height), static_cast<std::size_t>(options.width)},
+		heatmaps.counts.data(), cellCount * sizeof(std::uint32_t));
+	if (options.perPair)
+	{
+		writeNpy(options.outputDir / "pairs.npy", "<f4",
+			{options.pairCount, static_cast<std::size_t>(2 + 2 * methodCount)},
+			pairOutput.data(), pairOutput.size() * sizeof(float));
+	}
+
+	std::printf("{\n");
+	std::printf("  \"pairs\": %zu,\n", options.pairCount);
+	std::printf("  \"sampling\": \"%s\",\n",
+		options.sampling == Sampling::grid ? "grid" : "halton");
+	std::printf("  \"timeSamples\": %d,\n", options.timeSampleCount);
+	std::printf("  \"threads\": %u,\n", std::max(std::thread::hardware_concurrency(), 1u));
+	std::printf("  \"seconds\": %.3f,\n", seconds);
+	std::printf("  \"pairsPerSecond\": %.0f,\n", static_cast<double>(options.pairCount) / seconds);
+	std::printf("  \"reference\": \"quatSlerp\",\n");
+	std::printf("  \"heatmap\": {\"width\": %d, \"height\": %d, "
+		"\"x\": \"relative angle [0, pi]\", \"y\": \"max |pitch| of endpoints / (pi/2)\"},\n",
+		options.width, options.height);
+	std::printf("  \"output\": \"%s\",\n", options.outputDir.generic_string().c_str());
+	std::printf("  \"methods\": [");
+	for (int method = 0; method < methodCount; ++method)
+	{
+		const MethodStats& stats = heatmaps.methods[method];
+		Pair worst = makePair(samplePoint(options.sampling, stats.worstPair, gridResolution));
+		std::printf("%s\n    {\"method\": \"%s\", \"meanErrorRad\": %.9g, \"maxErrorRad\": %.9g, "
+			"\"p50MaxErrorRad\": %.3g, \"p99MaxErrorRad\": %.3g, "
+			"\"worstStartQuat\": [%.6f, %.6f, %.6f, %.6f], "
+			"\"worstEndQuat\": [%.6f, %.6f, %.6f, %.6f]}",
+			method == 0 ? "" : ",", methodNames[method],
+			stats.errorSum / static_cast<double>(options.pairCount), stats.maxError,
+			histogramPercentile(stats.histogram, options.pairCount, 0.5),
+			histogramPercentile(stats.histogram, options.pairCount, 0.99),
+			worst.startQuat.x, worst.startQuat.y, worst.startQuat.z, worst.startQuat.w,
+			worst.endQuat.x, worst.endQuat.y, worst.endQuat.z, worst.endQuat.w);
+	}
+	std::printf("\n  ]\n");
+	std::printf("}\n");
+
+	return 0;
+}